@@ -0,0 +1,31 @@
+// G-buffer material resolve shared by gbuffer.frag and gbuffer_indirect.frag.
+// The includer samples its textures (2D maps or material-table arrays) and
+// supplies the factors; varyings and outputs live here.
+
+in vec3 vWorldPos;
+in vec2 vUV;
+in mat3 vTBN;
+
+// MRT outputs
+layout(location = 0) out vec4 gNormal;    // RGBA16F: world-space normal
+layout(location = 1) out vec4 gAlbedo;    // RGBA8:   albedo
+layout(location = 2) out vec4 gMaterial;  // RGBA8:   metallic(r), roughness(g), ao(b)
+
+// orm: R=occlusion, G=roughness, B=metallic (glTF ORM)
+void WriteGBuffer(vec3 albedoTexel, vec3 normalTexel, vec3 orm,
+                  vec3 albedoFactor, float metallicFactor, float roughnessFactor)
+{
+    vec3 albedo   = albedoTexel * albedoFactor;
+
+    // Decode tangent-space normal and transform to world space
+    vec3 normalTS = normalTexel * 2.0 - 1.0;
+    vec3 worldN   = normalize(vTBN * normalTS);
+
+    float ao        = orm.r;
+    float roughness = orm.g * roughnessFactor;
+    float metallic  = orm.b * metallicFactor;
+
+    gNormal   = vec4(worldN, 1.0);
+    gAlbedo   = vec4(albedo, 1.0);
+    gMaterial = vec4(metallic, roughness, ao, 1.0);
+}
@@ -0,0 +1,26 @@
+// Per-instance data for GPU-driven rendering — #include in #version 430 shaders.
+//
+// Mirrors GpuInstance in renderer/frontend/GpuCulling.hpp (std430, 192 bytes;
+// a static assert checks the C++ side).  Written once per frame by the CPU,
+// read by the culling compute shader and, through the draw ID, by the
+// indirect geometry and shadow vertex shaders.  IndirectDrawBuilder binds a
+// range of its stream buffer here and leaves the culling-only fields unused.
+
+struct GpuInstance {
+    mat4  model;
+    mat4  normalMatrix;
+    vec4  boundsCenter;      // xyz: world-space AABB center
+    vec4  boundsExtents;     // xyz: world-space AABB half-extents
+    uint  material;          // MaterialTable index (see materials.glsl)
+    uint  castsShadow;
+    uint  batch;             // texture-set batch
+    uint  batchFirst;        // first command slot of that batch
+    uint  indexCount;
+    uint  firstIndex;
+    int   baseVertex;
+    uint  _pad0;
+};
+
+layout(std430, binding = 0) readonly buffer Instances {
+    GpuInstance instances[];
+};
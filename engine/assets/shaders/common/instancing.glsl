@@ -0,0 +1,6 @@
+// Per-instance attributes of the CPU path's instanced draws, streamed by
+// InstanceBuffer (InstanceData mirrors them).  Each instance of a draw reads
+// its own element (divisor 1).
+
+layout(location = 5) in mat4 aModel;          // locations 5 - 8
+layout(location = 9) in mat3 aNormalMatrix;   // locations 9 - 11, transpose(inverse(aModel))
@@ -0,0 +1,23 @@
+// Material table for multi-draw indirect draws — #include in #version 430 shaders.
+//
+// Mirrors GpuMaterial in resources/MaterialTable.hpp (std430, 32 bytes).
+// Indexed by material handle index; the last entry is the default material,
+// which out-of-range indices (commands without a material) resolve to.  The
+// layers index the texture arrays the draw's batch binds.
+
+struct GpuMaterial {
+    vec4  albedoMetallic;    // rgb: albedo factor, a: metallic factor
+    float roughnessFactor;
+    uint  albedoLayer;
+    uint  normalLayer;
+    uint  metallicRoughLayer;
+};
+
+layout(std430, binding = 4) readonly buffer Materials {
+    GpuMaterial materials[];
+};
+
+GpuMaterial LookupMaterial(uint index)
+{
+    return materials[min(index, uint(materials.length()) - 1u)];
+}
@@ -15,7 +15,7 @@ layout(std140) uniform PerFrameData {
     vec2  u_Resolution;   float u_Time;  float u_DeltaTime;
 };
 
-// binding = 1 — updated per draw call
+// binding = 1 — no pass binds it anymore (see InstanceBuffer)
 layout(std140) uniform PerObjectData {
     mat4 u_Model;
     mat4 u_NormalMatrix;   // transpose(inverse(Model)), precomputed CPU-side
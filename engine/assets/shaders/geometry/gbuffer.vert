@@ -1,5 +1,6 @@
 #version 410 core
 #include "../common/uniforms.glsl"
+#include "../common/instancing.glsl"
 
 layout(location = 0) in vec3 aPos;
 layout(location = 1) in vec3 aNormal;
@@ -12,14 +13,14 @@ out mat3 vTBN;   // tangent→world transform for normal-map decoding
 
 void main()
 {
-    vec4 worldPos = u_Model * vec4(aPos, 1.0);
+    vec4 worldPos = aModel * vec4(aPos, 1.0);
     gl_Position   = u_ViewProjection * worldPos;
     vWorldPos     = worldPos.xyz;
     vUV           = aUV;
 
     // Build TBN in world space using the pre-computed normal matrix.
-    vec3 N = normalize(mat3(u_NormalMatrix) * aNormal);
-    vec3 T = normalize(mat3(u_NormalMatrix) * aTangent);
+    vec3 N = normalize(aNormalMatrix * aNormal);
+    vec3 T = normalize(aNormalMatrix * aTangent);
     T = normalize(T - dot(T, N) * N);   // Gram-Schmidt re-orthogonalise
     vec3 B = cross(N, T);
     vTBN = mat3(T, B, N);
@@ -0,0 +1,21 @@
+#version 430 core
+// G-buffer fill for multi-draw indirect draws: factors and texture layers come
+// from the draw's material-table entry, the arrays from the batch's bindings.
+#include "../common/gbuffer.glsl"
+#include "../common/materials.glsl"
+
+uniform sampler2DArray u_AlbedoArray;
+uniform sampler2DArray u_NormalArray;
+uniform sampler2DArray u_MetalRoughArray;   // glTF ORM, as in gbuffer.frag
+
+flat in uint vMaterial;
+
+void main()
+{
+    GpuMaterial mat = LookupMaterial(vMaterial);
+
+    WriteGBuffer(texture(u_AlbedoArray,     vec3(vUV, float(mat.albedoLayer))).rgb,
+                 texture(u_NormalArray,     vec3(vUV, float(mat.normalLayer))).rgb,
+                 texture(u_MetalRoughArray, vec3(vUV, float(mat.metallicRoughLayer))).rgb,
+                 mat.albedoMetallic.rgb, mat.albedoMetallic.a, mat.roughnessFactor);
+}
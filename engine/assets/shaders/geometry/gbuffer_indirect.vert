@@ -0,0 +1,36 @@
+#version 430 core
+// gbuffer.vert for multi-draw indirect draws (GpuCulling, IndirectDrawBuilder):
+// the model and normal matrices come from the instance the draw ID selects
+// (see MeshBuffer), not the PerObjectData UBO, and the instance's material
+// index is passed on for the fragment stage's material-table lookup.
+#include "../common/uniforms.glsl"
+#include "../common/instances.glsl"
+
+layout(location = 0) in vec3 aPos;
+layout(location = 1) in vec3 aNormal;
+layout(location = 2) in vec2 aUV;
+layout(location = 3) in vec3 aTangent;
+layout(location = 4) in uint aDrawID;
+
+out vec3 vWorldPos;
+out vec2 vUV;
+out mat3 vTBN;
+flat out uint vMaterial;
+
+void main()
+{
+    GpuInstance inst = instances[aDrawID];
+
+    vec4 worldPos = inst.model * vec4(aPos, 1.0);
+    gl_Position   = u_ViewProjection * worldPos;
+    vWorldPos     = worldPos.xyz;
+    vUV           = aUV;
+
+    vec3 N = normalize(mat3(inst.normalMatrix) * aNormal);
+    vec3 T = normalize(mat3(inst.normalMatrix) * aTangent);
+    T = normalize(T - dot(T, N) * N);   // Gram-Schmidt re-orthogonalise
+    vec3 B = cross(N, T);
+    vTBN = mat3(T, B, N);
+
+    vMaterial = inst.material;
+}
@@ -1,10 +1,11 @@
 #version 410 core
 // Depth-only pass: transform vertices into light-clip space.
 #include "../common/uniforms.glsl"
+#include "../common/instancing.glsl"
 
 layout(location = 0) in vec3 aPos;
 
 void main()
 {
-    gl_Position = u_LightSpaceMatrix * u_Model * vec4(aPos, 1.0);
+    gl_Position = u_LightSpaceMatrix * aModel * vec4(aPos, 1.0);
 }
@@ -0,0 +1,13 @@
+#version 430 core
+// shadow.vert for multi-draw indirect draws (GpuCulling, IndirectDrawBuilder):
+// the model matrix comes from the instance the draw ID selects (see MeshBuffer).
+#include "../common/uniforms.glsl"
+#include "../common/instances.glsl"
+
+layout(location = 0) in vec3 aPos;
+layout(location = 4) in uint aDrawID;
+
+void main()
+{
+    gl_Position = u_LightSpaceMatrix * instances[aDrawID].model * vec4(aPos, 1.0);
+}
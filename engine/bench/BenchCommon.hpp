@@ -0,0 +1,33 @@
+#pragma once
+
+#include <core/Timer.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+
+namespace engine::bench {
+
+// Keeps a computed value observable so the optimiser cannot drop the work
+// that produced it.
+template<typename T>
+inline void DoNotOptimize(const T& value)
+{
+    static volatile std::uint64_t sink;
+    sink = sink + static_cast<std::uint64_t>(value);
+}
+
+// Run fn `reps` times and return the fastest wall time in milliseconds.
+// Best-of-N filters out scheduler noise, which dominates short kernels.
+template<typename Fn>
+double BestOfMs(int reps, Fn&& fn)
+{
+    double best = std::numeric_limits<double>::max();
+    for (int i = 0; i < reps; ++i) {
+        Timer timer;
+        fn();
+        best = std::min(best, static_cast<double>(timer.ElapsedMilliseconds()));
+    }
+    return best;
+}
+
+} // namespace engine::bench
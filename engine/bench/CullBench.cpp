@@ -0,0 +1,166 @@
+// Frustum culling benchmark.
+//
+// Throughput of testing mesh bounds against a perspective frustum, the hot
+// loop of RenderSystem::GatherCommands:
+//   per entity — Frustum::ContainsAABB: local AABB, 8 corners through the
+//                model matrix, every plane; the original per-entity code
+//   scalar     — CullAABBs' scalar kernel over SoA world center / extent
+//   SSE2       — 4 boxes per plane per step
+//   AVX2       — 8 boxes per plane per step, FMA (blank if the CPU lacks it)
+//   AoS batch  — local AABBs + model matrices through TransformAABB, then
+//                CullAABBs 64 at a time (dispatched kernel); the cost
+//                RenderSystem pays when every transform changes each frame
+//
+// Boxes are scattered around the camera; about one in six survives.
+// Single-threaded; results in millions of boxes per second, best of N.
+
+#include <BenchCommon.hpp>
+#include <core/Frustum.hpp>
+#include <core/Geometry.hpp>
+#include <core/Math/FrustumCull.hpp>
+#include <core/Math/SimdDispatch.hpp>
+
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include <bit>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using namespace engine;
+
+namespace {
+
+constexpr int kReps = 9;
+
+struct Scene {
+    std::vector<AABB>      local;
+    std::vector<glm::mat4> model;
+    std::vector<float>     cx, cy, cz, ex, ey, ez;   // world center / extent
+
+    CullBatchInput Input() const
+    {
+        return {cx.data(), cy.data(), cz.data(), ex.data(), ey.data(), ez.data()};
+    }
+};
+
+Scene MakeScene(std::uint32_t n)
+{
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> pos(-200.f, 200.f);
+    std::uniform_real_distribution<float> unit(-1.f, 1.f);
+    std::uniform_real_distribution<float> size(0.5f, 4.f);
+
+    Scene s;
+    for (std::uint32_t i = 0; i < n; ++i) {
+        AABB box;
+        box.Expand(glm::vec3(-size(rng), -size(rng), -size(rng)));
+        box.Expand(glm::vec3( size(rng),  size(rng),  size(rng)));
+
+        const glm::quat q = glm::normalize(glm::quat(unit(rng), unit(rng), unit(rng), unit(rng)));
+        const glm::mat4 m = glm::translate(glm::mat4(1.f), glm::vec3(pos(rng), pos(rng) * 0.1f, pos(rng)))
+                          * glm::mat4_cast(q)
+                          * glm::scale(glm::mat4(1.f), glm::vec3(1.f + 0.5f * unit(rng) * unit(rng)));
+
+        const AABB world = TransformAABB(box, m);
+        const glm::vec3 c = world.Center(), e = world.Extents();
+        s.local.push_back(box);
+        s.model.push_back(m);
+        s.cx.push_back(c.x); s.cy.push_back(c.y); s.cz.push_back(c.z);
+        s.ex.push_back(e.x); s.ey.push_back(e.y); s.ez.push_back(e.z);
+    }
+    return s;
+}
+
+// Millions of boxes per second for n boxes in ms milliseconds.
+double Rate(std::uint32_t n, double ms)
+{
+    return ms > 0.0 ? static_cast<double>(n) / (ms * 1e3) : 0.0;
+}
+
+std::uint64_t CountBits(const std::vector<std::uint64_t>& mask)
+{
+    std::uint64_t visible = 0;
+    for (const std::uint64_t word : mask) visible += static_cast<std::uint64_t>(std::popcount(word));
+    return visible;
+}
+
+void Run(const Frustum& frustum, std::uint32_t n)
+{
+    const Scene              scene = MakeScene(n);
+    const CullBatchInput     in    = scene.Input();
+    std::vector<std::uint64_t> mask(CullMaskWords(n));
+
+    std::uint32_t survivors = 0;
+    const double perEntityMs = bench::BestOfMs(kReps, [&] {
+        survivors = 0;
+        for (std::uint32_t i = 0; i < n; ++i)
+            survivors += frustum.ContainsAABB(scene.local[i], scene.model[i]) ? 1u : 0u;
+        bench::DoNotOptimize(survivors);
+    });
+    const double scalarMs = bench::BestOfMs(kReps, [&] {
+        detail::CullAABBsScalar(frustum, in, mask.data(), n);
+        bench::DoNotOptimize(CountBits(mask));
+    });
+    const std::uint64_t batchSurvivors = CountBits(mask);
+
+    double sse2Ms = -1.0;
+    if (detail::CullAABBsSSE2(frustum, in, mask.data(), n)) {
+        sse2Ms = bench::BestOfMs(kReps, [&] {
+            detail::CullAABBsSSE2(frustum, in, mask.data(), n);
+            bench::DoNotOptimize(CountBits(mask));
+        });
+    }
+
+    double avx2Ms = -1.0;
+    if (ActiveSimdPath() == SimdPath::AVX2) {
+        avx2Ms = bench::BestOfMs(kReps, [&] {
+            detail::CullAABBsAVX2(frustum, in, mask.data(), n);
+            bench::DoNotOptimize(CountBits(mask));
+        });
+    }
+
+    // World bounds recomputed every frame, then batched as in GatherCommands.
+    const double aosMs = bench::BestOfMs(kReps, [&] {
+        constexpr std::uint32_t kBatch = 64;
+        float cx[kBatch], cy[kBatch], cz[kBatch], ex[kBatch], ey[kBatch], ez[kBatch];
+        std::uint64_t visible = 0;
+        for (std::uint32_t base = 0; base < n; base += kBatch) {
+            const std::uint32_t count = (n - base < kBatch) ? n - base : kBatch;
+            for (std::uint32_t i = 0; i < count; ++i) {
+                const AABB world = TransformAABB(scene.local[base + i], scene.model[base + i]);
+                const glm::vec3 c = world.Center(), e = world.Extents();
+                cx[i] = c.x; cy[i] = c.y; cz[i] = c.z;
+                ex[i] = e.x; ey[i] = e.y; ez[i] = e.z;
+            }
+            std::uint64_t word = 0;
+            visible += CullAABBs(frustum, {cx, cy, cz, ex, ey, ez}, &word, count);
+        }
+        bench::DoNotOptimize(visible);
+    });
+
+    char sse2[16] = "-", avx2[16] = "-";
+    if (sse2Ms >= 0.0) std::snprintf(sse2, sizeof(sse2), "%.1f", Rate(n, sse2Ms));
+    if (avx2Ms >= 0.0) std::snprintf(avx2, sizeof(avx2), "%.1f", Rate(n, avx2Ms));
+    std::printf("%8u %10.1f %10.1f %10s %10s %10.1f   %u / %llu visible\n",
+                n, Rate(n, perEntityMs), Rate(n, scalarMs), sse2, avx2, Rate(n, aosMs),
+                survivors, static_cast<unsigned long long>(batchSurvivors));
+}
+
+} // namespace
+
+int main()
+{
+    const glm::mat4 proj = glm::perspective(glm::radians(60.f), 16.f / 9.f, 0.1f, 150.f);
+    const glm::mat4 view = glm::lookAt(glm::vec3(0.f, 5.f, 0.f), glm::vec3(0.f, 5.f, -1.f),
+                                       glm::vec3(0.f, 1.f, 0.f));
+    const Frustum frustum = Frustum::FromViewProjection(proj * view);
+
+    std::printf("dispatch: %s\n", SimdPathName(ActiveSimdPath()));
+    std::printf("%8s %10s %10s %10s %10s %10s   (M boxes/s, best of %d; survivors per entity / batch)\n",
+                "count", "per entity", "scalar", "SSE2", "AVX2", "AoS batch", kReps);
+    for (const std::uint32_t n : {1'000u, 10'000u, 100'000u}) Run(frustum, n);
+    return 0;
+}
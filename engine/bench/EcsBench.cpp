@@ -0,0 +1,150 @@
+// ECS storage benchmark.
+//
+// Compares the three registry layouts on the access patterns the engine's
+// systems use every frame:
+//   populate   — create N entities: all with TransformComponent, every second
+//                one with MeshComponent, every 100th with CameraComponent
+//   each T+M   — Each<TransformComponent, MeshComponent> (RenderSystem shape)
+//   each T     — Each<TransformComponent>               (TransformSystem shape)
+//   query T+M  — cached Query<TransformComponent, MeshComponent>::Each
+//   has M      — HasComponent<MeshComponent> for every entity
+//   get T      — GetComponent<TransformComponent> for every entity
+//
+// Backends: MapOfAnyRegistry (original layout), BasicRegistry<ArchetypeStorage>
+// and BasicRegistry<SparseSetStorage>.  All times are best-of-N milliseconds;
+// the map-of-any layout has no cached queries, so its query column is blank.
+
+#include <BenchCommon.hpp>
+#include <MapOfAnyRegistry.hpp>
+#include <scene/ecs/Registry.hpp>
+#include <scene/ecs/Components.hpp>
+
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+using namespace engine;
+
+namespace {
+
+constexpr int kReps = 7;
+
+struct Results {
+    double populate = 0.0;
+    double eachTM   = 0.0;
+    double eachT    = 0.0;
+    double queryTM  = -1.0;   // < 0: not supported by the backend
+    double has      = 0.0;
+    double get      = 0.0;
+};
+
+template<typename Reg>
+void Populate(Reg& reg, std::vector<EntityID>& ids, std::uint32_t n)
+{
+    ids.clear();
+    ids.reserve(n);
+    for (std::uint32_t i = 0; i < n; ++i) {
+        const EntityID e = reg.CreateEntity();
+        ids.push_back(e);
+
+        TransformComponent tc;
+        tc.position = glm::vec3(static_cast<float>(i), 0.f, 0.f);
+        reg.template AddComponent<TransformComponent>(e, tc);
+
+        if (i % 2 == 0) {
+            MeshComponent mc;
+            mc.meshHandle = i;
+            reg.template AddComponent<MeshComponent>(e, mc);
+        }
+        if (i % 100 == 0)
+            reg.template AddComponent<CameraComponent>(e);
+    }
+}
+
+template<typename Reg>
+Results Run(std::uint32_t n)
+{
+    Results r;
+    std::vector<EntityID> ids;
+
+    r.populate = bench::BestOfMs(kReps, [&] {
+        Reg reg;
+        Populate(reg, ids, n);
+        bench::DoNotOptimize(reg.EntityCount());
+    });
+
+    Reg reg;
+    Populate(reg, ids, n);
+
+    r.eachTM = bench::BestOfMs(kReps, [&] {
+        std::uint64_t acc = 0;
+        reg.template Each<TransformComponent, MeshComponent>(
+            [&](EntityID, TransformComponent& tc, MeshComponent& mc) {
+                tc.worldMatrix[3][0] = tc.position.x;
+                acc += mc.meshHandle;
+            });
+        bench::DoNotOptimize(acc);
+    });
+
+    r.eachT = bench::BestOfMs(kReps, [&] {
+        std::uint64_t acc = 0;
+        reg.template Each<TransformComponent>(
+            [&](EntityID, TransformComponent& tc) {
+                tc.scale.x = -tc.scale.x;
+                acc += tc.scale.x > 0.f ? 1u : 0u;
+            });
+        bench::DoNotOptimize(acc);
+    });
+
+    if constexpr (requires { reg.template RegisterQuery<TransformComponent, MeshComponent>(); }) {
+        const auto query = reg.template RegisterQuery<TransformComponent, MeshComponent>();
+        r.queryTM = bench::BestOfMs(kReps, [&] {
+            std::uint64_t acc = 0;
+            query.Each([&](EntityID, TransformComponent& tc, MeshComponent& mc) {
+                tc.worldMatrix[3][0] = tc.position.x;
+                acc += mc.meshHandle;
+            });
+            bench::DoNotOptimize(acc);
+        });
+    }
+
+    r.has = bench::BestOfMs(kReps, [&] {
+        std::uint64_t acc = 0;
+        for (const EntityID e : ids)
+            acc += reg.template HasComponent<MeshComponent>(e) ? 1u : 0u;
+        bench::DoNotOptimize(acc);
+    });
+
+    r.get = bench::BestOfMs(kReps, [&] {
+        float acc = 0.f;
+        for (const EntityID e : ids)
+            acc += reg.template GetComponent<TransformComponent>(e).position.x;
+        bench::DoNotOptimize(acc);
+    });
+
+    return r;
+}
+
+void Print(const char* backend, std::uint32_t n, const Results& r)
+{
+    char query[16] = "-";
+    if (r.queryTM >= 0.0) std::snprintf(query, sizeof(query), "%.3f", r.queryTM);
+    std::printf("%8u  %-11s %10.3f %10.3f %10.3f %10s %10.3f %10.3f\n",
+                n, backend, r.populate, r.eachTM, r.eachT, query, r.has, r.get);
+}
+
+} // namespace
+
+int main()
+{
+    std::printf("%8s  %-11s %10s %10s %10s %10s %10s %10s   (ms, best of %d)\n",
+                "entities", "backend", "populate", "each T+M", "each T",
+                "query T+M", "has M", "get T", kReps);
+
+    for (const std::uint32_t n : {1'000u, 10'000u, 100'000u}) {
+        Print("map-of-any", n, Run<bench::MapOfAnyRegistry>(n));
+        Print("archetype",  n, Run<BasicRegistry<ArchetypeStorage>>(n));
+        Print("sparse-set", n, Run<BasicRegistry<SparseSetStorage>>(n));
+    }
+    return 0;
+}
@@ -0,0 +1,132 @@
+// Render command generation scaling benchmark.
+//
+// The submit stage of RenderSystem::GatherCommands, over frustum survivors:
+// pick a LOD with RenderSystem::SelectLOD, copy the cached command, fill in
+// its index range and camera distance, queue it.
+//   serial    — RenderQueue::Submit per command; the original loop
+//   N threads — JobSystem::ParallelFor chunks of 512, each thread building
+//               into its own RenderQueue::Segment, then RenderQueue::Merge.
+//               At 1 thread (no workers) the chunks run inline: the column
+//               is what the segment path costs over the serial loop.
+//
+// Each rep is one frame: Clear, generate, merge.  Records use 64 meshes with
+// 4 LODs scattered around the camera.  Thread counts above the machine's
+// core count only show the overhead of the split.  Milliseconds, best of N.
+
+#include <BenchCommon.hpp>
+#include <core/Jobs/JobSystem.hpp>
+#include <renderer/frontend/RenderQueue.hpp>
+#include <scene/systems/RenderSystem.hpp>
+
+#include <glm/geometric.hpp>
+
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace engine;
+
+namespace {
+
+constexpr std::uint32_t kGrain   = 512;   // RenderSystem's kSubmitGrain
+constexpr std::uint32_t kLODs    = 4;
+static_assert(kLODs <= kMaxMeshLODs);
+
+// 60° vertical FOV at 1080p, 2-pixel threshold.
+constexpr RenderSystem::ScreenSizeCulling kScreen{1.732f, 1080.f, 2.f, false};
+
+constexpr std::array<std::uint32_t, 5> kThreads = {1, 2, 4, 8, 16};
+
+using Record = DrawRecordComponent;
+
+std::vector<Record> MakeRecords(std::uint32_t n)
+{
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float>        pos(-400.f, 400.f);
+    std::uniform_real_distribution<float>        size(0.5f, 4.f);
+    std::uniform_int_distribution<std::uint32_t> mesh(0, 63);
+    std::uniform_int_distribution<std::uint32_t> material(0, 31);
+
+    std::vector<Record> records(n);
+    for (Record& r : records) {
+        const glm::vec3 p(pos(rng), pos(rng), pos(rng));
+        const float     s = size(rng);
+        r.command.modelMatrix[3] = glm::vec4(p, 1.f);
+        r.command.worldBounds.Expand(p - glm::vec3(s));
+        r.command.worldBounds.Expand(p + glm::vec3(s));
+        r.command.meshID     = mesh(rng);
+        r.command.materialID = material(rng);
+        for (std::uint32_t lod = 0; lod < kLODs; ++lod) {
+            r.lods[lod] = {r.command.meshID * 4096u + lod * 1024u, 3072u >> lod,
+                           0.25f / static_cast<float>(1u << (2 * lod))};
+        }
+        r.lodCount = kLODs;
+    }
+    return records;
+}
+
+// Build the command for r, as RenderSystem's submit loop does; false when it
+// is under the pixel threshold.
+bool BuildCommand(const Record& r, const glm::vec3& cameraPos, RenderCommand& cmd)
+{
+    const std::uint32_t lod = RenderSystem::SelectLOD(r, kScreen, cameraPos);
+    if (lod == RenderSystem::kTooSmall) return false;
+    cmd = r.command;
+    cmd.baseIndex        = r.lods[lod].firstIndex;
+    cmd.indexCount       = r.lods[lod].indexCount;
+    cmd.distanceToCamera = glm::length(glm::vec3(cmd.modelMatrix[3]) - cameraPos);
+    return true;
+}
+
+void Run(std::uint32_t n)
+{
+    const std::vector<Record> records = MakeRecords(n);
+    const glm::vec3 cameraPos(0.f);
+    const int reps = n >= 1'000'000u ? 3 : 9;
+
+    RenderQueue queue;
+    const double serialMs = bench::BestOfMs(reps, [&] {
+        queue.Clear();
+        RenderCommand cmd;
+        for (const Record& r : records)
+            if (BuildCommand(r, cameraPos, cmd)) queue.Submit(cmd);
+        bench::DoNotOptimize(queue.TotalCount());
+    });
+    const std::size_t expected = queue.TotalCount();
+
+    std::printf("%9u %9.2f", n, serialMs);
+    bool ok = true;
+    for (const std::uint32_t threads : kThreads) {
+        JobSystem jobs(threads - 1);
+        std::vector<RenderQueue::Segment> segments(jobs.ThreadCount());
+        const double ms = bench::BestOfMs(reps, [&] {
+            queue.Clear();
+            jobs.ParallelFor(n, kGrain, [&](std::uint32_t begin, std::uint32_t end) {
+                RenderQueue::Segment& segment = segments[JobSystem::ThreadIndex()];
+                RenderCommand cmd;
+                for (std::uint32_t i = begin; i < end; ++i)
+                    if (BuildCommand(records[i], cameraPos, cmd)) segment.Submit(cmd);
+            });
+            queue.Merge(segments, jobs);
+            for (RenderQueue::Segment& segment : segments) segment.Clear();
+            bench::DoNotOptimize(queue.TotalCount());
+        });
+        ok = ok && queue.TotalCount() == expected;
+        std::printf(" %9.2f", ms);
+    }
+    std::printf("   %s\n", ok ? "ok" : "MISMATCH");
+}
+
+} // namespace
+
+int main()
+{
+    std::printf("%9s %9s", "entities", "serial");
+    for (const std::uint32_t threads : kThreads) std::printf(" %6u thr", threads);
+    std::printf("   (ms, best of N; %u hardware threads)\n", std::thread::hardware_concurrency());
+    for (const std::uint32_t n : {10'000u, 100'000u, 1'000'000u}) Run(n);
+    return 0;
+}
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <core/Assert.hpp>
+#include <scene/ecs/Entity.hpp>
+#include <any>
+#include <cstdint>
+#include <typeindex>
+#include <unordered_map>
+
+namespace engine::bench {
+
+// ─── MapOfAnyRegistry ─────────────────────────────────────────────────────────
+// The engine's original registry layout, kept verbatim as the benchmark
+// baseline: each entity owns an unordered_map<type_index, any> of components.
+class MapOfAnyRegistry {
+public:
+    // ── Entity management ─────────────────────────────────────────────────────
+
+    EntityID CreateEntity()
+    {
+        const EntityID id{nextIndex_++, 0u};
+        entities_.emplace(id, ComponentMap{});
+        return id;
+    }
+
+    void DestroyEntity(EntityID id)
+    {
+        entities_.erase(id);
+    }
+
+    bool IsAlive(EntityID id) const { return entities_.contains(id); }
+
+    // ── Component management ──────────────────────────────────────────────────
+
+    template<typename T>
+    T& AddComponent(EntityID id, T component = {})
+    {
+        ENGINE_ASSERT(entities_.contains(id), "AddComponent: entity does not exist");
+        auto& map = entities_.at(id);
+        map[std::type_index(typeid(T))] = std::move(component);
+        return std::any_cast<T&>(map.at(std::type_index(typeid(T))));
+    }
+
+    template<typename T>
+    T& GetComponent(EntityID id)
+    {
+        ENGINE_ASSERT(HasComponent<T>(id), "GetComponent: component not present");
+        return std::any_cast<T&>(
+            entities_.at(id).at(std::type_index(typeid(T))));
+    }
+
+    template<typename T>
+    const T& GetComponent(EntityID id) const
+    {
+        ENGINE_ASSERT(HasComponent<T>(id), "GetComponent: component not present");
+        return std::any_cast<const T&>(
+            entities_.at(id).at(std::type_index(typeid(T))));
+    }
+
+    template<typename T>
+    bool HasComponent(EntityID id) const
+    {
+        const auto it = entities_.find(id);
+        if (it == entities_.end()) return false;
+        return it->second.contains(std::type_index(typeid(T)));
+    }
+
+    template<typename T>
+    void RemoveComponent(EntityID id)
+    {
+        ENGINE_ASSERT(entities_.contains(id), "RemoveComponent: entity does not exist");
+        entities_.at(id).erase(std::type_index(typeid(T)));
+    }
+
+    // ── Iteration ─────────────────────────────────────────────────────────────
+
+    // Call fn(EntityID, Ts&...) for every entity that has ALL of Ts.
+    // Fn is deduced from the callable; Ts must be explicitly provided:
+    //   registry.Each<A, B>([](EntityID id, A& a, B& b){ ... });
+    template<typename... Ts, typename Fn>
+    void Each(Fn&& fn)
+    {
+        for (auto& [id, map] : entities_) {
+            if ((map.contains(std::type_index(typeid(Ts))) && ...)) {
+                fn(id,
+                   std::any_cast<Ts&>(map.at(std::type_index(typeid(Ts))))...);
+            }
+        }
+    }
+
+    // Const overload — fn receives const component refs.
+    template<typename... Ts, typename Fn>
+    void Each(Fn&& fn) const
+    {
+        for (const auto& [id, map] : entities_) {
+            if ((map.contains(std::type_index(typeid(Ts))) && ...)) {
+                fn(id,
+                   std::any_cast<const Ts&>(map.at(std::type_index(typeid(Ts))))...);
+            }
+        }
+    }
+
+    std::size_t EntityCount() const { return entities_.size(); }
+
+private:
+    using ComponentMap = std::unordered_map<std::type_index, std::any>;
+
+    // Never reuses IDs, as the original did; only the index needs hashing.
+    struct IDHash {
+        std::size_t operator()(EntityID id) const { return std::hash<std::uint32_t>{}(id.index); }
+    };
+
+    std::unordered_map<EntityID, ComponentMap, IDHash> entities_;
+    std::uint32_t nextIndex_ = 0;
+};
+
+} // namespace engine::bench
@@ -0,0 +1,160 @@
+// Occlusion culling benchmark.
+//
+// The two halves of RenderSystem's software occlusion pass:
+//   fill    — occluder triangles after setup, spans written into the
+//             256x128 1/w buffer by the scalar, SSE2 and AVX2 kernels
+//             (AVX2 blank if the CPU lacks it); millions of pixels tested
+//             per second, i.e. bounding-box area over time
+//   test    — OcclusionBuffer::IsOccluded on candidate boxes against the
+//             pyramid built from those occluders; millions of boxes per second
+//
+// The occluders are a row of wall slabs across the view, the candidates boxes
+// scattered in front of, among and behind them.  Single-threaded; best of N.
+
+#include <BenchCommon.hpp>
+#include <core/Geometry.hpp>
+#include <core/Math/OcclusionBuffer.hpp>
+#include <core/Math/SimdDispatch.hpp>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using namespace engine;
+
+namespace {
+
+constexpr int kReps = 9;
+
+// Unit cube [-1, 1]^3 as 12 triangles.
+void AppendCube(std::vector<glm::vec3>& positions, std::vector<std::uint32_t>& indices)
+{
+    const auto base = static_cast<std::uint32_t>(positions.size());
+    for (int i = 0; i < 8; ++i)
+        positions.emplace_back((i & 1) ? 1.f : -1.f, (i & 2) ? 1.f : -1.f, (i & 4) ? 1.f : -1.f);
+
+    constexpr std::uint32_t kFaces[12][3] = {
+        {0, 1, 3}, {0, 3, 2}, {4, 6, 7}, {4, 7, 5},   // -z, +z
+        {0, 4, 5}, {0, 5, 1}, {2, 3, 7}, {2, 7, 6},   // -y, +y
+        {0, 2, 6}, {0, 6, 4}, {1, 5, 7}, {1, 7, 3}};  // -x, +x
+    for (const auto& f : kFaces)
+        for (const std::uint32_t v : f) indices.push_back(base + v);
+}
+
+struct Occluders {
+    std::vector<glm::vec3>     positions;
+    std::vector<std::uint32_t> indices;
+    std::vector<glm::mat4>     models;
+};
+
+Occluders MakeWalls(std::uint32_t count)
+{
+    Occluders o;
+    AppendCube(o.positions, o.indices);
+    for (std::uint32_t i = 0; i < count; ++i) {
+        const float x = (static_cast<float>(i) - 0.5f * static_cast<float>(count - 1)) * 6.f;
+        const float z = -20.f - static_cast<float>(i % 3) * 5.f;
+        o.models.push_back(glm::translate(glm::mat4(1.f), glm::vec3(x, 3.f, z))
+                         * glm::scale(glm::mat4(1.f), glm::vec3(2.5f, 4.f, 0.25f)));
+    }
+    return o;
+}
+
+std::vector<AABB> MakeCandidates(std::uint32_t n)
+{
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> x(-60.f, 60.f);
+    std::uniform_real_distribution<float> z(-120.f, -8.f);
+    std::uniform_real_distribution<float> size(0.3f, 2.f);
+
+    std::vector<AABB> boxes;
+    for (std::uint32_t i = 0; i < n; ++i)
+        boxes.push_back(AABB::FromCenterExtents(glm::vec3(x(rng), size(rng), z(rng)), glm::vec3(size(rng))));
+    return boxes;
+}
+
+// Millions of items per second for n items in ms milliseconds.
+double Rate(std::uint64_t n, double ms)
+{
+    return ms > 0.0 ? static_cast<double>(n) / (ms * 1e3) : 0.0;
+}
+
+void Run(const glm::mat4& viewProjection, std::uint32_t wallCount, std::uint32_t candidateCount)
+{
+    const Occluders walls = MakeWalls(wallCount);
+    OcclusionBuffer buffer;
+
+    std::vector<detail::OcclusionTriangle> tris;
+    for (const glm::mat4& model : walls.models) {
+        std::vector<glm::vec4> clip;
+        for (const glm::vec3& p : walls.positions) clip.push_back(viewProjection * model * glm::vec4(p, 1.f));
+        for (std::size_t i = 0; i + 2 < walls.indices.size(); i += 3) {
+            detail::OcclusionTriangle t;
+            if (detail::SetupOcclusionTriangle(clip[walls.indices[i]], clip[walls.indices[i + 1]],
+                                               clip[walls.indices[i + 2]],
+                                               buffer.Width(), buffer.Height(), t))
+                tris.push_back(t);
+        }
+    }
+    std::uint64_t pixels = 0;
+    for (const detail::OcclusionTriangle& t : tris)
+        pixels += static_cast<std::uint64_t>(t.maxX - t.minX + 1) * static_cast<std::uint64_t>(t.maxY - t.minY + 1);
+
+    std::vector<float> depth(static_cast<std::size_t>(buffer.Width()) * buffer.Height());
+    const auto fill = [&](auto kernel) {
+        return bench::BestOfMs(kReps, [&] {
+            std::fill(depth.begin(), depth.end(), 0.f);
+            kernel(depth.data(), buffer.Width(), tris.data(), tris.size());
+            bench::DoNotOptimize(depth[depth.size() / 2] > 0.f);
+        });
+    };
+    const double scalarMs = fill(detail::RasterizeOccludersScalar);
+    double sse2Ms = -1.0;
+    if (detail::RasterizeOccludersSSE2(depth.data(), buffer.Width(), tris.data(), tris.size()))
+        sse2Ms = fill(detail::RasterizeOccludersSSE2);
+    double avx2Ms = -1.0;
+    if (ActiveSimdPath() == SimdPath::AVX2) avx2Ms = fill(detail::RasterizeOccludersAVX2);
+
+    // Full frame path: rasterize through the dispatcher, build the pyramid.
+    const double frameMs = bench::BestOfMs(kReps, [&] {
+        buffer.Begin(viewProjection);
+        for (const glm::mat4& model : walls.models)
+            buffer.RasterizeOccluder(walls.positions, walls.indices, model);
+        buffer.BuildPyramid();
+        bench::DoNotOptimize(buffer.TriangleCount());
+    });
+
+    const std::vector<AABB> candidates = MakeCandidates(candidateCount);
+    std::uint32_t occluded = 0;
+    const double testMs = bench::BestOfMs(kReps, [&] {
+        occluded = 0;
+        for (const AABB& box : candidates) occluded += buffer.IsOccluded(box) ? 1u : 0u;
+        bench::DoNotOptimize(occluded);
+    });
+
+    char sse2[16] = "-", avx2[16] = "-";
+    if (sse2Ms >= 0.0) std::snprintf(sse2, sizeof(sse2), "%.0f", Rate(pixels, sse2Ms));
+    if (avx2Ms >= 0.0) std::snprintf(avx2, sizeof(avx2), "%.0f", Rate(pixels, avx2Ms));
+    std::printf("%6u %6zu %10.0f %10s %10s %10.3f %10.1f   %u / %u occluded\n",
+                wallCount, tris.size(), Rate(pixels, scalarMs), sse2, avx2, frameMs,
+                Rate(candidateCount, testMs), occluded, candidateCount);
+}
+
+} // namespace
+
+int main()
+{
+    const glm::mat4 proj = glm::perspective(glm::radians(60.f), 16.f / 9.f, 0.1f, 150.f);
+    const glm::mat4 view = glm::lookAt(glm::vec3(0.f, 2.f, 0.f), glm::vec3(0.f, 2.f, -1.f),
+                                       glm::vec3(0.f, 1.f, 0.f));
+
+    std::printf("dispatch: %s\n", SimdPathName(ActiveSimdPath()));
+    std::printf("%6s %6s %10s %10s %10s %10s %10s   (fill: M px/s; frame: ms; test: M boxes/s; best of %d)\n",
+                "walls", "tris", "scalar", "SSE2", "AVX2", "frame", "test", kReps);
+    for (const std::uint32_t walls : {4u, 16u, 64u}) Run(proj * view, walls, 100'000u);
+    return 0;
+}
@@ -0,0 +1,101 @@
+// Render queue sort benchmark.
+//
+// Ordering a frame's opaque commands three ways:
+//   fat std::sort — std::sort on the RenderCommand structs themselves, keyed
+//                   by distance only; the original RenderQueue::Sort
+//   key std::sort — std::sort of (64-bit key, index) pairs
+//   radix         — RenderQueue::Sort: the same pairs through the LSD radix
+//                   sort (core/RadixSort.hpp), commands left in place
+//
+// Commands use 64 materials and 256 meshes at random distances.  The sorts
+// run on a fresh copy of the submission order each rep; the copy is timed as
+// well, as it is part of every frame.  Single-threaded; milliseconds, best
+// of N.  The last column is RenderQueue's heap allocations in the final rep,
+// which should be zero once its frame arena has grown to fit.
+
+#include <BenchCommon.hpp>
+#include <core/RadixSort.hpp>
+#include <renderer/frontend/RenderQueue.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using namespace engine;
+
+namespace {
+
+constexpr int kReps = 9;
+
+std::vector<RenderCommand> MakeCommands(std::uint32_t n)
+{
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float>        distance(0.5f, 500.f);
+    std::uniform_int_distribution<std::uint32_t> material(0, 63);
+    std::uniform_int_distribution<std::uint32_t> mesh(0, 255);
+
+    std::vector<RenderCommand> commands(n);
+    for (RenderCommand& cmd : commands) {
+        cmd.distanceToCamera = distance(rng);
+        cmd.materialID       = material(rng);
+        cmd.meshID           = mesh(rng);
+    }
+    return commands;
+}
+
+void Run(std::uint32_t n)
+{
+    const std::vector<RenderCommand> commands = MakeCommands(n);
+
+    std::vector<RenderCommand> fat;
+    const double fatMs = bench::BestOfMs(kReps, [&] {
+        fat = commands;
+        std::sort(fat.begin(), fat.end(), [](const RenderCommand& a, const RenderCommand& b) {
+            return a.distanceToCamera < b.distanceToCamera;
+        });
+        bench::DoNotOptimize(fat.front().meshID);
+    });
+
+    std::vector<SortKey> keys(n);
+    const double keyMs = bench::BestOfMs(kReps, [&] {
+        for (std::uint32_t i = 0; i < n; ++i) keys[i] = {RenderQueue::OpaqueKey(commands[i]), i};
+        std::sort(keys.begin(), keys.end(), [](const SortKey& a, const SortKey& b) {
+            return a.key < b.key;
+        });
+        bench::DoNotOptimize(keys.front().index);
+    });
+
+    RenderQueue queue;
+    const double radixMs = bench::BestOfMs(kReps, [&] {
+        queue.Clear();
+        for (const RenderCommand& cmd : commands) queue.Submit(cmd);
+        queue.Sort();
+        bench::DoNotOptimize(queue.OpaqueCommands().front().meshID);
+    });
+
+    // Same order as the key sort, and the keys ascend.
+    bool ok = true;
+    std::uint64_t last = 0;
+    const CommandView sorted = queue.OpaqueCommands();
+    for (std::uint32_t i = 0; i < n; ++i) {
+        const std::uint64_t key = RenderQueue::OpaqueKey(sorted[i]);
+        ok = ok && key >= last && key == keys[i].key;
+        last = key;
+    }
+
+    queue.Clear();
+    std::printf("%8u %14.3f %14.3f %14.3f %7zu   %s\n", n, fatMs, keyMs, radixMs,
+                queue.LastFrameHeapAllocations(), ok ? "ok" : "MISMATCH");
+}
+
+} // namespace
+
+int main()
+{
+    std::printf("%8s %14s %14s %14s %7s   (ms, best of %d; radix includes Submit)\n",
+                "commands", "fat std::sort", "key std::sort", "radix", "allocs", kReps);
+    for (const std::uint32_t n : {1'000u, 10'000u, 100'000u}) Run(n);
+    return 0;
+}
@@ -0,0 +1,204 @@
+// TRS matrix benchmark.
+//
+// Throughput of building world matrices from position / rotation / scale,
+// the hot loop of TransformSystem::Update:
+//   glm euler  — translate * rotate(x) * rotate(y) * rotate(z) * scale, the
+//                original per-entity code (Euler angles)
+//   glm quat   — translate * mat4_cast(q) * scale
+//   scalar     — closed-form quaternion TRS, one transform at a time
+//   SSE2       — 4-wide kernel over SoA arrays
+//   AVX2       — 8-wide FMA kernel over SoA arrays (blank if the CPU lacks it)
+//   AoS batch  — what TransformSystem does: gather 64 TransformComponents into
+//                SoA, then BuildTRSMatrices (dispatched kernel)
+//
+// A second table compares normal matrices: transpose(inverse(world)), what
+// RenderSystem used to compute per entity, against the analytic R * S^-1
+// TransformSystem derives from the TRS columns.
+//
+// Single-threaded; results in millions of matrices per second, best of N.
+
+#include <BenchCommon.hpp>
+#include <core/Math/SimdDispatch.hpp>
+#include <core/Math/TRSBatch.hpp>
+#include <scene/ecs/Components.hpp>
+
+#include <glm/gtc/matrix_inverse.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+using namespace engine;
+
+namespace {
+
+constexpr int kReps = 9;
+
+struct SoA {
+    std::vector<float> px, py, pz, qx, qy, qz, qw, sx, sy, sz;
+
+    TRSBatchInput Input() const
+    {
+        return {px.data(), py.data(), pz.data(),
+                qx.data(), qy.data(), qz.data(), qw.data(),
+                sx.data(), sy.data(), sz.data()};
+    }
+};
+
+glm::mat4 GlmEuler(const TransformComponent& tc, const glm::vec3& eulerDegrees)
+{
+    const glm::mat4 T = glm::translate(glm::mat4(1.f), tc.position);
+    glm::mat4 R = glm::rotate(glm::mat4(1.f), glm::radians(eulerDegrees.x), glm::vec3(1.f, 0.f, 0.f));
+    R = glm::rotate(R, glm::radians(eulerDegrees.y), glm::vec3(0.f, 1.f, 0.f));
+    R = glm::rotate(R, glm::radians(eulerDegrees.z), glm::vec3(0.f, 0.f, 1.f));
+    return T * R * glm::scale(glm::mat4(1.f), tc.scale);
+}
+
+glm::mat4 GlmQuat(const TransformComponent& tc)
+{
+    return glm::translate(glm::mat4(1.f), tc.position)
+         * glm::mat4_cast(tc.rotation)
+         * glm::scale(glm::mat4(1.f), tc.scale);
+}
+
+// Millions of matrices per second for n matrices in ms milliseconds.
+double Rate(std::uint32_t n, double ms)
+{
+    return ms > 0.0 ? static_cast<double>(n) / (ms * 1e3) : 0.0;
+}
+
+std::uint64_t Checksum(const std::vector<glm::mat4>& out)
+{
+    float acc = 0.f;
+    for (const glm::mat4& m : out) acc += m[0][0] + m[3][0];
+    return static_cast<std::uint64_t>(acc > 0.f ? acc : -acc);
+}
+
+void Run(std::uint32_t n)
+{
+    std::vector<TransformComponent> transforms(n);
+    std::vector<glm::vec3>          eulers(n);
+    SoA soa;
+    for (std::uint32_t i = 0; i < n; ++i) {
+        TransformComponent& tc = transforms[i];
+        const float f = static_cast<float>(i);
+        eulers[i]   = glm::vec3(f * 0.37f, f * 1.13f - 180.f, f * 2.71f);
+        tc.position = glm::vec3(f, f * 0.5f, -f);
+        tc.scale    = glm::vec3(1.f + 0.001f * f, 1.f, 2.f);
+        tc.SetEulerAngles(eulers[i]);
+
+        soa.px.push_back(tc.position.x); soa.py.push_back(tc.position.y); soa.pz.push_back(tc.position.z);
+        soa.qx.push_back(tc.rotation.x); soa.qy.push_back(tc.rotation.y);
+        soa.qz.push_back(tc.rotation.z); soa.qw.push_back(tc.rotation.w);
+        soa.sx.push_back(tc.scale.x);    soa.sy.push_back(tc.scale.y);    soa.sz.push_back(tc.scale.z);
+    }
+
+    std::vector<glm::mat4>  out(n);
+    std::vector<float*>     outPtrs(n);
+    for (std::uint32_t i = 0; i < n; ++i) outPtrs[i] = &out[i][0][0];
+    const TRSBatchInput in = soa.Input();
+
+    const double glmEulerMs = bench::BestOfMs(kReps, [&] {
+        for (std::uint32_t i = 0; i < n; ++i) out[i] = GlmEuler(transforms[i], eulers[i]);
+        bench::DoNotOptimize(Checksum(out));
+    });
+    const double glmQuatMs = bench::BestOfMs(kReps, [&] {
+        for (std::uint32_t i = 0; i < n; ++i) out[i] = GlmQuat(transforms[i]);
+        bench::DoNotOptimize(Checksum(out));
+    });
+    const double scalarMs = bench::BestOfMs(kReps, [&] {
+        detail::BuildTRSMatricesScalar(in, outPtrs.data(), n);
+        bench::DoNotOptimize(Checksum(out));
+    });
+
+    double sse2Ms = -1.0;
+    if (detail::BuildTRSMatricesSSE2(in, outPtrs.data(), n)) {
+        sse2Ms = bench::BestOfMs(kReps, [&] {
+            detail::BuildTRSMatricesSSE2(in, outPtrs.data(), n);
+            bench::DoNotOptimize(Checksum(out));
+        });
+    }
+
+    double avx2Ms = -1.0;
+    if (ActiveSimdPath() == SimdPath::AVX2) {
+        avx2Ms = bench::BestOfMs(kReps, [&] {
+            detail::BuildTRSMatricesAVX2(in, outPtrs.data(), n);
+            bench::DoNotOptimize(Checksum(out));
+        });
+    }
+
+    // Same gather-then-batch shape as TransformSystem::Update.
+    const double aosMs = bench::BestOfMs(kReps, [&] {
+        constexpr std::uint32_t kBatch = 64;
+        float px[kBatch], py[kBatch], pz[kBatch], qx[kBatch], qy[kBatch], qz[kBatch], qw[kBatch],
+              sx[kBatch], sy[kBatch], sz[kBatch];
+        glm::mat4* dst[kBatch];
+        for (std::uint32_t base = 0; base < n; base += kBatch) {
+            const std::uint32_t count = (n - base < kBatch) ? n - base : kBatch;
+            for (std::uint32_t i = 0; i < count; ++i) {
+                TransformComponent& tc = transforms[base + i];
+                px[i] = tc.position.x; py[i] = tc.position.y; pz[i] = tc.position.z;
+                qx[i] = tc.rotation.x; qy[i] = tc.rotation.y; qz[i] = tc.rotation.z; qw[i] = tc.rotation.w;
+                sx[i] = tc.scale.x;    sy[i] = tc.scale.y;    sz[i] = tc.scale.z;
+                dst[i] = &tc.worldMatrix;
+            }
+            BuildTRSMatrices({px, py, pz, qx, qy, qz, qw, sx, sy, sz}, dst, count);
+        }
+        bench::DoNotOptimize(transforms[n - 1u].worldMatrix[0][0] > 0.f ? 1u : 0u);
+    });
+
+    char sse2[16] = "-", avx2[16] = "-";
+    if (sse2Ms >= 0.0) std::snprintf(sse2, sizeof(sse2), "%.1f", Rate(n, sse2Ms));
+    if (avx2Ms >= 0.0) std::snprintf(avx2, sizeof(avx2), "%.1f", Rate(n, avx2Ms));
+    std::printf("%8u %10.1f %10.1f %10.1f %10s %10s %10.1f\n",
+                n, Rate(n, glmEulerMs), Rate(n, glmQuatMs), Rate(n, scalarMs),
+                sse2, avx2, Rate(n, aosMs));
+}
+
+void RunNormals(std::uint32_t n)
+{
+    std::vector<TransformComponent> transforms(n);
+    for (std::uint32_t i = 0; i < n; ++i) {
+        TransformComponent& tc = transforms[i];
+        const float f = static_cast<float>(i);
+        tc.position = glm::vec3(f, f * 0.5f, -f);
+        tc.scale    = glm::vec3(1.f + 0.001f * f, 1.f, 2.f);
+        tc.SetEulerAngles(glm::vec3(f * 0.37f, f * 1.13f - 180.f, f * 2.71f));
+        tc.worldMatrix = BuildTRSMatrix(tc.position, tc.rotation, tc.scale);
+    }
+    std::vector<glm::mat4> out(n);
+
+    const double inverseMs = bench::BestOfMs(kReps, [&] {
+        for (std::uint32_t i = 0; i < n; ++i)
+            out[i] = glm::transpose(glm::inverse(transforms[i].worldMatrix));
+        bench::DoNotOptimize(Checksum(out));
+    });
+    const double analyticMs = bench::BestOfMs(kReps, [&] {
+        for (std::uint32_t i = 0; i < n; ++i) {
+            const glm::mat4& m = transforms[i].worldMatrix;
+            const glm::vec3& s = transforms[i].scale;
+            out[i] = glm::mat4(glm::mat3(glm::vec3(m[0]) / (s.x * s.x),
+                                         glm::vec3(m[1]) / (s.y * s.y),
+                                         glm::vec3(m[2]) / (s.z * s.z)));
+        }
+        bench::DoNotOptimize(Checksum(out));
+    });
+
+    std::printf("%8u %10.1f %10.1f\n", n, Rate(n, inverseMs), Rate(n, analyticMs));
+}
+
+} // namespace
+
+int main()
+{
+    std::printf("dispatch: %s\n", SimdPathName(ActiveSimdPath()));
+    std::printf("%8s %10s %10s %10s %10s %10s %10s   (M matrices/s, best of %d)\n",
+                "count", "glm euler", "glm quat", "scalar", "SSE2", "AVX2", "AoS batch", kReps);
+    for (const std::uint32_t n : {1'000u, 10'000u, 100'000u}) Run(n);
+
+    std::printf("\n%8s %10s %10s   (normal matrices, M/s)\n", "count", "inverse", "analytic");
+    for (const std::uint32_t n : {1'000u, 10'000u, 100'000u}) RunNormals(n);
+    return 0;
+}
@@ -1,7 +1,6 @@
 #include "Application.hpp"
 #include <scene/systems/RenderSystem.hpp>
 #include <scene/ecs/Components.hpp>
-#include <resources/GPUMesh.hpp>
 #include <renderer/backend/Framebuffer.hpp>
 #include <core/Assert.hpp>
 #include <core/Log.hpp>
@@ -33,6 +32,7 @@ Application::Application()
 
     renderer_.RegisterShadersForReload(resourceManager_);
     resourceManager_.TrackShaderForReload(blitShader_);
+    renderer_.SetMaterialTable(&resourceManager_.GetMaterialTable());
 
     LOG_INFO("Phase 6 ready — LMB drag to orbit; ImGui overlay top-left; edit .glsl to hot-reload");
 }
@@ -67,6 +67,10 @@ void Application::RenderFrame(float time, float deltaTime)
     // Hot-reload any edited shader source files.
     resourceManager_.PollShaderReload();
 
+    // Pick up textures and materials added since last frame before the
+    // renderer decides between its indirect and loop paths.
+    resourceManager_.UpdateMaterialTable();
+
     // Sync last-reload name to DebugUI.
     const std::string& lastReload = resourceManager_.LastReloadedShader();
     if (!lastReload.empty())
@@ -79,16 +83,30 @@ void Application::RenderFrame(float time, float deltaTime)
     renderer_.Resize(w, h);
 
     // Run ECS: orbit input, transforms, camera system.
-    const auto frameDataOpt = scene_.Update(time, deltaTime, window_);
+    const auto frameDataOpt = scene_.Update(time, deltaTime, window_, jobs_);
     if (!frameDataOpt) return;
 
     // Build view-projection frustum for culling.
     const Frustum frustum = Frustum::FromViewProjection(frameDataOpt->viewProjection);
 
-    // Gather draw commands — entities that fail ContainsAABB are skipped.
-    lastCullStats_ = RenderSystem::GatherCommands(
-        scene_.registry, resourceManager_, renderer_.GetQueue(),
-        frameDataOpt->cameraPos, frustum);
+    // Gather draw commands — entities outside the frustum or behind an
+    // occluder are skipped.  With GPU culling the renderer culls instead,
+    // so everything is submitted and CPU occlusion culling is off.
+    const bool gpuCulling = renderer_.GpuCullingActive();
+    const bool occlusion  = occlusionEnabled_ && !gpuCulling;
+    const auto screen = RenderSystem::ScreenSizeCulling::FromProjection(
+        frameDataOpt->projection, frameDataOpt->resolution.y, minPixelSize_);
+    if (occlusion) occlusion_.Begin(frameDataOpt->viewProjection);
+    lastCullStats_ = scene_.renderSystem.GatherCommands(
+        scene_.registry, scene_.bounds, resourceManager_, renderer_.GetQueue(),
+        frameDataOpt->cameraPos, frustum, screen,
+        occlusion ? &occlusion_ : nullptr, jobs_, gpuCulling);
+
+    // Shadow casters are picked by the light, not the camera: anything that
+    // can shadow the receivers just gathered, on screen or not.
+    lastCullStats_.shadowCasters = scene_.renderSystem.GatherShadowCasters(
+        scene_.registry, scene_.bounds, renderer_.GetQueue(),
+        scene_.GetLightDir(), frameDataOpt->cameraPos, screen);
 
     // Build frame context.
     FrameContext ctx;
@@ -115,16 +133,13 @@ void Application::RenderFrame(float time, float deltaTime)
     blitVao_.Unbind();
 
     // ── Debug geometry ────────────────────────────────────────────────────────
-    // Draw AABB wireframes for all mesh entities so frustum culling can be
-    // visually confirmed (an entity whose box leaves the view disappears).
-    scene_.registry.Each<TransformComponent, MeshComponent>(
-        [&](EntityID, TransformComponent& tc, MeshComponent& mc) {
-            if (!mc.visible) return;
-            const GPUMesh& mesh = resourceManager_.GetMesh(
-                MeshHandle{mc.meshHandle, 0u});
-            debugRenderer_.DrawAABB(mesh.localBounds, tc.worldMatrix,
-                                    {0.2f, 1.0f, 0.2f, 1.0f});
-        });
+    // Draw the world AABB of every mesh entity in view, found through the
+    // bounds tree, so frustum culling can be visually confirmed (an entity
+    // whose box leaves the view disappears).
+    scene_.bounds.QueryFrustum(frustum, [&](std::uint32_t proxy) {
+        debugRenderer_.DrawAABB(scene_.bounds.Bounds(proxy), glm::mat4(1.f),
+                                {0.2f, 1.0f, 0.2f, 1.0f});
+    });
 
     debugRenderer_.FlushAndClear(frameDataOpt->viewProjection);
 
@@ -136,7 +151,23 @@ void Application::RenderFrame(float time, float deltaTime)
     uiData.frameMs        = lastFrameMs_;
     uiData.totalMeshCount = lastCullStats_.total;
     uiData.culledCount    = lastCullStats_.culled;
-    uiData.drawCallCount  = lastCullStats_.visible;
+    uiData.occludedCount  = lastCullStats_.occluded;
+    uiData.tooSmallCount  = lastCullStats_.tooSmall;
+    uiData.reducedLODCount = lastCullStats_.reducedLOD;
+    uiData.triangleCount  = lastCullStats_.triangles;
+    uiData.reusedCount    = lastCullStats_.reused;
+    uiData.planeTestCount = lastCullStats_.planeTests;
+    uiData.planeHitCount  = lastCullStats_.planeHits;
+    uiData.shadowCasterCount = lastCullStats_.shadowCasters;
+    uiData.minPixelSizePtr = &minPixelSize_;
+    uiData.drawCallCount  = renderer_.DrawCallCount();
+    uiData.occluderTriangleCount = lastCullStats_.occluderTriangles;
+    uiData.queueBytes            = renderer_.GetQueue().LastFrameBytes();
+    uiData.queueHeapAllocations  = renderer_.GetQueue().LastFrameHeapAllocations();
+    uiData.streamedBytes         = renderer_.StreamedBytes();
+    uiData.occlusionEnabledPtr   = &occlusionEnabled_;
+    uiData.gpuCullingEnabledPtr  = renderer_.GpuCullingAvailable() ? &renderer_.GpuCullingEnabled() : nullptr;
+    uiData.multiDrawEnabledPtr   = renderer_.GpuCullingAvailable() ? &renderer_.MultiDrawEnabled()  : nullptr;
     uiData.gNormalTexID   = renderer_.GetGNormalTexID();
     uiData.gAlbedoTexID   = renderer_.GetGAlbedoTexID();
     uiData.gMaterialTexID = renderer_.GetGMaterialTexID();
@@ -2,6 +2,8 @@
 
 #include <platform/Window.hpp>
 #include <core/Timer.hpp>
+#include <core/Jobs/JobSystem.hpp>
+#include <core/Math/OcclusionBuffer.hpp>
 #include <renderer/backend/Shader.hpp>
 #include <renderer/backend/VertexArray.hpp>
 #include <renderer/frontend/Renderer.hpp>
@@ -30,6 +32,7 @@ public:
 private:
     Window          window_;
     Timer           timer_;
+    JobSystem       jobs_;
     ResourceManager resourceManager_;
     Renderer        renderer_;
     Scene           scene_;
@@ -41,6 +44,9 @@ private:
     // Phase 6 systems.
     DebugRenderer              debugRenderer_;
     DebugUI                    debugUI_;
+    OcclusionBuffer            occlusion_;
+    bool                       occlusionEnabled_ = true;
+    float                      minPixelSize_     = 2.f;   // screen-size culling threshold
     RenderSystem::CullStats    lastCullStats_;
     float                      lastFrameMs_ = 0.f;
 
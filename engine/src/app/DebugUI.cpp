@@ -86,18 +86,47 @@ void DebugUI::Draw(DebugUIData& data)
         ImGui::Separator();
         ImGui::Text("CPU frame: %.2f ms  (%.0f fps)",
                     data.frameMs, data.frameMs > 0.f ? 1000.f / data.frameMs : 0.f);
+        ImGui::Text("Queue: %.1f KiB, %zu heap allocs",
+                    static_cast<float>(data.queueBytes) / 1024.f, data.queueHeapAllocations);
+        ImGui::Text("Streamed: %.1f KiB/frame",
+                    static_cast<float>(data.streamedBytes) / 1024.f);
     }
 
     // ── Culling ───────────────────────────────────────────────────────────────
     if (ImGui::CollapsingHeader("Culling", ImGuiTreeNodeFlags_DefaultOpen)) {
-        const float pct = data.totalMeshCount > 0
-            ? 100.f * static_cast<float>(data.culledCount)
-                    / static_cast<float>(data.totalMeshCount)
-            : 0.f;
+        const auto pct = [&](std::uint32_t n) {
+            return data.totalMeshCount > 0
+                ? 100.f * static_cast<float>(n) / static_cast<float>(data.totalMeshCount)
+                : 0.f;
+        };
         ImGui::Text("Total:    %u", data.totalMeshCount);
-        ImGui::Text("Visible:  %u", data.totalMeshCount - data.culledCount);
-        ImGui::Text("Culled:   %u  (%.1f%%)", data.culledCount, pct);
+        ImGui::Text("Visible:  %u",
+                    data.totalMeshCount - data.culledCount - data.tooSmallCount - data.occludedCount);
+        ImGui::Text("Culled:   %u  (%.1f%%)", data.culledCount, pct(data.culledCount));
+        ImGui::Text("Too small: %u  (%.1f%%)", data.tooSmallCount, pct(data.tooSmallCount));
+        ImGui::Text("Occluded: %u  (%.1f%%)", data.occludedCount, pct(data.occludedCount));
         ImGui::Text("Draw calls: %u", data.drawCallCount);
+        ImGui::Text("Shadow casters: %u", data.shadowCasterCount);
+        ImGui::Text("Triangles: %u  (%u below LOD 0)", data.triangleCount, data.reducedLODCount);
+        ImGui::Text("Reused:   %u  (%.1f%%)", data.reusedCount, pct(data.reusedCount));
+        ImGui::Text("Plane cache: %u / %u hits  (%.1f%%)", data.planeHitCount, data.planeTestCount,
+                    data.planeTestCount > 0
+                        ? 100.f * static_cast<float>(data.planeHitCount) /
+                                  static_cast<float>(data.planeTestCount)
+                        : 0.f);
+        if (data.minPixelSizePtr)
+            ImGui::SliderFloat("Min size (px)", data.minPixelSizePtr, 0.f, 32.f, "%.1f");
+        if (data.gpuCullingEnabledPtr) {
+            ImGui::Checkbox("GPU culling", data.gpuCullingEnabledPtr);
+            if (*data.gpuCullingEnabledPtr)
+                ImGui::TextDisabled("Frustum tests run in a compute shader;\n"
+                                    "draw calls are multi-draw indirect.");
+        }
+        if (data.multiDrawEnabledPtr)
+            ImGui::Checkbox("Multi-draw indirect", data.multiDrawEnabledPtr);
+        if (data.occlusionEnabledPtr)
+            ImGui::Checkbox("Occlusion culling", data.occlusionEnabledPtr);
+        ImGui::TextDisabled("Occluder triangles: %u", data.occluderTriangleCount);
     }
 
     // ── G-Buffer previews ─────────────────────────────────────────────────────
@@ -3,6 +3,7 @@
 #include <glm/vec3.hpp>
 #include <string>
 #include <unordered_map>
+#include <cstddef>
 #include <cstdint>
 
 // Forward-declare GLFW and ImGui types so this header stays lean.
@@ -21,7 +22,26 @@ struct DebugUIData {
     // Culling stats (from RenderSystem::CullStats).
     std::uint32_t totalMeshCount = 0;
     std::uint32_t culledCount    = 0;
+    std::uint32_t occludedCount  = 0;
+    std::uint32_t tooSmallCount  = 0;
+    std::uint32_t reducedLODCount = 0;
+    std::uint32_t triangleCount  = 0;
+    std::uint32_t reusedCount    = 0;   // visibility carried over from last frame
+    std::uint32_t planeTestCount = 0;
+    std::uint32_t planeHitCount  = 0;
+    std::uint32_t shadowCasterCount = 0;
     std::uint32_t drawCallCount  = 0;
+    std::uint32_t occluderTriangleCount = 0;
+
+    // Render queue frame memory (from RenderQueue).
+    std::size_t queueBytes           = 0;
+    std::size_t queueHeapAllocations = 0;   // zero once the arena fits the scene
+    std::size_t streamedBytes        = 0;   // uniform + instance ring writes (Renderer)
+
+    bool*         occlusionEnabledPtr   = nullptr;   // toggles occlusion culling
+    bool*         gpuCullingEnabledPtr  = nullptr;   // toggles GPU culling; null if unsupported
+    bool*         multiDrawEnabledPtr   = nullptr;   // toggles CPU-built multi-draw; null if unsupported
+    float*        minPixelSizePtr       = nullptr;   // screen-size culling threshold (pixels)
 
     // G-buffer preview textures (raw GL IDs for ImGui::Image).
     std::uint32_t gNormalTexID   = 0;
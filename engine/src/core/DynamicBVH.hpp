@@ -0,0 +1,643 @@
+#pragma once
+
+#include <core/Assert.hpp>
+#include <core/Frustum.hpp>
+#include <core/Geometry.hpp>
+#include <glm/common.hpp>
+#include <glm/vector_relational.hpp>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace engine {
+
+// ─── DynamicBVH ───────────────────────────────────────────────────────────────
+// Bounding volume hierarchy over world-space AABBs ("proxies"), each tagged
+// with a T — typically the EntityID it bounds.  Proxy IDs are stable until
+// the proxy is destroyed.
+//
+// Two ways to shape the tree:
+//   - Incremental: CreateProxy inserts each leaf beside the sibling that adds
+//     the least surface area (the SAH insertion cost) and AVL rotations keep
+//     the height logarithmic.  Suits content that trickles in or moves.
+//   - Rebuild: top-down binned SAH over every proxy.  The best tree for static
+//     content; call it after bulk loads.  Proxy IDs survive it.
+//
+// Moving proxies: every leaf keeps a fat box, its bounds grown by a margin.
+// While the new bounds stay inside it, MoveProxy only refits the ancestors;
+// once they escape, the leaf is removed and reinserted.  Internal boxes are
+// always the union of the children's exact bounds, so queries are as tight as
+// testing the leaves themselves.
+//
+// Frustum queries carry the set of planes a node still straddles: a subtree
+// outside one plane is rejected whole, and once a node is inside every plane
+// its subtree is accepted without further tests.  CullFrustum and TestProxy
+// also remember, per node, the plane that last rejected it and test that one
+// first next time (plane coherency): a subtree that stays out of view is
+// usually rejected again by a single plane test.
+//
+// Not thread-safe for writes (CullFrustum and TestProxy write the plane
+// cache); const queries may run concurrently.
+template<typename T>
+class DynamicBVH {
+public:
+    static constexpr std::uint32_t kNull = std::numeric_limits<std::uint32_t>::max();
+
+    // Plane-coherency counters of CullFrustum / TestProxy: tests that started
+    // with a node's cached rejecting plane, and how many of those it rejected
+    // on its own.
+    struct CullCounts {
+        std::uint32_t planeTests = 0;
+        std::uint32_t planeHits  = 0;
+    };
+
+    // ── Proxies ───────────────────────────────────────────────────────────────
+
+    std::uint32_t CreateProxy(const AABB& bounds, const T& user)
+    {
+        ENGINE_ASSERT(bounds.IsValid(), "DynamicBVH::CreateProxy — invalid bounds");
+        const std::uint32_t id = AllocateNode();
+        Node& leaf  = nodes_[id];
+        leaf.box    = bounds;
+        leaf.fat    = Fatten(bounds);
+        leaf.user   = user;
+        leaf.height = 0;
+        InsertLeaf(id);
+        ++proxyCount_;
+        return id;
+    }
+
+    void DestroyProxy(std::uint32_t proxy)
+    {
+        ENGINE_ASSERT(IsProxy(proxy), "DynamicBVH::DestroyProxy — not a proxy");
+        RemoveLeaf(proxy);
+        FreeNode(proxy);
+        --proxyCount_;
+    }
+
+    // Update a proxy's bounds.  Returns true if the leaf was reinserted
+    // (escaped its fat box), false if the ancestors were only refitted.
+    bool MoveProxy(std::uint32_t proxy, const AABB& bounds)
+    {
+        ENGINE_ASSERT(IsProxy(proxy), "DynamicBVH::MoveProxy — not a proxy");
+        ENGINE_ASSERT(bounds.IsValid(), "DynamicBVH::MoveProxy — invalid bounds");
+        Node& leaf = nodes_[proxy];
+        if (Contains(leaf.fat, bounds)) {
+            leaf.box = bounds;
+            Refit(leaf.parent);
+            return false;
+        }
+        RemoveLeaf(proxy);
+        nodes_[proxy].box = bounds;
+        nodes_[proxy].fat = Fatten(bounds);
+        InsertLeaf(proxy);
+        return true;
+    }
+
+    // Rebuild every internal node with a top-down binned SAH build.
+    void Rebuild()
+    {
+        std::vector<std::uint32_t> leaves;
+        leaves.reserve(proxyCount_);
+        for (std::uint32_t i = 0; i < nodes_.size(); ++i) {
+            if      (nodes_[i].height == 0) leaves.push_back(i);
+            else if (nodes_[i].height >  0) FreeNode(i);
+        }
+        root_ = leaves.empty() ? kNull : BuildSAH(leaves.data(), leaves.size());
+        if (root_ != kNull) nodes_[root_].parent = kNull;
+    }
+
+    void Clear()
+    {
+        nodes_.clear();
+        root_       = kNull;
+        freeList_   = kNull;
+        proxyCount_ = 0;
+    }
+
+    // ── Access ────────────────────────────────────────────────────────────────
+
+    bool IsProxy(std::uint32_t id) const
+    {
+        return id < nodes_.size() && nodes_[id].height == 0;
+    }
+
+    const AABB& Bounds  (std::uint32_t proxy) const { return nodes_[proxy].box;  }
+    const T&    UserData(std::uint32_t proxy) const { return nodes_[proxy].user; }
+
+    // Upper bound (exclusive) of proxy IDs, for sweeping with IsProxy.
+    std::uint32_t Capacity()   const { return static_cast<std::uint32_t>(nodes_.size()); }
+    std::size_t   ProxyCount() const { return proxyCount_; }
+    std::int32_t  Height()     const { return root_ == kNull ? 0 : nodes_[root_].height; }
+
+    // ── Queries ───────────────────────────────────────────────────────────────
+
+    // fn(proxy) for every proxy whose bounds overlap box.
+    template<typename Fn>
+    void Query(const AABB& box, Fn&& fn) const
+    {
+        Stack<std::uint32_t> stack;
+        if (root_ != kNull) stack.Push(root_);
+        while (!stack.Empty()) {
+            const std::uint32_t index = stack.Pop();
+            const Node&         node  = nodes_[index];
+            if (!Overlaps(node.box, box)) continue;
+            if (node.height == 0) { fn(index); continue; }
+            stack.Push(node.child0);
+            stack.Push(node.child1);
+        }
+    }
+
+    // Hierarchical frustum cull.  fn(proxy, contained) is called for every
+    // proxy not rejected along the way: contained == true when the proxy is
+    // known to lie inside every plane, false when its own bounds have not
+    // been tested yet (its ancestors straddle the frustum).  Leaving that last
+    // test to the caller lets it batch the boundary leaves (see CullAABBs).
+    template<typename Fn>
+    CullCounts CullFrustum(const Frustum& frustum, Fn&& fn)
+    {
+        CullCounts counts;
+        Stack<Entry> stack;
+        if (root_ != kNull) stack.Push({root_, kAllPlanes});
+        while (!stack.Empty()) {
+            const Entry entry = stack.Pop();
+            Node&       node  = nodes_[entry.node];
+            if (node.height == 0) { fn(entry.node, entry.planes == 0); continue; }
+
+            std::uint32_t planes = entry.planes;
+            if (planes != 0) {
+                planes = ClassifyCoherent(frustum, node, planes, counts);
+                if (planes == kOutside) continue;
+            }
+            stack.Push({node.child0, planes});
+            stack.Push({node.child1, planes});
+        }
+        return counts;
+    }
+
+    // Full frustum test of one proxy, starting with the plane that last
+    // rejected it.
+    bool TestProxy(const Frustum& frustum, std::uint32_t proxy, CullCounts& counts)
+    {
+        ENGINE_ASSERT(IsProxy(proxy), "DynamicBVH::TestProxy — not a proxy");
+        return ClassifyCoherent(frustum, nodes_[proxy], kAllPlanes, counts) != kOutside;
+    }
+
+    // fn(proxy) for every proxy whose bounds may overlap the frustum.  Leaves
+    // the plane cache alone.
+    template<typename Fn>
+    void QueryFrustum(const Frustum& frustum, Fn&& fn) const
+    {
+        Stack<Entry> stack;
+        if (root_ != kNull) stack.Push({root_, kAllPlanes});
+        while (!stack.Empty()) {
+            const Entry entry = stack.Pop();
+            const Node& node  = nodes_[entry.node];
+
+            std::uint32_t planes = entry.planes;
+            if (planes != 0) {
+                planes = Classify(frustum, node.box, planes);
+                if (planes == kOutside) continue;
+            }
+            if (node.height == 0) { fn(entry.node); continue; }
+            stack.Push({node.child0, planes});
+            stack.Push({node.child1, planes});
+        }
+    }
+
+    // fn(box, height) for every node, leaves (height 0) included — for debug
+    // drawing of the hierarchy.
+    template<typename Fn>
+    void ForEachNode(Fn&& fn) const
+    {
+        for (const Node& node : nodes_)
+            if (node.height >= 0) fn(node.box, node.height);
+    }
+
+private:
+    static constexpr std::uint32_t kAllPlanes = 0x3Fu;
+    static constexpr std::uint32_t kOutside   = std::numeric_limits<std::uint32_t>::max();
+    static constexpr std::uint8_t  kNoPlane   = 0xFF;
+    static constexpr int           kSAHBins   = 16;
+
+    struct Node {
+        AABB          box;              // leaf: proxy bounds; internal: union of children
+        AABB          fat;              // leaf only: bounds + margin
+        T             user{};
+        std::uint32_t parent = kNull;   // next free node while on the free list
+        std::uint32_t child0 = kNull;
+        std::uint32_t child1 = kNull;
+        std::int32_t  height = -1;      // 0 = leaf, -1 = free
+        std::uint8_t  plane  = kNoPlane;  // last frustum plane that rejected it
+    };
+
+    struct Entry {
+        std::uint32_t node;
+        std::uint32_t planes;           // planes the node may still straddle
+    };
+
+    // Traversal stack: fixed storage for the common case, heap beyond.
+    template<typename E>
+    class Stack {
+    public:
+        void Push(const E& e)
+        {
+            if (size_ < fixed_.size()) fixed_[size_] = e;
+            else                       overflow_.push_back(e);
+            ++size_;
+        }
+        E Pop()
+        {
+            --size_;
+            if (size_ < fixed_.size()) return fixed_[size_];
+            const E e = overflow_.back();
+            overflow_.pop_back();
+            return e;
+        }
+        bool Empty() const { return size_ == 0; }
+
+    private:
+        std::array<E, 128> fixed_;
+        std::vector<E>     overflow_;
+        std::size_t        size_ = 0;
+    };
+
+    // ── Box helpers ───────────────────────────────────────────────────────────
+
+    static AABB Union(const AABB& a, const AABB& b)
+    {
+        AABB r;
+        r.min = glm::min(a.min, b.min);
+        r.max = glm::max(a.max, b.max);
+        return r;
+    }
+
+    static float Area(const AABB& box)
+    {
+        const glm::vec3 d = box.Size();
+        return 2.f * (d.x * d.y + d.y * d.z + d.z * d.x);
+    }
+
+    static bool Contains(const AABB& outer, const AABB& inner)
+    {
+        return glm::all(glm::lessThanEqual(outer.min, inner.min)) &&
+               glm::all(glm::lessThanEqual(inner.max, outer.max));
+    }
+
+    static bool Overlaps(const AABB& a, const AABB& b)
+    {
+        return glm::all(glm::lessThanEqual(a.min, b.max)) &&
+               glm::all(glm::lessThanEqual(b.min, a.max));
+    }
+
+    // A tenth of the size on each side, at least a few centimetres, so small
+    // per-frame motion refits instead of reinserting.
+    static AABB Fatten(const AABB& box)
+    {
+        const glm::vec3 margin = glm::max(box.Extents() * 0.2f, glm::vec3(0.05f));
+        return AABB::FromCenterExtents(box.Center(), box.Extents() + margin);
+    }
+
+    // Drop the planes of mask that box lies fully inside; kOutside if it lies
+    // fully outside one of them, whose index then goes to rejected if given.
+    static std::uint32_t Classify(const Frustum& frustum, const AABB& box, std::uint32_t mask,
+                                  std::uint8_t* rejected = nullptr)
+    {
+        const glm::vec3 c = box.Center();
+        const glm::vec3 e = box.Extents();
+        for (std::uint32_t k = 0; k < 6; ++k) {
+            if (!(mask & (1u << k))) continue;
+            const glm::vec4& p = frustum.planes[k];
+            const float dist   = p.x * c.x + p.y * c.y + p.z * c.z + p.w;
+            const float radius = std::abs(p.x) * e.x + std::abs(p.y) * e.y + std::abs(p.z) * e.z;
+            if (dist + radius < 0.f) {
+                if (rejected) *rejected = static_cast<std::uint8_t>(k);
+                return kOutside;
+            }
+            if (dist - radius >= 0.f) mask &= ~(1u << k);
+        }
+        return mask;
+    }
+
+    // Classify, testing node's cached rejecting plane first and caching the
+    // plane that rejects it.
+    static std::uint32_t ClassifyCoherent(const Frustum& frustum, Node& node,
+                                          std::uint32_t mask, CullCounts& counts)
+    {
+        if (node.plane != kNoPlane && (mask & (1u << node.plane))) {
+            const std::uint32_t bit = 1u << node.plane;
+            ++counts.planeTests;
+            const std::uint32_t r = Classify(frustum, node.box, bit);
+            if (r == kOutside) {
+                ++counts.planeHits;
+                return kOutside;
+            }
+            mask = (mask & ~bit) | r;
+        }
+        return Classify(frustum, node.box, mask, &node.plane);
+    }
+
+    // ── Node pool ─────────────────────────────────────────────────────────────
+
+    std::uint32_t AllocateNode()
+    {
+        if (freeList_ == kNull) {
+            ENGINE_ASSERT(nodes_.size() < kNull, "DynamicBVH: node pool exhausted");
+            nodes_.emplace_back();
+            return static_cast<std::uint32_t>(nodes_.size() - 1);
+        }
+        const std::uint32_t id = freeList_;
+        freeList_ = nodes_[id].parent;
+        nodes_[id] = Node{};
+        return id;
+    }
+
+    void FreeNode(std::uint32_t id)
+    {
+        nodes_[id].parent = freeList_;
+        nodes_[id].height = -1;
+        freeList_ = id;
+    }
+
+    // ── Incremental updates ───────────────────────────────────────────────────
+
+    void InsertLeaf(std::uint32_t leaf)
+    {
+        if (root_ == kNull) {
+            root_ = leaf;
+            nodes_[leaf].parent = kNull;
+            return;
+        }
+
+        // Descend towards the sibling whose pairing adds the least area: the
+        // new parent costs its own area, every ancestor the growth it causes.
+        const AABB box = nodes_[leaf].box;
+        std::uint32_t index = root_;
+        while (nodes_[index].height > 0) {
+            const Node& node     = nodes_[index];
+            const float area     = Area(node.box);
+            const float combined = Area(Union(node.box, box));
+            const float cost     = 2.f * combined;
+            const float inherit  = 2.f * (combined - area);
+
+            auto descendCost = [&](std::uint32_t child) {
+                const Node& c = nodes_[child];
+                const float grown = Area(Union(c.box, box));
+                return (c.height == 0 ? grown : grown - Area(c.box)) + inherit;
+            };
+            const float cost0 = descendCost(node.child0);
+            const float cost1 = descendCost(node.child1);
+
+            if (cost < cost0 && cost < cost1) break;
+            index = cost0 < cost1 ? node.child0 : node.child1;
+        }
+
+        // Replace the sibling with a new parent of (sibling, leaf).
+        const std::uint32_t sibling   = index;
+        const std::uint32_t oldParent = nodes_[sibling].parent;
+        const std::uint32_t newParent = AllocateNode();
+        {
+            Node& p  = nodes_[newParent];
+            p.parent = oldParent;
+            p.box    = Union(box, nodes_[sibling].box);
+            p.height = nodes_[sibling].height + 1;
+            p.child0 = sibling;
+            p.child1 = leaf;
+        }
+        if (oldParent != kNull) ReplaceChild(oldParent, sibling, newParent);
+        else                    root_ = newParent;
+        nodes_[sibling].parent = newParent;
+        nodes_[leaf].parent    = newParent;
+
+        FixUpwards(nodes_[leaf].parent);
+    }
+
+    void RemoveLeaf(std::uint32_t leaf)
+    {
+        if (leaf == root_) {
+            root_ = kNull;
+            return;
+        }
+
+        const std::uint32_t parent      = nodes_[leaf].parent;
+        const std::uint32_t grandParent = nodes_[parent].parent;
+        const std::uint32_t sibling     = nodes_[parent].child0 == leaf ? nodes_[parent].child1
+                                                                        : nodes_[parent].child0;
+        FreeNode(parent);
+
+        if (grandParent == kNull) {
+            root_ = sibling;
+            nodes_[sibling].parent = kNull;
+            return;
+        }
+        ReplaceChild(grandParent, parent, sibling);
+        nodes_[sibling].parent = grandParent;
+        FixUpwards(grandParent);
+    }
+
+    void ReplaceChild(std::uint32_t parent, std::uint32_t oldChild, std::uint32_t newChild)
+    {
+        Node& p = nodes_[parent];
+        if (p.child0 == oldChild) p.child0 = newChild;
+        else                      p.child1 = newChild;
+    }
+
+    // Rebalance and recompute boxes / heights from index up to the root.
+    void FixUpwards(std::uint32_t index)
+    {
+        while (index != kNull) {
+            index = Balance(index);
+            Node& node = nodes_[index];
+            const Node& c0 = nodes_[node.child0];
+            const Node& c1 = nodes_[node.child1];
+            node.height = 1 + std::max(c0.height, c1.height);
+            node.box    = Union(c0.box, c1.box);
+            index = node.parent;
+        }
+    }
+
+    // Recompute boxes from index up to the root; stop once nothing changes.
+    void Refit(std::uint32_t index)
+    {
+        while (index != kNull) {
+            Node& node = nodes_[index];
+            const AABB box = Union(nodes_[node.child0].box, nodes_[node.child1].box);
+            if (box.min == node.box.min && box.max == node.box.max) return;
+            node.box = box;
+            index = node.parent;
+        }
+    }
+
+    // AVL rotation at a: if one child is more than one level taller than the
+    // other, promote it.  Returns the node now at a's position.
+    std::uint32_t Balance(std::uint32_t iA)
+    {
+        Node& A = nodes_[iA];
+        if (A.height < 2) return iA;
+
+        const std::uint32_t iB = A.child0;
+        const std::uint32_t iC = A.child1;
+        Node& B = nodes_[iB];
+        Node& C = nodes_[iC];
+        const std::int32_t balance = C.height - B.height;
+
+        if (balance > 1) {   // promote C
+            const std::uint32_t iF = C.child0;
+            const std::uint32_t iG = C.child1;
+            Node& F = nodes_[iF];
+            Node& G = nodes_[iG];
+
+            C.child0 = iA;
+            C.parent = A.parent;
+            A.parent = iC;
+            if (C.parent != kNull) ReplaceChild(C.parent, iA, iC);
+            else                   root_ = iC;
+
+            if (F.height > G.height) {
+                C.child1 = iF;
+                A.child1 = iG;
+                G.parent = iA;
+                A.box    = Union(B.box, G.box);
+                C.box    = Union(A.box, F.box);
+                A.height = 1 + std::max(B.height, G.height);
+                C.height = 1 + std::max(A.height, F.height);
+            } else {
+                C.child1 = iG;
+                A.child1 = iF;
+                F.parent = iA;
+                A.box    = Union(B.box, F.box);
+                C.box    = Union(A.box, G.box);
+                A.height = 1 + std::max(B.height, F.height);
+                C.height = 1 + std::max(A.height, G.height);
+            }
+            return iC;
+        }
+
+        if (balance < -1) {  // promote B
+            const std::uint32_t iD = B.child0;
+            const std::uint32_t iE = B.child1;
+            Node& D = nodes_[iD];
+            Node& E = nodes_[iE];
+
+            B.child0 = iA;
+            B.parent = A.parent;
+            A.parent = iB;
+            if (B.parent != kNull) ReplaceChild(B.parent, iA, iB);
+            else                   root_ = iB;
+
+            if (D.height > E.height) {
+                B.child1 = iD;
+                A.child0 = iE;
+                E.parent = iA;
+                A.box    = Union(C.box, E.box);
+                B.box    = Union(A.box, D.box);
+                A.height = 1 + std::max(C.height, E.height);
+                B.height = 1 + std::max(A.height, D.height);
+            } else {
+                B.child1 = iE;
+                A.child0 = iD;
+                D.parent = iA;
+                A.box    = Union(C.box, D.box);
+                B.box    = Union(A.box, E.box);
+                A.height = 1 + std::max(C.height, D.height);
+                B.height = 1 + std::max(A.height, E.height);
+            }
+            return iB;
+        }
+
+        return iA;
+    }
+
+    // ── SAH build ─────────────────────────────────────────────────────────────
+
+    // Build a subtree over leaves [first, first + count); returns its root.
+    // Internal nodes come from the free list Rebuild just filled, so nodes_
+    // never reallocates during the build.
+    std::uint32_t BuildSAH(std::uint32_t* first, std::size_t count)
+    {
+        if (count == 1) return first[0];
+
+        AABB centroids;
+        for (std::size_t i = 0; i < count; ++i) centroids.Expand(nodes_[first[i]].box.Center());
+        const glm::vec3 span = centroids.Size();
+        const int axis = span.x > span.y ? (span.x > span.z ? 0 : 2) : (span.y > span.z ? 1 : 2);
+
+        std::size_t mid = count / 2;
+        if (span[axis] > 1e-6f) {
+            const float lo    = centroids.min[axis];
+            const float scale = static_cast<float>(kSAHBins) / span[axis];
+            auto binOf = [&](std::uint32_t leaf) {
+                const int b = static_cast<int>((nodes_[leaf].box.Center()[axis] - lo) * scale);
+                return std::min(b, kSAHBins - 1);
+            };
+
+            std::array<AABB, kSAHBins>        binBox{};
+            std::array<std::size_t, kSAHBins> binCount{};
+            for (std::size_t i = 0; i < count; ++i) {
+                const int b = binOf(first[i]);
+                binBox[b].Expand(nodes_[first[i]].box);
+                ++binCount[b];
+            }
+
+            // Cost of splitting after bin s: area * count on either side.
+            std::array<float, kSAHBins> rightCost{};
+            AABB        right;
+            std::size_t rightCount = 0;
+            for (int s = kSAHBins - 1; s > 0; --s) {
+                if (binCount[s] > 0) right.Expand(binBox[s]);
+                rightCount += binCount[s];
+                rightCost[s] = rightCount > 0 ? Area(right) * static_cast<float>(rightCount) : 0.f;
+            }
+
+            float       bestCost  = std::numeric_limits<float>::max();
+            int         bestSplit = 0;
+            AABB        left;
+            std::size_t leftCount = 0;
+            for (int s = 1; s < kSAHBins; ++s) {
+                if (binCount[s - 1] > 0) left.Expand(binBox[s - 1]);
+                leftCount += binCount[s - 1];
+                if (leftCount == 0 || leftCount == count) continue;
+                const float cost = Area(left) * static_cast<float>(leftCount) + rightCost[s];
+                if (cost < bestCost) { bestCost = cost; bestSplit = s; }
+            }
+
+            if (bestSplit > 0) {
+                std::uint32_t* split = std::partition(first, first + count,
+                    [&](std::uint32_t leaf) { return binOf(leaf) < bestSplit; });
+                mid = static_cast<std::size_t>(split - first);
+            }
+        }
+        if (mid == 0 || mid == count) {
+            // Coincident centroids: any balanced split is as good as another.
+            mid = count / 2;
+            std::nth_element(first, first + mid, first + count,
+                [&](std::uint32_t a, std::uint32_t b) {
+                    return nodes_[a].box.Center()[axis] < nodes_[b].box.Center()[axis];
+                });
+        }
+
+        const std::uint32_t id = AllocateNode();
+        const std::uint32_t c0 = BuildSAH(first, mid);
+        const std::uint32_t c1 = BuildSAH(first + mid, count - mid);
+
+        Node& node  = nodes_[id];
+        node.child0 = c0;
+        node.child1 = c1;
+        node.box    = Union(nodes_[c0].box, nodes_[c1].box);
+        node.height = 1 + std::max(nodes_[c0].height, nodes_[c1].height);
+        nodes_[c0].parent = id;
+        nodes_[c1].parent = id;
+        return id;
+    }
+
+    std::vector<Node> nodes_;
+    std::uint32_t     root_       = kNull;
+    std::uint32_t     freeList_   = kNull;
+    std::size_t       proxyCount_ = 0;
+};
+
+} // namespace engine
@@ -1,12 +1,14 @@
 #pragma once
 
 #include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+#include <glm/mat4x4.hpp>
 #include <glm/common.hpp>
 #include <limits>
 
 namespace engine {
 
-// Axis-Aligned Bounding Box in local (model) space.
+// Axis-Aligned Bounding Box, in local (model) or world space.
 struct AABB {
     glm::vec3 min = glm::vec3( std::numeric_limits<float>::max());
     glm::vec3 max = glm::vec3(-std::numeric_limits<float>::max());
@@ -28,6 +30,27 @@ struct AABB {
         Expand(other.min);
         Expand(other.max);
     }
+
+    static AABB FromCenterExtents(const glm::vec3& center, const glm::vec3& extents)
+    {
+        AABB box;
+        box.min = center - extents;
+        box.max = center + extents;
+        return box;
+    }
 };
 
+// Tightest AABB enclosing aabb transformed by m (Arvo): the center goes
+// through the full matrix, the extents through |upper 3x3|.  Three
+// multiply-adds per axis instead of transforming eight corners.
+inline AABB TransformAABB(const AABB& aabb, const glm::mat4& m)
+{
+    const glm::vec3 e = aabb.Extents();
+    const glm::vec3 center  = glm::vec3(m * glm::vec4(aabb.Center(), 1.f));
+    const glm::vec3 extents = glm::abs(glm::vec3(m[0])) * e.x
+                            + glm::abs(glm::vec3(m[1])) * e.y
+                            + glm::abs(glm::vec3(m[2])) * e.z;
+    return AABB::FromCenterExtents(center, extents);
+}
+
 } // namespace engine
@@ -0,0 +1,154 @@
+#include "JobSystem.hpp"
+
+#include <core/Log.hpp>
+
+namespace engine {
+
+namespace {
+
+// Index of the current thread's deque; workers set it on start-up.
+thread_local std::uint32_t tlsThreadIndex = 0;
+
+} // namespace
+
+// ─── WorkQueue ────────────────────────────────────────────────────────────────
+
+bool JobSystem::WorkQueue::Push(const Job& job)
+{
+    std::lock_guard lock(mutex);
+    if (tail - head == kCapacity) return false;
+    jobs[tail & (kCapacity - 1u)] = job;
+    ++tail;
+    return true;
+}
+
+bool JobSystem::WorkQueue::Pop(Job& out)
+{
+    std::lock_guard lock(mutex);
+    if (tail == head) return false;
+    --tail;
+    out = jobs[tail & (kCapacity - 1u)];
+    return true;
+}
+
+bool JobSystem::WorkQueue::Steal(Job& out)
+{
+    std::lock_guard lock(mutex);
+    if (tail == head) return false;
+    out = jobs[head & (kCapacity - 1u)];
+    ++head;
+    return true;
+}
+
+// ─── JobSystem ────────────────────────────────────────────────────────────────
+
+JobSystem::JobSystem(std::uint32_t workerCount)
+{
+    if (workerCount == kHardwareWorkers) {
+        const std::uint32_t hw = std::thread::hardware_concurrency();
+        workerCount = hw > 1u ? hw - 1u : 0u;
+    }
+
+    queues_.reserve(workerCount + 1u);
+    for (std::uint32_t i = 0; i <= workerCount; ++i)
+        queues_.push_back(std::make_unique<WorkQueue>());
+
+    workers_.reserve(workerCount);
+    for (std::uint32_t i = 0; i < workerCount; ++i)
+        workers_.emplace_back([this, i] { WorkerLoop(i + 1u); });
+
+    LOG_INFO("JobSystem: {} worker thread(s) + main thread", workerCount);
+}
+
+JobSystem::~JobSystem()
+{
+    {
+        std::lock_guard lock(wakeMutex_);
+        stop_ = true;
+    }
+    wakeCv_.notify_all();
+    for (auto& worker : workers_) worker.join();
+}
+
+std::uint32_t JobSystem::ThreadIndex()
+{
+    return tlsThreadIndex;
+}
+
+void JobSystem::Dispatch(std::uint32_t count, std::uint32_t grain, JobFn fn, void* context)
+{
+    const std::uint32_t index  = tlsThreadIndex;
+    const std::uint32_t chunks = (count + grain - 1u) / grain;
+    std::atomic<std::uint32_t> pending{chunks};
+
+    WorkQueue& queue = *queues_[index];
+    for (std::uint32_t begin = 0; begin < count; begin += grain) {
+        const Job job{fn, context, begin, std::min(begin + grain, count), &pending};
+
+        // Count the job before publishing it so a thief can never decrement
+        // queued_ below zero.  A full deque degrades to inline execution.
+        queued_.fetch_add(1u, std::memory_order_relaxed);
+        if (!queue.Push(job)) {
+            queued_.fetch_sub(1u, std::memory_order_relaxed);
+            Run(job);
+        }
+    }
+    Wake();
+
+    // Help until every chunk of this dispatch has run.  Jobs taken here may
+    // belong to other dispatches (nested ParallelFor); that is fine — they
+    // have to run somewhere.
+    while (pending.load(std::memory_order_acquire) != 0) {
+        Job job;
+        if (TryGetJob(index, job)) Run(job);
+        else                       std::this_thread::yield();
+    }
+}
+
+void JobSystem::WorkerLoop(std::uint32_t index)
+{
+    tlsThreadIndex = index;
+
+    for (;;) {
+        Job job;
+        if (TryGetJob(index, job)) {
+            Run(job);
+            continue;
+        }
+
+        std::unique_lock lock(wakeMutex_);
+        wakeCv_.wait(lock, [this] {
+            return stop_ || queued_.load(std::memory_order_relaxed) != 0;
+        });
+        if (stop_) return;
+    }
+}
+
+// Own deque first (LIFO), then steal round-robin starting at the neighbour.
+bool JobSystem::TryGetJob(std::uint32_t index, Job& out)
+{
+    bool found = queues_[index]->Pop(out);
+
+    const auto n = static_cast<std::uint32_t>(queues_.size());
+    for (std::uint32_t i = 1; !found && i < n; ++i)
+        found = queues_[(index + i) % n]->Steal(out);
+
+    if (found) queued_.fetch_sub(1u, std::memory_order_relaxed);
+    return found;
+}
+
+// Taking the mutex orders the queued_ increment before a sleeping worker's
+// predicate check, so the notification cannot be lost.
+void JobSystem::Wake()
+{
+    { std::lock_guard lock(wakeMutex_); }
+    wakeCv_.notify_all();
+}
+
+void JobSystem::Run(const Job& job)
+{
+    job.fn(job.context, job.begin, job.end);
+    job.pending->fetch_sub(1u, std::memory_order_release);
+}
+
+} // namespace engine
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace engine {
+
+// ─── JobSystem ────────────────────────────────────────────────────────────────
+// Fixed pool of worker threads fed by per-thread work-stealing deques.
+//
+// Each thread that executes jobs (the workers plus the thread that owns the
+// JobSystem) has its own deque.  ParallelFor pushes its chunks onto the
+// calling thread's deque and then helps drain it; the owner pops from the
+// back (most recently pushed, still warm in cache) while idle workers steal
+// from the front of other deques.  Idle workers sleep on a condition variable
+// rather than spinning, so an unused JobSystem costs nothing.
+//
+// Jobs are plain {function, context, range} records — no allocation per
+// dispatch.  ParallelFor blocks until every chunk has run, so the callable
+// and anything it captures by reference stay alive for the whole dispatch.
+//
+// ParallelFor may be called from the owning thread or from inside a job
+// (nested dispatch); other threads must not call it.
+class JobSystem {
+public:
+    // workerCount of kHardwareWorkers picks one worker per hardware thread,
+    // minus one for the calling thread, which executes jobs while it waits.
+    // With 0 workers every ParallelFor runs inline on the calling thread.
+    static constexpr std::uint32_t kHardwareWorkers = ~0u;
+
+    explicit JobSystem(std::uint32_t workerCount = kHardwareWorkers);
+    ~JobSystem();
+
+    JobSystem(const JobSystem&)            = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+    JobSystem(JobSystem&&)                 = delete;
+    JobSystem& operator=(JobSystem&&)      = delete;
+
+    // Split [0, count) into chunks of at most `grain` indices and call
+    // fn(begin, end) for each chunk, concurrently.  Returns once all chunks
+    // have finished.  Runs inline when there are no workers or the range fits
+    // in a single chunk.
+    template<typename Fn>
+    void ParallelFor(std::uint32_t count, std::uint32_t grain, Fn&& fn)
+    {
+        if (count == 0) return;
+        grain = std::max(grain, 1u);
+        if (workers_.empty() || count <= grain) {
+            fn(0u, count);
+            return;
+        }
+        using F = std::remove_reference_t<Fn>;
+        Dispatch(count, grain, &Invoke<F>,
+                 const_cast<void*>(static_cast<const void*>(std::addressof(fn))));
+    }
+
+    // Threads that execute jobs: the workers plus the owning thread.  Sizes
+    // per-thread scratch indexed by ThreadIndex().
+    std::uint32_t ThreadCount() const
+    {
+        return static_cast<std::uint32_t>(workers_.size()) + 1u;
+    }
+
+    // Index of the calling thread in [0, ThreadCount()).  The owning thread
+    // (and any thread that is not a worker) is 0.
+    static std::uint32_t ThreadIndex();
+
+private:
+    using JobFn = void (*)(void* context, std::uint32_t begin, std::uint32_t end);
+
+    struct Job {
+        JobFn                       fn      = nullptr;
+        void*                       context = nullptr;
+        std::uint32_t               begin   = 0;
+        std::uint32_t               end     = 0;
+        std::atomic<std::uint32_t>* pending = nullptr;  // decremented when done
+    };
+
+    // Fixed-capacity ring of jobs guarded by a mutex.  Contention is limited
+    // to the moment a thief and the owner touch the same deque; jobs are
+    // coarse (hundreds of entities each), so the lock is never the hot path.
+    struct alignas(64) WorkQueue {
+        static constexpr std::uint32_t kCapacity = 1024;  // power of two
+
+        std::mutex    mutex;
+        Job           jobs[kCapacity];
+        std::uint32_t head = 0;   // next to steal  (front)
+        std::uint32_t tail = 0;   // next free slot (back)
+
+        bool Push(const Job& job);
+        bool Pop(Job& out);       // owner: back
+        bool Steal(Job& out);     // thief: front
+    };
+
+    std::vector<std::unique_ptr<WorkQueue>> queues_;    // [0] = owning thread
+    std::vector<std::thread>                workers_;   // worker i uses queues_[i + 1]
+
+    std::mutex                 wakeMutex_;
+    std::condition_variable    wakeCv_;
+    std::atomic<std::uint32_t> queued_{0};   // jobs sitting in any deque
+    bool                       stop_ = false;
+
+    template<typename F>
+    static void Invoke(void* context, std::uint32_t begin, std::uint32_t end)
+    {
+        (*static_cast<F*>(context))(begin, end);
+    }
+
+    void Dispatch(std::uint32_t count, std::uint32_t grain, JobFn fn, void* context);
+    void WorkerLoop(std::uint32_t index);
+    bool TryGetJob(std::uint32_t index, Job& out);
+    void Wake();
+
+    static void Run(const Job& job);
+};
+
+} // namespace engine
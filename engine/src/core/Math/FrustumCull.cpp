@@ -0,0 +1,111 @@
+#include "FrustumCull.hpp"
+#include "FrustumCullKernel.hpp"
+#include "SimdDispatch.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+#if defined(__SSE2__)
+#  include <emmintrin.h>
+#endif
+
+namespace engine {
+
+namespace {
+
+#if defined(__SSE2__)
+
+// ─── SSE2 traits (4 lanes) ────────────────────────────────────────────────────
+struct SSE2 {
+    using V = __m128;
+    static constexpr std::size_t kWidth = 4;
+
+    static V Set1(float f)         { return _mm_set1_ps(f); }
+    static V Load(const float* p)  { return _mm_loadu_ps(p); }
+
+    static V MulAdd(V a, V b, V c) { return _mm_add_ps(_mm_mul_ps(a, b), c); }
+    static V And(V a, V b)         { return _mm_and_ps(a, b); }
+    static V CmpGE(V a, V b)       { return _mm_cmpge_ps(a, b); }
+    static int MoveMask(V m)       { return _mm_movemask_ps(m); }
+};
+
+#endif // __SSE2__
+
+void ClearMask(std::uint64_t* visible, std::size_t count)
+{
+    std::fill_n(visible, CullMaskWords(count), std::uint64_t{0});
+}
+
+// OR the bits of boxes [begin, end) into visible.
+void RunScalar(const Frustum& frustum, const CullBatchInput& in,
+               std::uint64_t* visible, std::size_t begin, std::size_t end)
+{
+    for (std::size_t i = begin; i < end; ++i) {
+        bool inside = true;
+        for (const glm::vec4& p : frustum.planes) {
+            const float s = p.x * in.centerX[i] + p.y * in.centerY[i] + p.z * in.centerZ[i]
+                          + std::fabs(p.x) * in.extentX[i]
+                          + std::fabs(p.y) * in.extentY[i]
+                          + std::fabs(p.z) * in.extentZ[i] + p.w;
+            if (!(s >= 0.f)) { inside = false; break; }
+        }
+        if (inside) visible[i / 64] |= std::uint64_t{1} << (i % 64);
+    }
+}
+
+} // namespace
+
+// ─── Kernels ──────────────────────────────────────────────────────────────────
+
+namespace detail {
+
+void CullAABBsScalar(const Frustum& frustum, const CullBatchInput& in,
+                     std::uint64_t* visible, std::size_t count)
+{
+    ClearMask(visible, count);
+    RunScalar(frustum, in, visible, 0, count);
+}
+
+bool CullAABBsSSE2(const Frustum& frustum, const CullBatchInput& in,
+                   std::uint64_t* visible, std::size_t count)
+{
+#if defined(__SSE2__)
+    ClearMask(visible, count);
+    const std::size_t done = cull::RunCullKernel<SSE2>(frustum, in, visible, count);
+    RunScalar(frustum, in, visible, done, count);
+    return true;
+#else
+    (void)frustum; (void)in; (void)visible; (void)count;
+    return false;
+#endif
+}
+
+#if !defined(ENGINE_SIMD_AVX2)
+// Without the AVX2 translation unit (non-x86 targets) the kernel is absent.
+bool CullAABBsAVX2(const Frustum&, const CullBatchInput&, std::uint64_t*, std::size_t)
+{
+    return false;
+}
+#endif
+
+} // namespace detail
+
+// ─── Public API ───────────────────────────────────────────────────────────────
+
+std::size_t CullAABBs(const Frustum& frustum, const CullBatchInput& in,
+                      std::uint64_t* visible, std::size_t count)
+{
+    switch (ActiveSimdPath()) {
+        case SimdPath::AVX2: detail::CullAABBsAVX2(frustum, in, visible, count); break;
+        case SimdPath::SSE2: detail::CullAABBsSSE2(frustum, in, visible, count); break;
+        default:             detail::CullAABBsScalar(frustum, in, visible, count); break;
+    }
+
+    std::size_t visibleCount = 0;
+    for (std::size_t w = 0; w < CullMaskWords(count); ++w)
+        visibleCount += static_cast<std::size_t>(std::popcount(visible[w]));
+    return visibleCount;
+}
+
+} // namespace engine
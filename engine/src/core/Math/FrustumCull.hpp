@@ -0,0 +1,56 @@
+#pragma once
+
+#include <core/Frustum.hpp>
+#include <cstddef>
+#include <cstdint>
+
+namespace engine {
+
+// ─── FrustumCull ──────────────────────────────────────────────────────────────
+// Batched frustum test of world-space AABBs given as SoA centers / extents.
+//
+// A box is outside a plane (n, d) when even its most positive corner is:
+// dot(n, c) + dot(|n|, e) + d < 0.  That is one multiply-add chain per plane
+// per box and no corner transform, so the SIMD kernels test 8 (AVX2 + FMA,
+// chosen at run time; see SimdDispatch.hpp) or 4 (SSE2) boxes per plane per
+// step.  Other targets, and the tail of every batch, take the scalar path.
+//
+// Like Frustum::ContainsAABB the test is conservative: a box is only culled
+// when it lies entirely outside one plane.
+
+// SoA input: element i of every array describes box i.  Extents are
+// half-sizes and must be non-negative.
+struct CullBatchInput {
+    const float* centerX;
+    const float* centerY;
+    const float* centerZ;
+    const float* extentX;
+    const float* extentY;
+    const float* extentZ;
+};
+
+// Words of visibility mask needed for count boxes.
+constexpr std::size_t CullMaskWords(std::size_t count) { return (count + 63u) / 64u; }
+
+// Writes the visibility of boxes [0, count) to visible: bit i % 64 of word
+// i / 64 is set when box i may overlap the frustum.  visible must hold
+// CullMaskWords(count) words; bits past count are cleared.  Returns the
+// number of visible boxes.
+std::size_t CullAABBs(const Frustum& frustum, const CullBatchInput& in,
+                      std::uint64_t* visible, std::size_t count);
+
+namespace detail {
+
+// Individual kernels, exposed for benchmarks; CullAABBs picks one by
+// ActiveSimdPath().  Same contract as CullAABBs minus the count; the SIMD
+// ones return false when unavailable in this build / CPU.
+void CullAABBsScalar(const Frustum& frustum, const CullBatchInput& in,
+                     std::uint64_t* visible, std::size_t count);
+bool CullAABBsSSE2  (const Frustum& frustum, const CullBatchInput& in,
+                     std::uint64_t* visible, std::size_t count);
+bool CullAABBsAVX2  (const Frustum& frustum, const CullBatchInput& in,
+                     std::uint64_t* visible, std::size_t count);
+
+} // namespace detail
+
+} // namespace engine
@@ -0,0 +1,52 @@
+// Compiled with -mavx2 -mfma (see src/CMakeLists.txt).  Only reached through
+// FrustumCull.cpp's run-time dispatch, so nothing here may be inlined into, or
+// shared with, generic code: intrinsics and the kernel templates only.
+
+#include "FrustumCull.hpp"
+#include "FrustumCullKernel.hpp"
+
+#include <immintrin.h>
+
+namespace engine {
+
+namespace {
+
+// ─── AVX2 traits (8 lanes) ────────────────────────────────────────────────────
+struct AVX2 {
+    using V = __m256;
+    static constexpr std::size_t kWidth = 8;
+
+    static V Set1(float f)         { return _mm256_set1_ps(f); }
+    static V Load(const float* p)  { return _mm256_loadu_ps(p); }
+
+    static V MulAdd(V a, V b, V c) { return _mm256_fmadd_ps(a, b, c); }
+    static V And(V a, V b)         { return _mm256_and_ps(a, b); }
+    static V CmpGE(V a, V b)       { return _mm256_cmp_ps(a, b, _CMP_GE_OQ); }
+    static int MoveMask(V m)       { return _mm256_movemask_ps(m); }
+};
+
+} // namespace
+
+namespace detail {
+
+bool CullAABBsAVX2(const Frustum& frustum, const CullBatchInput& in,
+                   std::uint64_t* visible, std::size_t count)
+{
+    for (std::size_t w = 0; w < CullMaskWords(count); ++w) visible[w] = 0;
+
+    const std::size_t done = cull::RunCullKernel<AVX2>(frustum, in, visible, count);
+    if (done < count) {
+        // Fewer than 8 boxes left, all in the word holding box `done`.
+        const CullBatchInput tail{
+            in.centerX + done, in.centerY + done, in.centerZ + done,
+            in.extentX + done, in.extentY + done, in.extentZ + done};
+        std::uint64_t bits = 0;
+        CullAABBsScalar(frustum, tail, &bits, count - done);
+        visible[done / 64] |= bits << (done % 64);
+    }
+    return true;
+}
+
+} // namespace detail
+
+} // namespace engine
@@ -0,0 +1,94 @@
+#pragma once
+
+// Private to core/Math/FrustumCull*.cpp — width-generic frustum kernel.
+//
+// Each SIMD translation unit defines a traits type W (in an anonymous
+// namespace) and instantiates RunCullKernel<W>.  W provides:
+//
+//   V, kWidth              float vector type, lane count
+//   Set1, Load             broadcast, unaligned load
+//   MulAdd(a, b, c)        a * b + c
+//   And(a, b)              bitwise and of lane masks
+//   CmpGE(a, b)            all-ones lane mask where a >= b (false for NaN)
+//   MoveMask(m)            lane k's sign bit → bit k of the result
+//
+// Everything here is a template, so instantiations with the AVX2 traits stay
+// inside the AVX2 translation unit and cannot leak into generic code.
+
+#include <core/Math/FrustumCull.hpp>
+#include <cstddef>
+#include <cstdint>
+
+namespace engine::detail::cull {
+
+// Plane coefficients broadcast once per batch.
+template<typename W>
+struct Planes {
+    typename W::V nx[6], ny[6], nz[6];   // normal
+    typename W::V ax[6], ay[6], az[6];   // |normal|
+    typename W::V d[6];
+};
+
+template<typename W>
+inline Planes<W> Broadcast(const Frustum& frustum)
+{
+    // Not std::fabs: an out-of-line copy emitted by the AVX2 unit could be the
+    // one the linker keeps for generic code.
+    const auto abs = [](float f) { return f < 0.f ? -f : f; };
+
+    Planes<W> p;
+    for (int k = 0; k < 6; ++k) {
+        const glm::vec4& plane = frustum.planes[k];
+        p.nx[k] = W::Set1(plane.x);
+        p.ny[k] = W::Set1(plane.y);
+        p.nz[k] = W::Set1(plane.z);
+        p.ax[k] = W::Set1(abs(plane.x));
+        p.ay[k] = W::Set1(abs(plane.y));
+        p.az[k] = W::Set1(abs(plane.z));
+        p.d[k]  = W::Set1(plane.w);
+    }
+    return p;
+}
+
+// Visibility bits of boxes [i, i + kWidth).
+template<typename W>
+inline std::uint64_t CullBlock(const Planes<W>& p, const CullBatchInput& in, std::size_t i)
+{
+    using V = typename W::V;
+
+    const V cx = W::Load(in.centerX + i);
+    const V cy = W::Load(in.centerY + i);
+    const V cz = W::Load(in.centerZ + i);
+    const V ex = W::Load(in.extentX + i);
+    const V ey = W::Load(in.extentY + i);
+    const V ez = W::Load(in.extentZ + i);
+
+    const V zero = W::Set1(0.f);
+    V inside = W::CmpGE(zero, zero);
+    for (int k = 0; k < 6; ++k) {
+        // dot(n, c) + dot(|n|, e) + d: signed distance of the box's most
+        // positive corner along this plane.
+        const V s = W::MulAdd(p.nx[k], cx, W::MulAdd(p.ny[k], cy, W::MulAdd(p.nz[k], cz,
+                    W::MulAdd(p.ax[k], ex, W::MulAdd(p.ay[k], ey, W::MulAdd(p.az[k], ez, p.d[k]))))));
+        inside = W::And(inside, W::CmpGE(s, zero));
+    }
+    return static_cast<std::uint64_t>(W::MoveMask(inside));
+}
+
+// Process the largest multiple of kWidth, OR-ing bits into visible (which the
+// caller has cleared); returns how many boxes were tested.  kWidth divides 64,
+// so a block never straddles two mask words.
+template<typename W>
+inline std::size_t RunCullKernel(const Frustum& frustum, const CullBatchInput& in,
+                                 std::uint64_t* visible, std::size_t count)
+{
+    static_assert(64 % W::kWidth == 0);
+
+    const Planes<W> planes = Broadcast<W>(frustum);
+    std::size_t i = 0;
+    for (; i + W::kWidth <= count; i += W::kWidth)
+        visible[i / 64] |= CullBlock<W>(planes, in, i) << (i % 64);
+    return i;
+}
+
+} // namespace engine::detail::cull
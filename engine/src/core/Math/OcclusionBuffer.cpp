@@ -0,0 +1,281 @@
+#include "OcclusionBuffer.hpp"
+#include "OcclusionRasterKernel.hpp"
+#include "SimdDispatch.hpp"
+
+#include <core/Assert.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+#if defined(__SSE2__)
+#  include <emmintrin.h>
+#endif
+
+namespace engine {
+
+namespace {
+
+// A candidate must be nearer than this fraction beyond the occluders to be
+// kept; absorbs rounding between the rasterized planes and the box corners
+// (an occluder's own bounds touch its surface).
+constexpr float kDepthBias = 1e-4f;
+
+// Triangles with less screen area than this (in pixels²) cover no pixel
+// center worth the setup.
+constexpr float kMinArea = 1e-6f;
+
+#if defined(__SSE2__)
+
+// ─── SSE2 traits (4 lanes) ────────────────────────────────────────────────────
+struct SSE2 {
+    using V = __m128;
+    static constexpr std::size_t kWidth = 4;
+
+    static V Set1(float f)          { return _mm_set1_ps(f); }
+    static V Load(const float* p)   { return _mm_loadu_ps(p); }
+    static void Store(float* p, V v){ _mm_storeu_ps(p, v); }
+
+    static V Add(V a, V b)          { return _mm_add_ps(a, b); }
+    static V MulAdd(V a, V b, V c)  { return _mm_add_ps(_mm_mul_ps(a, b), c); }
+    static V Max(V a, V b)          { return _mm_max_ps(a, b); }
+    static V And(V a, V b)          { return _mm_and_ps(a, b); }
+    static V CmpGE(V a, V b)        { return _mm_cmpge_ps(a, b); }
+    static int MoveMask(V m)        { return _mm_movemask_ps(m); }
+};
+
+#endif // __SSE2__
+
+// Pixel position (x, y) and 1/w of a clip-space vertex; y points up.
+struct ScreenVertex {
+    float x, y, invW;
+};
+
+ScreenVertex ToScreen(const glm::vec4& clip, float width, float height)
+{
+    const float invW = 1.f / clip.w;
+    return {(clip.x * invW * 0.5f + 0.5f) * width,
+            (clip.y * invW * 0.5f + 0.5f) * height,
+            invW};
+}
+
+// Edge function of p → q: positive on the left, i.e. inside a
+// counter-clockwise triangle.
+void SetEdge(detail::OcclusionTriangle& t, int k, const ScreenVertex& p, const ScreenVertex& q)
+{
+    t.edgeA[k] = p.y - q.y;
+    t.edgeB[k] = q.x - p.x;
+    t.edgeC[k] = p.x * q.y - p.y * q.x;
+}
+
+} // namespace
+
+// ─── Triangle setup and kernels ───────────────────────────────────────────────
+
+namespace detail {
+
+bool SetupOcclusionTriangle(const glm::vec4& clipA, const glm::vec4& clipB, const glm::vec4& clipC,
+                            std::uint32_t bufferWidth, std::uint32_t bufferHeight,
+                            OcclusionTriangle& t)
+{
+    // In front of the near plane: z >= 0 with depth in [0, 1].  Dropping a
+    // crossing triangle instead of clipping it only loses occlusion.
+    if (clipA.z < 0.f || clipB.z < 0.f || clipC.z < 0.f ||
+        clipA.w <= 0.f || clipB.w <= 0.f || clipC.w <= 0.f) return false;
+
+    const float fw = static_cast<float>(bufferWidth);
+    const float fh = static_cast<float>(bufferHeight);
+    const ScreenVertex a = ToScreen(clipA, fw, fh);
+    ScreenVertex       b = ToScreen(clipB, fw, fh);
+    ScreenVertex       c = ToScreen(clipC, fw, fh);
+
+    float area = (b.x - a.x) * (c.y - a.y) - (c.x - a.x) * (b.y - a.y);
+    if (std::fabs(area) < kMinArea) return false;
+    if (area < 0.f) { std::swap(b, c); area = -area; }
+
+    const float minX = std::min({a.x, b.x, c.x}), maxX = std::max({a.x, b.x, c.x});
+    const float minY = std::min({a.y, b.y, c.y}), maxY = std::max({a.y, b.y, c.y});
+    if (maxX < 0.f || maxY < 0.f || minX >= fw || minY >= fh) return false;
+
+    // Clamp in float first: vertices near the eye can land far off screen.
+    t.minX = static_cast<std::int32_t>(std::floor(std::max(0.f, minX)));
+    t.maxX = static_cast<std::int32_t>(std::floor(std::min(fw - 1.f, maxX)));
+    t.minY = static_cast<std::int32_t>(std::floor(std::max(0.f, minY)));
+    t.maxY = static_cast<std::int32_t>(std::floor(std::min(fh - 1.f, maxY)));
+
+    // Edge k is opposite vertex k, so edge k / area is vertex k's barycentric
+    // weight and 1/w = sum(weight_k * invW_k) is a plane in (x, y).
+    SetEdge(t, 0, b, c);
+    SetEdge(t, 1, c, a);
+    SetEdge(t, 2, a, b);
+
+    const float inv = 1.f / area;
+    t.depthA = (t.edgeA[0] * a.invW + t.edgeA[1] * b.invW + t.edgeA[2] * c.invW) * inv;
+    t.depthB = (t.edgeB[0] * a.invW + t.edgeB[1] * b.invW + t.edgeB[2] * c.invW) * inv;
+    t.depthC = (t.edgeC[0] * a.invW + t.edgeC[1] * b.invW + t.edgeC[2] * c.invW) * inv;
+    return true;
+}
+
+void RasterizeOccludersScalar(float* depth, std::uint32_t width,
+                              const OcclusionTriangle* tris, std::size_t count)
+{
+    for (std::size_t i = 0; i < count; ++i) {
+        const OcclusionTriangle& t = tris[i];
+        for (std::int32_t y = t.minY; y <= t.maxY; ++y) {
+            const float fy = static_cast<float>(y) + 0.5f;
+            float* row = depth + static_cast<std::size_t>(y) * width;
+            for (std::int32_t x = t.minX; x <= t.maxX; ++x) {
+                const float fx = static_cast<float>(x) + 0.5f;
+                bool inside = true;
+                for (int k = 0; k < 3; ++k)
+                    inside = inside && t.edgeA[k] * fx + t.edgeB[k] * fy + t.edgeC[k] >= 0.f;
+                if (inside)
+                    row[x] = std::max(row[x], t.depthA * fx + t.depthB * fy + t.depthC);
+            }
+        }
+    }
+}
+
+bool RasterizeOccludersSSE2(float* depth, std::uint32_t width,
+                            const OcclusionTriangle* tris, std::size_t count)
+{
+#if defined(__SSE2__)
+    occlusion::RunRasterKernel<SSE2>(depth, width, tris, count);
+    return true;
+#else
+    (void)depth; (void)width; (void)tris; (void)count;
+    return false;
+#endif
+}
+
+#if !defined(ENGINE_SIMD_AVX2)
+// Without the AVX2 translation unit (non-x86 targets) the kernel is absent.
+bool RasterizeOccludersAVX2(float*, std::uint32_t, const OcclusionTriangle*, std::size_t)
+{
+    return false;
+}
+#endif
+
+} // namespace detail
+
+// ─── OcclusionBuffer ──────────────────────────────────────────────────────────
+
+OcclusionBuffer::OcclusionBuffer(std::uint32_t width, std::uint32_t height)
+    : width_(width)
+    , height_(height)
+{
+    ENGINE_ASSERT(width > 0 && width % 8 == 0 && height > 0,
+                  "OcclusionBuffer width must be a non-zero multiple of 8");
+
+    // Level k is ceil(level k-1 / 2) in each axis, down to 1x1, so texel
+    // (x >> k, y >> k) of level k covers pixel (x, y).
+    std::size_t   offset = 0;
+    std::uint32_t w = width, h = height;
+    for (;;) {
+        levels_.push_back({offset, w, h});
+        offset += static_cast<std::size_t>(w) * h;
+        if (w == 1 && h == 1) break;
+        w = (w + 1) / 2;
+        h = (h + 1) / 2;
+    }
+    pyramid_.resize(offset, 0.f);
+}
+
+void OcclusionBuffer::Begin(const glm::mat4& viewProjection)
+{
+    viewProjection_ = viewProjection;
+    triangleCount_  = 0;
+    std::fill_n(pyramid_.begin(), static_cast<std::size_t>(width_) * height_, 0.f);
+}
+
+void OcclusionBuffer::RasterizeOccluder(std::span<const glm::vec3>     positions,
+                                        std::span<const std::uint32_t> indices,
+                                        const glm::mat4&               model)
+{
+    const glm::mat4 mvp = viewProjection_ * model;
+    clip_.resize(positions.size());
+    for (std::size_t i = 0; i < positions.size(); ++i)
+        clip_[i] = mvp * glm::vec4(positions[i], 1.f);
+
+    tris_.clear();
+    for (std::size_t i = 0; i + 2 < indices.size(); i += 3) {
+        detail::OcclusionTriangle t;
+        if (detail::SetupOcclusionTriangle(clip_[indices[i]], clip_[indices[i + 1]],
+                                           clip_[indices[i + 2]], width_, height_, t))
+            tris_.push_back(t);
+    }
+    triangleCount_ += static_cast<std::uint32_t>(tris_.size());
+
+    float* depth = pyramid_.data();
+    switch (ActiveSimdPath()) {
+        case SimdPath::AVX2: detail::RasterizeOccludersAVX2(depth, width_, tris_.data(), tris_.size()); break;
+        case SimdPath::SSE2: detail::RasterizeOccludersSSE2(depth, width_, tris_.data(), tris_.size()); break;
+        default:             detail::RasterizeOccludersScalar(depth, width_, tris_.data(), tris_.size()); break;
+    }
+}
+
+void OcclusionBuffer::BuildPyramid()
+{
+    for (std::size_t l = 1; l < levels_.size(); ++l) {
+        const Level& src = levels_[l - 1];
+        const Level& dst = levels_[l];
+        const float* in  = pyramid_.data() + src.offset;
+        float*       out = pyramid_.data() + dst.offset;
+
+        for (std::uint32_t y = 0; y < dst.height; ++y) {
+            // Odd source sizes: the last texel has a single child row / column.
+            const std::uint32_t y0 = 2 * y, y1 = std::min(y0 + 1, src.height - 1);
+            const float* row0 = in + static_cast<std::size_t>(y0) * src.width;
+            const float* row1 = in + static_cast<std::size_t>(y1) * src.width;
+            for (std::uint32_t x = 0; x < dst.width; ++x) {
+                const std::uint32_t x0 = 2 * x, x1 = std::min(x0 + 1, src.width - 1);
+                out[static_cast<std::size_t>(y) * dst.width + x] =
+                    std::min(std::min(row0[x0], row0[x1]), std::min(row1[x0], row1[x1]));
+            }
+        }
+    }
+}
+
+bool OcclusionBuffer::IsOccluded(const AABB& worldBounds) const
+{
+    // Corners as clip center ± the three clip-space half-axes: adds only.
+    const glm::vec3 e  = worldBounds.Extents();
+    const glm::vec4 c  = viewProjection_ * glm::vec4(worldBounds.Center(), 1.f);
+    const glm::vec4 ax = viewProjection_[0] * e.x;
+    const glm::vec4 ay = viewProjection_[1] * e.y;
+    const glm::vec4 az = viewProjection_[2] * e.z;
+
+    const float fw = static_cast<float>(width_);
+    const float fh = static_cast<float>(height_);
+    float minX = fw, maxX = 0.f, minY = fh, maxY = 0.f;
+    float nearest = 0.f;   // largest 1/w of the box
+    for (int i = 0; i < 8; ++i) {
+        const glm::vec4 p = c + ((i & 1) ? ax : -ax) + ((i & 2) ? ay : -ay) + ((i & 4) ? az : -az);
+        if (p.z < 0.f || p.w <= 0.f) return false;   // crosses the near plane
+
+        const ScreenVertex s = ToScreen(p, fw, fh);
+        minX = std::min(minX, s.x); maxX = std::max(maxX, s.x);
+        minY = std::min(minY, s.y); maxY = std::max(maxY, s.y);
+        nearest = std::max(nearest, s.invW);
+    }
+    if (maxX < 0.f || maxY < 0.f || minX >= fw || minY >= fh) return false;   // off screen
+
+    // Pixels the rectangle touches, then the level where they span <= 2x2.
+    const auto x0 = static_cast<std::uint32_t>(std::max(0.f, minX));
+    const auto y0 = static_cast<std::uint32_t>(std::max(0.f, minY));
+    const auto x1 = static_cast<std::uint32_t>(std::min(fw - 1.f, maxX));
+    const auto y1 = static_cast<std::uint32_t>(std::min(fh - 1.f, maxY));
+
+    std::size_t l = 0;
+    while ((x1 >> l) - (x0 >> l) > 1 || (y1 >> l) - (y0 >> l) > 1) ++l;
+
+    const Level& level = levels_[l];
+    const float* texels = pyramid_.data() + level.offset;
+    const float  limit  = nearest * (1.f + kDepthBias);
+    for (std::uint32_t y = y0 >> l; y <= (y1 >> l); ++y)
+        for (std::uint32_t x = x0 >> l; x <= (x1 >> l); ++x)
+            if (!(limit < texels[static_cast<std::size_t>(y) * level.width + x])) return false;
+    return true;
+}
+
+} // namespace engine
@@ -0,0 +1,128 @@
+#pragma once
+
+#include <core/Geometry.hpp>
+#include <glm/mat4x4.hpp>
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace engine {
+
+namespace detail {
+
+// One occluder triangle after setup: three edge functions a*x + b*y + c,
+// each >= 0 inside, and the 1/w plane, all in pixel coordinates, plus its
+// pixel bounding box clamped to the buffer.
+struct OcclusionTriangle {
+    float edgeA[3], edgeB[3], edgeC[3];
+    float depthA, depthB, depthC;
+    std::int32_t minX, maxX, minY, maxY;
+};
+
+} // namespace detail
+
+// ─── OcclusionBuffer ──────────────────────────────────────────────────────────
+// Software hierarchical-Z occlusion culling on the CPU.
+//
+// A handful of occluder meshes are rasterized into a low-resolution buffer
+// holding 1/w (reciprocal view depth) per pixel: it is affine in screen space,
+// so it interpolates exactly across a triangle, and larger means nearer.
+// Pixels are cleared to 0 (infinitely far) and each covered pixel center
+// keeps the nearest occluder.  BuildPyramid then reduces the buffer into a
+// mip chain where every texel holds the minimum — the farthest occluder
+// depth — of the pixels beneath it.
+//
+// A candidate AABB is occluded when its nearest point is farther than the
+// farthest occluder over its whole screen rectangle, read from the one
+// pyramid level where that rectangle spans at most 2x2 texels.  The test is
+// conservative: boxes crossing the near plane, and pixels no occluder
+// covers, always count as visible.  Occluder triangles crossing the near
+// plane are skipped, which can only lose occlusion.
+//
+// Triangle spans are filled 8 (AVX2 + FMA, chosen at run time; see
+// SimdDispatch.hpp) or 4 (SSE2) pixels per step; other targets take the
+// scalar path.
+//
+// Usage each frame:
+//   buffer.Begin(viewProjection);
+//   buffer.RasterizeOccluder(positions, indices, model);   // per occluder
+//   buffer.BuildPyramid();
+//   buffer.IsOccluded(worldBounds);                        // per candidate
+class OcclusionBuffer {
+public:
+    // Width must be a multiple of 8 so SIMD spans never leave a row.
+    static constexpr std::uint32_t kDefaultWidth  = 256;
+    static constexpr std::uint32_t kDefaultHeight = 128;
+
+    explicit OcclusionBuffer(std::uint32_t width  = kDefaultWidth,
+                             std::uint32_t height = kDefaultHeight);
+
+    // Clear the depth buffer and set the view-projection used by both the
+    // occluders and the candidate tests of this frame.
+    void Begin(const glm::mat4& viewProjection);
+
+    // Rasterize an indexed triangle list (local-space positions, three
+    // indices per triangle) transformed by model.  Both windings are drawn.
+    void RasterizeOccluder(std::span<const glm::vec3>     positions,
+                           std::span<const std::uint32_t> indices,
+                           const glm::mat4&               model);
+
+    // Reduce the depth buffer into the min-depth pyramid.  Call after the
+    // last RasterizeOccluder and before IsOccluded.
+    void BuildPyramid();
+
+    // True when the world-space box is certainly hidden behind occluders.
+    bool IsOccluded(const AABB& worldBounds) const;
+
+    std::uint32_t Width()  const { return width_;  }
+    std::uint32_t Height() const { return height_; }
+    std::uint32_t LevelCount() const { return static_cast<std::uint32_t>(levels_.size()); }
+
+    // Occluder triangles rasterized since Begin.
+    std::uint32_t TriangleCount() const { return triangleCount_; }
+
+private:
+    struct Level {
+        std::size_t   offset;   // into pyramid_
+        std::uint32_t width;
+        std::uint32_t height;
+    };
+
+    std::uint32_t      width_;
+    std::uint32_t      height_;
+    glm::mat4          viewProjection_ = glm::mat4(1.f);
+    std::vector<float> pyramid_;    // level 0 (the depth buffer) first
+    std::vector<Level> levels_;
+    std::uint32_t      triangleCount_ = 0;
+
+    // Scratch reused across occluders.
+    std::vector<glm::vec4>                 clip_;
+    std::vector<detail::OcclusionTriangle> tris_;
+};
+
+namespace detail {
+
+// Project a clip-space triangle onto a width x height buffer.  Both windings
+// are accepted.  Returns false, leaving out unspecified, for triangles that
+// cross the near plane or cover no pixel of the buffer.
+bool SetupOcclusionTriangle(const glm::vec4& a, const glm::vec4& b, const glm::vec4& c,
+                            std::uint32_t width, std::uint32_t height,
+                            OcclusionTriangle& out);
+
+// Span-fill kernels, exposed for benchmarks; OcclusionBuffer picks one by
+// ActiveSimdPath().  depth is width * height floats, row-major, width a
+// multiple of 8; each covered pixel center keeps max(depth, 1/w).  The SIMD
+// ones return false when unavailable in this build / CPU.
+void RasterizeOccludersScalar(float* depth, std::uint32_t width,
+                              const OcclusionTriangle* tris, std::size_t count);
+bool RasterizeOccludersSSE2  (float* depth, std::uint32_t width,
+                              const OcclusionTriangle* tris, std::size_t count);
+bool RasterizeOccludersAVX2  (float* depth, std::uint32_t width,
+                              const OcclusionTriangle* tris, std::size_t count);
+
+} // namespace detail
+
+} // namespace engine
@@ -0,0 +1,44 @@
+// Compiled with -mavx2 -mfma (see src/CMakeLists.txt).  Only reached through
+// OcclusionBuffer.cpp's run-time dispatch, so nothing here may be inlined
+// into, or shared with, generic code: intrinsics and the kernel templates only.
+
+#include "OcclusionBuffer.hpp"
+#include "OcclusionRasterKernel.hpp"
+
+#include <immintrin.h>
+
+namespace engine {
+
+namespace {
+
+// ─── AVX2 traits (8 lanes) ────────────────────────────────────────────────────
+struct AVX2 {
+    using V = __m256;
+    static constexpr std::size_t kWidth = 8;
+
+    static V Set1(float f)          { return _mm256_set1_ps(f); }
+    static V Load(const float* p)   { return _mm256_loadu_ps(p); }
+    static void Store(float* p, V v){ _mm256_storeu_ps(p, v); }
+
+    static V Add(V a, V b)          { return _mm256_add_ps(a, b); }
+    static V MulAdd(V a, V b, V c)  { return _mm256_fmadd_ps(a, b, c); }
+    static V Max(V a, V b)          { return _mm256_max_ps(a, b); }
+    static V And(V a, V b)          { return _mm256_and_ps(a, b); }
+    static V CmpGE(V a, V b)        { return _mm256_cmp_ps(a, b, _CMP_GE_OQ); }
+    static int MoveMask(V m)        { return _mm256_movemask_ps(m); }
+};
+
+} // namespace
+
+namespace detail {
+
+bool RasterizeOccludersAVX2(float* depth, std::uint32_t width,
+                            const OcclusionTriangle* tris, std::size_t count)
+{
+    occlusion::RunRasterKernel<AVX2>(depth, width, tris, count);
+    return true;
+}
+
+} // namespace detail
+
+} // namespace engine
@@ -0,0 +1,76 @@
+#pragma once
+
+// Private to core/Math/OcclusionBuffer*.cpp — width-generic occluder span fill.
+//
+// Each SIMD translation unit defines a traits type W (in an anonymous
+// namespace) and instantiates RunRasterKernel<W>.  W provides:
+//
+//   V, kWidth              float vector type, lane count
+//   Set1, Load, Store      broadcast, unaligned load / store
+//   Add                    a + b
+//   MulAdd(a, b, c)        a * b + c
+//   Max                    lane-wise maximum
+//   And(a, b)              bitwise and (lane mask with a mask or a value)
+//   CmpGE(a, b)            all-ones lane mask where a >= b (false for NaN)
+//   MoveMask(m)            lane k's sign bit → bit k of the result
+//
+// Everything here is a template, so instantiations with the AVX2 traits stay
+// inside the AVX2 translation unit and cannot leak into generic code.
+
+#include <core/Math/OcclusionBuffer.hpp>
+#include <cstddef>
+#include <cstdint>
+
+namespace engine::detail::occlusion {
+
+// Lane offsets from the first pixel of a block.
+alignas(32) inline constexpr float kLaneOffset[8] = {0.f, 1.f, 2.f, 3.f, 4.f, 5.f, 6.f, 7.f};
+
+template<typename W>
+inline void RasterTriangle(float* depth, std::uint32_t width, const OcclusionTriangle& t)
+{
+    using V = typename W::V;
+    static_assert(8 % W::kWidth == 0, "blocks must not straddle the row end");
+
+    const V zero = W::Set1(0.f);
+    const V lane = W::Load(kLaneOffset);
+    const V a0 = W::Set1(t.edgeA[0]), a1 = W::Set1(t.edgeA[1]), a2 = W::Set1(t.edgeA[2]);
+    const V za = W::Set1(t.depthA);
+
+    // Blocks start on a kWidth boundary; width is a multiple of 8, so the last
+    // block of a row ends inside it.  Lanes left of minX / right of maxX
+    // fail the edge test like any other pixel outside the triangle.
+    const std::int32_t startX = t.minX & ~static_cast<std::int32_t>(W::kWidth - 1);
+
+    for (std::int32_t y = t.minY; y <= t.maxY; ++y) {
+        const float fy = static_cast<float>(y) + 0.5f;
+        const V r0 = W::Set1(t.edgeB[0] * fy + t.edgeC[0]);
+        const V r1 = W::Set1(t.edgeB[1] * fy + t.edgeC[1]);
+        const V r2 = W::Set1(t.edgeB[2] * fy + t.edgeC[2]);
+        const V rz = W::Set1(t.depthB   * fy + t.depthC);
+        float* row = depth + static_cast<std::size_t>(y) * width;
+
+        for (std::int32_t x = startX; x <= t.maxX; x += static_cast<std::int32_t>(W::kWidth)) {
+            // Evaluated from the row origin, not stepped, so error does not
+            // accumulate across wide triangles.
+            const V px = W::Add(W::Set1(static_cast<float>(x) + 0.5f), lane);
+            const V inside = W::And(W::And(W::CmpGE(W::MulAdd(a0, px, r0), zero),
+                                           W::CmpGE(W::MulAdd(a1, px, r1), zero)),
+                                    W::CmpGE(W::MulAdd(a2, px, r2), zero));
+            if (W::MoveMask(inside) == 0) continue;
+
+            // Masked-off lanes become +0, which never beats a cleared pixel.
+            const V z = W::And(inside, W::MulAdd(za, px, rz));
+            W::Store(row + x, W::Max(W::Load(row + x), z));
+        }
+    }
+}
+
+template<typename W>
+inline void RunRasterKernel(float* depth, std::uint32_t width,
+                            const OcclusionTriangle* tris, std::size_t count)
+{
+    for (std::size_t i = 0; i < count; ++i) RasterTriangle<W>(depth, width, tris[i]);
+}
+
+} // namespace engine::detail::occlusion
@@ -0,0 +1,36 @@
+#include "SimdDispatch.hpp"
+
+namespace engine {
+
+namespace {
+
+SimdPath DetectPath()
+{
+#if defined(ENGINE_SIMD_AVX2) && (defined(__GNUC__) || defined(__clang__))
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) return SimdPath::AVX2;
+#endif
+#if defined(__SSE2__)
+    return SimdPath::SSE2;
+#else
+    return SimdPath::Scalar;
+#endif
+}
+
+} // namespace
+
+SimdPath ActiveSimdPath()
+{
+    static const SimdPath path = DetectPath();
+    return path;
+}
+
+const char* SimdPathName(SimdPath path)
+{
+    switch (path) {
+        case SimdPath::AVX2: return "AVX2";
+        case SimdPath::SSE2: return "SSE2";
+        default:             return "scalar";
+    }
+}
+
+} // namespace engine
@@ -0,0 +1,22 @@
+#pragma once
+
+namespace engine {
+
+// ─── SimdDispatch ─────────────────────────────────────────────────────────────
+// Run-time choice of kernel set for the batched math in core/Math.
+//
+// Kernels come in three flavours: scalar (any target), SSE2 (baseline
+// x86-64, compiled into the generic translation units) and AVX2 + FMA (their
+// own translation units, built with -mavx2 -mfma when ENGINE_SIMD_AVX2 is
+// defined).  The AVX2 kernels may only run on CPUs that have both extensions,
+// so callers branch on ActiveSimdPath() instead of the compile-time ISA.
+enum class SimdPath { Scalar, SSE2, AVX2 };
+
+// Widest kernel set usable by this build on this CPU.  Detected on first call
+// and cached; the CPU does not change under us.
+SimdPath ActiveSimdPath();
+
+// "AVX2", "SSE2" or "scalar".
+const char* SimdPathName(SimdPath path);
+
+} // namespace engine
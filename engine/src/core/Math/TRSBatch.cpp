@@ -0,0 +1,137 @@
+#include "TRSBatch.hpp"
+#include "TRSBatchKernel.hpp"
+#include "SimdDispatch.hpp"
+
+#include <array>
+
+#if defined(__SSE2__)
+#  include <emmintrin.h>
+#endif
+
+namespace engine {
+
+namespace {
+
+#if defined(__SSE2__)
+
+// ─── SSE2 traits (4 lanes) ────────────────────────────────────────────────────
+struct SSE2 {
+    using V = __m128;
+    static constexpr std::size_t kWidth = 4;
+
+    static V Set1(float f)         { return _mm_set1_ps(f); }
+    static V Load(const float* p)  { return _mm_loadu_ps(p); }
+
+    static V Add(V a, V b)         { return _mm_add_ps(a, b); }
+    static V Sub(V a, V b)         { return _mm_sub_ps(a, b); }
+    static V Mul(V a, V b)         { return _mm_mul_ps(a, b); }
+    static V Div(V a, V b)         { return _mm_div_ps(a, b); }
+    static V MulAdd(V a, V b, V c) { return _mm_add_ps(_mm_mul_ps(a, b), c); }
+
+    static void Store4(V r0, V r1, V r2, V r3, float* const* dst, std::size_t off)
+    {
+        _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+        _mm_storeu_ps(dst[0] + off, r0);
+        _mm_storeu_ps(dst[1] + off, r1);
+        _mm_storeu_ps(dst[2] + off, r2);
+        _mm_storeu_ps(dst[3] + off, r3);
+    }
+};
+
+#endif // __SSE2__
+
+void RunScalar(const TRSBatchInput& in, float* const* out, std::size_t begin, std::size_t end)
+{
+    for (std::size_t i = begin; i < end; ++i) {
+        const glm::mat4 m = BuildTRSMatrix({in.posX[i], in.posY[i], in.posZ[i]},
+                                           glm::quat(in.rotW[i], in.rotX[i], in.rotY[i], in.rotZ[i]),
+                                           {in.scaleX[i], in.scaleY[i], in.scaleZ[i]});
+        float* dst = out[i];
+        for (int c = 0; c < 4; ++c)
+            for (int r = 0; r < 4; ++r) dst[c * 4 + r] = m[c][r];
+    }
+}
+
+} // namespace
+
+// ─── Kernels ──────────────────────────────────────────────────────────────────
+
+namespace detail {
+
+void BuildTRSMatricesScalar(const TRSBatchInput& in, float* const* out, std::size_t count)
+{
+    RunScalar(in, out, 0, count);
+}
+
+bool BuildTRSMatricesSSE2(const TRSBatchInput& in, float* const* out, std::size_t count)
+{
+#if defined(__SSE2__)
+    const std::size_t done = trs::RunTRSKernel<SSE2>(in, out, count);
+    RunScalar(in, out, done, count);
+    return true;
+#else
+    (void)in; (void)out; (void)count;
+    return false;
+#endif
+}
+
+#if !defined(ENGINE_SIMD_AVX2)
+// Without the AVX2 translation unit (non-x86 targets) the kernel is absent.
+bool BuildTRSMatricesAVX2(const TRSBatchInput&, float* const*, std::size_t)
+{
+    return false;
+}
+#endif
+
+} // namespace detail
+
+// ─── Public API ───────────────────────────────────────────────────────────────
+
+glm::mat4 BuildTRSMatrix(const glm::vec3& position,
+                         const glm::quat& rotation,
+                         const glm::vec3& scale)
+{
+    const float x = rotation.x, y = rotation.y, z = rotation.z, w = rotation.w;
+    const float s  = 2.f / (x * x + y * y + z * z + w * w);
+    const float xs = x * s, ys = y * s, zs = z * s;
+    const float xx = x * xs, xy = x * ys, xz = x * zs;
+    const float yy = y * ys, yz = y * zs, zz = z * zs;
+    const float wx = w * xs, wy = w * ys, wz = w * zs;
+
+    glm::mat4 m(1.f);
+    m[0] = glm::vec4(1.f - (yy + zz), xy + wz,         xz - wy,         0.f) * scale.x;
+    m[1] = glm::vec4(xy - wz,         1.f - (xx + zz), yz + wx,         0.f) * scale.y;
+    m[2] = glm::vec4(xz + wy,         yz - wx,         1.f - (xx + yy), 0.f) * scale.z;
+    m[3] = glm::vec4(position, 1.f);
+    return m;
+}
+
+void BuildTRSMatrices(const TRSBatchInput& in, glm::mat4* const* out, std::size_t count)
+{
+    // glm::mat4 is 16 contiguous floats, column-major.
+    float* const* dst = reinterpret_cast<float* const*>(out);
+    switch (ActiveSimdPath()) {
+        case SimdPath::AVX2: detail::BuildTRSMatricesAVX2(in, dst, count); break;
+        case SimdPath::SSE2: detail::BuildTRSMatricesSSE2(in, dst, count); break;
+        default:             detail::BuildTRSMatricesScalar(in, dst, count); break;
+    }
+}
+
+void BuildTRSMatrices(const TRSBatchInput& in, glm::mat4* out, std::size_t count)
+{
+    constexpr std::size_t kChunk = 64;
+    std::array<glm::mat4*, kChunk> ptrs;
+
+    for (std::size_t base = 0; base < count; base += kChunk) {
+        const std::size_t n = (count - base < kChunk) ? count - base : kChunk;
+        for (std::size_t i = 0; i < n; ++i) ptrs[i] = out + base + i;
+
+        const TRSBatchInput chunk{
+            in.posX   + base, in.posY   + base, in.posZ + base,
+            in.rotX   + base, in.rotY   + base, in.rotZ + base, in.rotW + base,
+            in.scaleX + base, in.scaleY + base, in.scaleZ + base};
+        BuildTRSMatrices(chunk, ptrs.data(), n);
+    }
+}
+
+} // namespace engine
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <glm/mat4x4.hpp>
+#include <glm/vec3.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include <cstddef>
+
+namespace engine {
+
+// ─── TRSBatch ─────────────────────────────────────────────────────────────────
+// Batched construction of T * R * S matrices — the TransformComponent
+// convention — from SoA position / quaternion / scale inputs.
+//
+// The rotation block is written in closed form from the quaternion (a dozen
+// products, no trigonometry) and scaled per column, instead of multiplying
+// 4x4 matrices.  On x86-64 the SIMD kernels evaluate 8 (AVX2 + FMA, chosen at
+// run time when the CPU supports it; see SimdDispatch.hpp) or 4 (SSE2)
+// transforms per iteration; other targets, and the tail of every batch, take
+// the scalar path.
+//
+// Quaternions need not be exactly unit length: the rotation is normalised by
+// |q|^2 on the way, so accumulated drift does not turn into skew.
+
+// SoA input: element i of every array describes transform i.
+struct TRSBatchInput {
+    const float* posX;
+    const float* posY;
+    const float* posZ;
+    const float* rotX;     // quaternion (x, y, z, w)
+    const float* rotY;
+    const float* rotZ;
+    const float* rotW;
+    const float* scaleX;
+    const float* scaleY;
+    const float* scaleZ;
+};
+
+// out[i] = TRS(i) for i in [0, count).  Matrices may live anywhere (e.g. inside
+// components), hence one destination pointer per transform.
+void BuildTRSMatrices(const TRSBatchInput& in, glm::mat4* const* out, std::size_t count);
+
+// Contiguous-output convenience overload.
+void BuildTRSMatrices(const TRSBatchInput& in, glm::mat4* out, std::size_t count);
+
+// Single transform, scalar closed form.
+glm::mat4 BuildTRSMatrix(const glm::vec3& position,
+                         const glm::quat& rotation,
+                         const glm::vec3& scale);
+
+namespace detail {
+
+// Individual kernels, exposed for benchmarks; BuildTRSMatrices picks one by
+// ActiveSimdPath().  Each handles any count (tails included); the SIMD ones
+// return false when unavailable in this build / CPU.
+void BuildTRSMatricesScalar(const TRSBatchInput& in, float* const* out, std::size_t count);
+bool BuildTRSMatricesSSE2  (const TRSBatchInput& in, float* const* out, std::size_t count);
+bool BuildTRSMatricesAVX2  (const TRSBatchInput& in, float* const* out, std::size_t count);
+
+} // namespace detail
+
+} // namespace engine
@@ -0,0 +1,72 @@
+// Compiled with -mavx2 -mfma (see src/CMakeLists.txt).  Only reached through
+// TRSBatch.cpp's run-time dispatch, so nothing here may be inlined into, or
+// shared with, generic code: intrinsics and the kernel templates only.
+
+#include "TRSBatch.hpp"
+#include "TRSBatchKernel.hpp"
+
+#include <immintrin.h>
+
+namespace engine {
+
+namespace {
+
+// ─── AVX2 traits (8 lanes) ────────────────────────────────────────────────────
+struct AVX2 {
+    using V = __m256;
+    static constexpr std::size_t kWidth = 8;
+
+    static V Set1(float f)         { return _mm256_set1_ps(f); }
+    static V Load(const float* p)  { return _mm256_loadu_ps(p); }
+
+    static V Add(V a, V b)         { return _mm256_add_ps(a, b); }
+    static V Sub(V a, V b)         { return _mm256_sub_ps(a, b); }
+    static V Mul(V a, V b)         { return _mm256_mul_ps(a, b); }
+    static V Div(V a, V b)         { return _mm256_div_ps(a, b); }
+    static V MulAdd(V a, V b, V c) { return _mm256_fmadd_ps(a, b, c); }
+
+    // 4x8 → 8x4 transpose: each 128-bit half holds one lane's 4 floats; the
+    // low halves belong to lanes 0-3, the high halves to lanes 4-7.
+    static void Store4(V r0, V r1, V r2, V r3, float* const* dst, std::size_t off)
+    {
+        const V t0 = _mm256_unpacklo_ps(r0, r1);   // a0 b0 a1 b1 | a4 b4 a5 b5
+        const V t1 = _mm256_unpackhi_ps(r0, r1);   // a2 b2 a3 b3 | a6 b6 a7 b7
+        const V t2 = _mm256_unpacklo_ps(r2, r3);
+        const V t3 = _mm256_unpackhi_ps(r2, r3);
+
+        const V l0 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0));   // lanes 0 | 4
+        const V l1 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));   // lanes 1 | 5
+        const V l2 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0));   // lanes 2 | 6
+        const V l3 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));   // lanes 3 | 7
+
+        _mm_storeu_ps(dst[0] + off, _mm256_castps256_ps128(l0));
+        _mm_storeu_ps(dst[1] + off, _mm256_castps256_ps128(l1));
+        _mm_storeu_ps(dst[2] + off, _mm256_castps256_ps128(l2));
+        _mm_storeu_ps(dst[3] + off, _mm256_castps256_ps128(l3));
+        _mm_storeu_ps(dst[4] + off, _mm256_extractf128_ps(l0, 1));
+        _mm_storeu_ps(dst[5] + off, _mm256_extractf128_ps(l1, 1));
+        _mm_storeu_ps(dst[6] + off, _mm256_extractf128_ps(l2, 1));
+        _mm_storeu_ps(dst[7] + off, _mm256_extractf128_ps(l3, 1));
+    }
+};
+
+} // namespace
+
+namespace detail {
+
+bool BuildTRSMatricesAVX2(const TRSBatchInput& in, float* const* out, std::size_t count)
+{
+    const std::size_t done = trs::RunTRSKernel<AVX2>(in, out, count);
+    if (done < count) {
+        const TRSBatchInput tail{
+            in.posX   + done, in.posY   + done, in.posZ + done,
+            in.rotX   + done, in.rotY   + done, in.rotZ + done, in.rotW + done,
+            in.scaleX + done, in.scaleY + done, in.scaleZ + done};
+        BuildTRSMatricesScalar(tail, out + done, count - done);
+    }
+    return true;
+}
+
+} // namespace detail
+
+} // namespace engine
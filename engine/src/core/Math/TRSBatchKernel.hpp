@@ -0,0 +1,75 @@
+#pragma once
+
+// Private to core/Math/TRSBatch*.cpp — width-generic TRS kernel.
+//
+// Each SIMD translation unit defines a traits type W (in an anonymous
+// namespace) and instantiates RunTRSKernel<W>.  W provides:
+//
+//   V, kWidth                          float vector type, lane count
+//   Set1, Load                         broadcast, unaligned load
+//   Add, Sub, Mul, Div                 arithmetic
+//   MulAdd(a, b, c)                    a * b + c
+//   Store4(r0, r1, r2, r3, dst, off)   lane k → dst[k][off .. off + 3]
+//
+// Everything here is a template, so instantiations with the AVX2 traits stay
+// inside the AVX2 translation unit and cannot leak into generic code.
+
+#include <core/Math/TRSBatch.hpp>
+#include <cstddef>
+
+namespace engine::detail::trs {
+
+// Matrices [i, i + kWidth).
+template<typename W>
+inline void BuildBlock(const TRSBatchInput& in, std::size_t i, float* const* out)
+{
+    using V = typename W::V;
+
+    const V x = W::Load(in.rotX + i);
+    const V y = W::Load(in.rotY + i);
+    const V z = W::Load(in.rotZ + i);
+    const V w = W::Load(in.rotW + i);
+
+    // s = 2 / |q|^2 folds normalisation into the usual 2 * (...) terms.
+    const V n  = W::MulAdd(x, x, W::MulAdd(y, y, W::MulAdd(z, z, W::Mul(w, w))));
+    const V s  = W::Div(W::Set1(2.f), n);
+    const V xs = W::Mul(x, s), ys = W::Mul(y, s), zs = W::Mul(z, s);
+
+    const V xx = W::Mul(x, xs), xy = W::Mul(x, ys), xz = W::Mul(x, zs);
+    const V yy = W::Mul(y, ys), yz = W::Mul(y, zs), zz = W::Mul(z, zs);
+    const V wx = W::Mul(w, xs), wy = W::Mul(w, ys), wz = W::Mul(w, zs);
+
+    const V one  = W::Set1(1.f);
+    const V zero = W::Set1(0.f);
+    const V kx   = W::Load(in.scaleX + i);
+    const V ky   = W::Load(in.scaleY + i);
+    const V kz   = W::Load(in.scaleZ + i);
+
+    // Column-major, as glm stores it; rotation columns scaled by S.
+    W::Store4(W::Mul(W::Sub(one, W::Add(yy, zz)), kx),
+              W::Mul(W::Add(xy, wz), kx),
+              W::Mul(W::Sub(xz, wy), kx),
+              zero, out, 0);
+    W::Store4(W::Mul(W::Sub(xy, wz), ky),
+              W::Mul(W::Sub(one, W::Add(xx, zz)), ky),
+              W::Mul(W::Add(yz, wx), ky),
+              zero, out, 4);
+    W::Store4(W::Mul(W::Add(xz, wy), kz),
+              W::Mul(W::Sub(yz, wx), kz),
+              W::Mul(W::Sub(one, W::Add(xx, yy)), kz),
+              zero, out, 8);
+    W::Store4(W::Load(in.posX + i), W::Load(in.posY + i), W::Load(in.posZ + i),
+              one, out, 12);
+}
+
+// Process the largest multiple of kWidth; returns how many were written.
+template<typename W>
+inline std::size_t RunTRSKernel(const TRSBatchInput& in, float* const* out, std::size_t count)
+{
+    std::size_t i = 0;
+    for (; i + W::kWidth <= count; i += W::kWidth)
+        BuildBlock<W>(in, i, out + i);
+    return i;
+}
+
+} // namespace engine::detail::trs
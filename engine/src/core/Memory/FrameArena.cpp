@@ -0,0 +1,54 @@
+#include <core/Memory/FrameArena.hpp>
+
+#include <core/Assert.hpp>
+#include <algorithm>
+#include <climits>
+
+namespace engine {
+
+FrameArena::FrameArena(std::size_t capacity)
+{
+    // Every growth at least doubles the capacity, so a frame retires fewer
+    // allocators than a size_t has bits; with room for that many reserved,
+    // retiring one never touches the heap.
+    for (Buffer& buffer : buffers_) {
+        buffer.allocator = std::make_unique<LinearAllocator>(capacity);
+        buffer.retired.reserve(sizeof(std::size_t) * CHAR_BIT);
+        heapAllocations_ += 2;
+    }
+}
+
+void* FrameArena::Allocate(std::size_t size, std::size_t alignment)
+{
+    Buffer& buffer = buffers_[current_];
+    if (void* p = buffer.allocator->Allocate(size, alignment)) return p;
+
+    // Out of room: earlier allocations this frame must stay put, so retire
+    // the allocator rather than reset it, and continue in a larger one.
+    const std::size_t capacity = std::max(buffer.allocator->Capacity() * 2, (size + alignment) * 2);
+    buffer.retired.push_back(std::move(buffer.allocator));
+    buffer.allocator = std::make_unique<LinearAllocator>(capacity);
+    ++heapAllocations_;
+
+    void* p = buffer.allocator->Allocate(size, alignment);
+    ENGINE_ASSERT(p != nullptr, "FrameArena: allocation larger than a fresh buffer");
+    return p;
+}
+
+std::size_t FrameArena::Used() const
+{
+    const Buffer& buffer = buffers_[current_];
+    std::size_t used = buffer.allocator->Used();
+    for (const auto& retired : buffer.retired) used += retired->Used();
+    return used;
+}
+
+void FrameArena::NextFrame()
+{
+    current_ ^= 1u;
+    Buffer& buffer = buffers_[current_];
+    buffer.retired.clear();
+    buffer.allocator->Reset();
+}
+
+} // namespace engine
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <core/Memory/LinearAllocator.hpp>
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+namespace engine {
+
+// ─── FrameArena ───────────────────────────────────────────────────────────────
+// Double-buffered per-frame memory: two LinearAllocators used on alternating
+// frames.  NextFrame switches to the other one and resets it, so what was
+// allocated during a frame stays valid through the following frame and is
+// reclaimed wholesale the frame after, with no per-allocation bookkeeping.
+//
+// Allocate never fails.  When the current allocator runs out, a larger one
+// (at least twice the size) takes over for the rest of the frame and the old
+// one is kept alive until its memory may no longer be referenced, so frames
+// only touch the heap until the arenas have grown to the working set.
+// HeapAllocations counts those growths.
+//
+// Memory is raw: only trivially destructible types belong here.
+class FrameArena {
+public:
+    explicit FrameArena(std::size_t capacity);
+
+    FrameArena(const FrameArena&)            = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    void* Allocate(std::size_t size, std::size_t alignment = alignof(std::max_align_t));
+
+    template<typename T>
+    T* AllocateArray(std::size_t count)
+    {
+        return static_cast<T*>(Allocate(count * sizeof(T), alignof(T)));
+    }
+
+    // Switch to the other buffer and reset it.
+    void NextFrame();
+
+    // Heap allocations made since construction, initial buffers and their
+    // retired lists included.
+    std::size_t HeapAllocations() const { return heapAllocations_; }
+
+    // Bytes handed out this frame, from the current buffer and from those
+    // it outgrew.
+    std::size_t Used() const;
+
+private:
+    struct Buffer {
+        std::unique_ptr<LinearAllocator>              allocator;
+        std::vector<std::unique_ptr<LinearAllocator>> retired;   // outgrown this frame
+    };
+
+    std::array<Buffer, 2> buffers_;
+    std::uint32_t         current_         = 0;
+    std::size_t           heapAllocations_ = 0;
+};
+
+// ─── FrameArray ───────────────────────────────────────────────────────────────
+// Growable array in a FrameArena.  Growing copies into a block twice the size
+// and leaves the old one to be reclaimed with the frame; Reset with last
+// frame's size as the capacity and a steady frame never grows.
+template<typename T>
+class FrameArray {
+    static_assert(std::is_trivially_copyable_v<T> && std::is_trivially_destructible_v<T>,
+                  "FrameArray: memory is reclaimed without running destructors");
+
+public:
+    // Empty the array and reserve capacity elements from arena.  Contents
+    // from before are left to the arena.
+    void Reset(FrameArena& arena, std::uint32_t capacity)
+    {
+        data_     = capacity > 0 ? arena.AllocateArray<T>(capacity) : nullptr;
+        size_     = 0;
+        capacity_ = capacity;
+    }
+
+    // Append value; returns its index.
+    std::uint32_t Push(FrameArena& arena, const T& value)
+    {
+        if (size_ == capacity_) Grow(arena, size_ + 1);
+        std::construct_at(data_ + size_, value);
+        return size_++;
+    }
+
+    // Set the size to size; added elements are uninitialized, for the
+    // caller to fill in.
+    void Resize(FrameArena& arena, std::uint32_t size)
+    {
+        if (size > capacity_) Grow(arena, size);
+        size_ = size;
+    }
+
+    T&       operator[](std::uint32_t i)       { return data_[i]; }
+    const T& operator[](std::uint32_t i) const { return data_[i]; }
+
+    std::uint32_t size()  const { return size_; }
+    bool          empty() const { return size_ == 0; }
+
+    std::span<T>       Span()       { return {data_, size_}; }
+    std::span<const T> Span() const { return {data_, size_}; }
+
+private:
+    void Grow(FrameArena& arena, std::uint32_t minCapacity)
+    {
+        constexpr std::uint32_t kMinCapacity = 64;
+        const std::uint32_t capacity = std::max({capacity_ * 2, minCapacity, kMinCapacity});
+        T* data = arena.AllocateArray<T>(capacity);
+        if (size_ > 0) std::memcpy(data, data_, std::size_t{size_} * sizeof(T));
+        data_     = data;
+        capacity_ = capacity;
+    }
+
+    T*            data_     = nullptr;
+    std::uint32_t size_     = 0;
+    std::uint32_t capacity_ = 0;
+};
+
+} // namespace engine
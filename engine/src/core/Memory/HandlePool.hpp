@@ -76,6 +76,17 @@ public:
 
     std::size_t Size() const { return slots_.size() - freeList_.size(); }
 
+    // One past the highest slot index handed out so far.
+    std::uint32_t SlotCount() const { return static_cast<std::uint32_t>(slots_.size()); }
+
+    // Call fn(index, value) for every occupied slot, in index order.
+    template<typename F>
+    void ForEach(F&& fn) const
+    {
+        for (std::uint32_t i = 0; i < slots_.size(); ++i)
+            if (slots_[i].occupied) fn(i, slots_[i].value);
+    }
+
 private:
     struct Slot {
         T            value;
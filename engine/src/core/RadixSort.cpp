@@ -0,0 +1,66 @@
+#include <core/RadixSort.hpp>
+#include <core/Assert.hpp>
+
+#include <array>
+#include <cstddef>
+#include <utility>
+
+namespace engine {
+
+namespace {
+
+constexpr int         kPasses  = 8;
+constexpr std::size_t kBuckets = 256;
+
+// Below this many entries an insertion sort beats eight histogram passes.
+constexpr std::size_t kInsertionSortMax = 32;
+
+void InsertionSort(std::span<SortKey> entries)
+{
+    for (std::size_t i = 1; i < entries.size(); ++i) {
+        const SortKey entry = entries[i];
+        std::size_t j = i;
+        for (; j > 0 && entries[j - 1].key > entry.key; --j) entries[j] = entries[j - 1];
+        entries[j] = entry;
+    }
+}
+
+} // namespace
+
+std::span<SortKey> RadixSort(std::span<SortKey> entries, std::span<SortKey> scratch)
+{
+    const std::size_t n = entries.size();
+    if (n <= kInsertionSortMax) {
+        InsertionSort(entries);
+        return entries;
+    }
+    ENGINE_ASSERT(scratch.size() >= n, "RadixSort: scratch smaller than entries");
+
+    // All eight histograms in one read of the keys.
+    std::array<std::array<std::uint32_t, kBuckets>, kPasses> counts{};
+    for (const SortKey& e : entries)
+        for (int pass = 0; pass < kPasses; ++pass)
+            ++counts[pass][(e.key >> (pass * 8)) & 0xFFu];
+
+    std::span<SortKey> src = entries;
+    std::span<SortKey> dst = scratch.first(n);
+    for (int pass = 0; pass < kPasses; ++pass) {
+        std::array<std::uint32_t, kBuckets>& count = counts[pass];
+        const int shift = pass * 8;
+
+        // Every key has the same byte here: the pass would be a plain copy.
+        if (count[(src[0].key >> shift) & 0xFFu] == n) continue;
+
+        std::uint32_t offset = 0;
+        for (std::uint32_t& c : count) {
+            const std::uint32_t bucket = c;
+            c       = offset;
+            offset += bucket;
+        }
+        for (const SortKey& e : src) dst[count[(e.key >> shift) & 0xFFu]++] = e;
+        std::swap(src, dst);
+    }
+    return src;
+}
+
+} // namespace engine
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+
+namespace engine {
+
+// ─── RadixSort ────────────────────────────────────────────────────────────────
+// LSD radix sort of (64-bit key, 32-bit index) pairs, one byte per pass.
+//
+// Sorting small key+index records instead of the objects they describe keeps
+// every pass to 16-byte moves, and the sort is stable, so records with equal
+// keys keep their submission order.  A pass whose byte is the same in every
+// key is skipped after its histogram: keys built from a few narrow fields
+// (see RenderQueue) typically need well under the full eight passes.  Works
+// on caller-provided storage and never allocates.
+
+struct SortKey {
+    std::uint64_t key   = 0;
+    std::uint32_t index = 0;
+};
+
+// Sort entries by key, ascending, ping-ponging between entries and scratch
+// (at least as large; its contents are overwritten).  Returns the span that
+// holds the result: entries, or the matching prefix of scratch.
+std::span<SortKey> RadixSort(std::span<SortKey> entries, std::span<SortKey> scratch);
+
+} // namespace engine
@@ -42,14 +42,15 @@ Window::Window(int width, int height, std::string_view title)
     const int ok = glfwInit();
     ENGINE_ASSERT(ok, "glfwInit() failed");
 
-    // OpenGL context hints ─ macOS caps at 4.1; other platforms use 4.6.
+    // OpenGL context hints ─ macOS caps at 4.1; other platforms ask for 4.6
+    // and step down to 4.5 / 4.3 for drivers that stop short of it (Mesa
+    // llvmpipe reports 4.5).  GpuCulling needs 4.3; below that the renderer
+    // keeps to its GL 4.1 feature set.
 #ifdef __APPLE__
-    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
-    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 1);
+    static constexpr int kMinorVersions[] = {1};
     glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GLFW_TRUE);
 #else
-    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
-    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 6);
+    static constexpr int kMinorVersions[] = {6, 5, 3, 1};
 #endif
     glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
     glfwWindowHint(GLFW_RESIZABLE,      GLFW_TRUE);
@@ -58,7 +59,13 @@ Window::Window(int width, int height, std::string_view title)
     glfwWindowHint(GLFW_OPENGL_DEBUG_CONTEXT, GLFW_TRUE);
 #endif
 
-    window_ = glfwCreateWindow(width, height, title.data(), nullptr, nullptr);
+    for (const int minor : kMinorVersions) {
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, minor);
+        window_ = glfwCreateWindow(width, height, title.data(), nullptr, nullptr);
+        if (window_) break;
+        LOG_WARN("OpenGL 4.{} context unavailable", minor);
+    }
     if (!window_) {
         glfwTerminate();
         LOG_FATAL("glfwCreateWindow failed");
@@ -7,6 +7,13 @@
 
 #include <stdexcept>
 
+// GL_COMPUTE_SHADER is core in 4.3; macOS tops out at 4.1.  Define the
+// constant so compute programs compile everywhere — on a 4.1 context the
+// stage simply fails to compile and FromComputeFile returns an invalid shader.
+#ifndef GL_COMPUTE_SHADER
+#  define GL_COMPUTE_SHADER 0x91B9u
+#endif
+
 namespace engine {
 
 // ─── Factory ──────────────────────────────────────────────────────────────────
@@ -27,6 +34,18 @@ Shader Shader::FromFiles(const std::filesystem::path& vert,
     return s;
 }
 
+Shader Shader::FromComputeFile(const std::filesystem::path& comp)
+{
+    Shader s;
+    s.compPath_ = comp;
+
+    if (!s.Reload()) {
+        LOG_ERROR("Shader::FromComputeFile — initial compilation failed for '{}'",
+                  comp.string());
+    }
+    return s;
+}
+
 // ─── Lifecycle ────────────────────────────────────────────────────────────────
 
 Shader::~Shader()
@@ -39,6 +58,7 @@ Shader::Shader(Shader&& other) noexcept
     , vertPath_(std::move(other.vertPath_))
     , fragPath_(std::move(other.fragPath_))
     , geomPath_(std::move(other.geomPath_))
+    , compPath_(std::move(other.compPath_))
     , deps_    (std::move(other.deps_))
 {
     other.id_ = 0;
@@ -52,6 +72,7 @@ Shader& Shader::operator=(Shader&& other) noexcept
         vertPath_ = std::move(other.vertPath_);
         fragPath_ = std::move(other.fragPath_);
         geomPath_ = std::move(other.geomPath_);
+        compPath_ = std::move(other.compPath_);
         deps_     = std::move(other.deps_);
         other.id_ = 0;
     }
@@ -62,6 +83,8 @@ Shader& Shader::operator=(Shader&& other) noexcept
 
 bool Shader::Reload()
 {
+    if (!compPath_.empty()) return ReloadCompute();
+
     std::vector<std::filesystem::path> newDeps;
 
     auto processWith = [&](const std::filesystem::path& path) -> std::string {
@@ -102,7 +125,7 @@ bool Shader::Reload()
         }
     }
 
-    const std::uint32_t newProg = LinkProgram(vertObj, fragObj, geomObj);
+    const std::uint32_t newProg = LinkProgram({vertObj, fragObj, geomObj});
     glDeleteShader(vertObj);
     glDeleteShader(fragObj);
     if (geomObj) glDeleteShader(geomObj);
@@ -118,6 +141,31 @@ bool Shader::Reload()
     return true;
 }
 
+bool Shader::ReloadCompute()
+{
+    ShaderProcessResult result;
+    try {
+        result = ShaderPreprocessor::Process(compPath_);
+    } catch (const std::exception& e) {
+        LOG_ERROR("Shader::Reload — compute preprocessor error: {}", e.what());
+        return false;
+    }
+
+    const std::uint32_t compObj = CompileStage(GL_COMPUTE_SHADER, result.source);
+    if (!compObj) return false;
+
+    const std::uint32_t newProg = LinkProgram({compObj});
+    glDeleteShader(compObj);
+    if (!newProg) return false;
+
+    if (id_) glDeleteProgram(id_);
+    id_   = newProg;
+    deps_ = std::move(result.dependencies);
+
+    LOG_TRACE("Shader reloaded (prog={}): {}", id_, compPath_.filename().string());
+    return true;
+}
+
 // ─── Bind / uniforms ──────────────────────────────────────────────────────────
 
 void Shader::Bind() const { glUseProgram(id_); }
@@ -155,13 +203,11 @@ std::uint32_t Shader::CompileStage(std::uint32_t glType, const std::string& src)
     return obj;
 }
 
-std::uint32_t Shader::LinkProgram(std::uint32_t vert, std::uint32_t frag,
-                                   std::uint32_t geom)
+std::uint32_t Shader::LinkProgram(std::initializer_list<std::uint32_t> stages)
 {
     const std::uint32_t prog = glCreateProgram();
-    glAttachShader(prog, vert);
-    glAttachShader(prog, frag);
-    if (geom) glAttachShader(prog, geom);
+    for (const std::uint32_t stage : stages)
+        if (stage) glAttachShader(prog, stage);
     glLinkProgram(prog);
 
     int success = 0;
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <filesystem>
+#include <initializer_list>
 #include <string_view>
 #include <vector>
 #include <cstdint>
@@ -19,6 +20,10 @@ public:
                             const std::filesystem::path& frag,
                             const std::filesystem::path& geom = {});
 
+    // Build a compute program from a single source file (GL 4.3+; check
+    // IsValid on drivers that may lack compute shaders).
+    static Shader FromComputeFile(const std::filesystem::path& comp);
+
     ~Shader();
 
     Shader(const Shader&)            = delete;
@@ -48,6 +53,7 @@ public:
     const std::filesystem::path& VertPath() const { return vertPath_; }
     const std::filesystem::path& FragPath() const { return fragPath_; }
     const std::filesystem::path& GeomPath() const { return geomPath_; }
+    const std::filesystem::path& CompPath() const { return compPath_; }
 
     // All .glsl files read during the last successful compile (main + includes).
     // Updated by Reload(); used by ResourceManager::PollShaderReload.
@@ -60,17 +66,20 @@ private:
     std::filesystem::path vertPath_;
     std::filesystem::path fragPath_;
     std::filesystem::path geomPath_;
+    std::filesystem::path compPath_;   // non-empty for compute programs
     std::vector<std::filesystem::path> deps_;
 
     // Compile one shader stage from preprocessed source.
     // Returns 0 on failure (error is logged).
     std::uint32_t CompileStage(std::uint32_t glType, const std::string& src) const;
 
-    // Link compiled stages into a program.
-    // Deletes the stage objects regardless of success.
+    // Recompile a compute program from compPath_; same contract as Reload.
+    bool ReloadCompute();
+
+    // Link compiled stages into a program; zero entries are skipped.
+    // The caller still owns (and deletes) the stage objects.
     // Returns 0 on failure.
-    static std::uint32_t LinkProgram(std::uint32_t vert, std::uint32_t frag,
-                                     std::uint32_t geom = 0);
+    static std::uint32_t LinkProgram(std::initializer_list<std::uint32_t> stages);
 
     // Fetch a uniform location (cached implicitly by the GL driver).
     int UniformLocation(std::string_view name) const;
@@ -0,0 +1,199 @@
+#include "StreamBuffer.hpp"
+#include <core/Assert.hpp>
+#include <core/Log.hpp>
+#include <glad/gl.h>
+#include <cstring>
+
+// See Buffer.cpp: storage buffers are only streamed on GL 4.3 contexts.
+#ifndef GL_SHADER_STORAGE_BUFFER
+#  define GL_SHADER_STORAGE_BUFFER 0x90D2u
+#endif
+
+namespace engine {
+
+namespace {
+
+// Region starts stay aligned for any offset alignment a driver reports for
+// uniform and storage buffers, and for whole InstanceData records.
+constexpr std::size_t kRegionAlignment = 256;
+
+constexpr GLuint64 kWaitTimeoutNs = 1'000'000;   // re-poll every millisecond
+
+std::size_t AlignUp(std::size_t value, std::size_t alignment)
+{
+    return (value + alignment - 1u) & ~(alignment - 1u);
+}
+
+GLenum ToGLTarget(BufferTarget t) noexcept
+{
+    switch (t) {
+        case BufferTarget::Vertex:        return GL_ARRAY_BUFFER;
+        case BufferTarget::Index:         return GL_ELEMENT_ARRAY_BUFFER;
+        case BufferTarget::Uniform:       return GL_UNIFORM_BUFFER;
+        case BufferTarget::ShaderStorage: return GL_SHADER_STORAGE_BUFFER;
+    }
+    return GL_ARRAY_BUFFER;
+}
+
+} // namespace
+
+// ─── StreamBuffer ────────────────────────────────────────────────────────────
+
+StreamBuffer::StreamBuffer(BufferTarget target, std::size_t regionSize)
+    : target_(target)
+{
+#if defined(GL_VERSION_4_4)
+    persistent_ = GLAD_GL_VERSION_4_4 != 0;
+#endif
+    Create(AlignUp(regionSize, kRegionAlignment));
+}
+
+StreamBuffer::~StreamBuffer()
+{
+    Release();
+    if (!retired_.empty())
+        glDeleteBuffers(static_cast<GLsizei>(retired_.size()), retired_.data());
+}
+
+void StreamBuffer::Create(std::size_t regionSize)
+{
+    regionSize_ = regionSize;
+    region_     = 0;
+    head_       = 0;
+    flushed_    = 0;
+
+    const GLenum target = ToGLTarget(target_);
+    glGenBuffers(1, &id_);
+    glBindBuffer(target, id_);
+#if defined(GL_VERSION_4_4)
+    if (persistent_) {
+        constexpr GLbitfield kFlags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        const auto total = static_cast<GLsizeiptr>(regionSize_ * kRegions);
+        glBufferStorage(target, total, nullptr, kFlags);
+        mapped_ = static_cast<std::byte*>(glMapBufferRange(target, 0, total, kFlags));
+        glBindBuffer(target, 0);
+        if (mapped_) return;
+
+        LOG_WARN("StreamBuffer: persistent map failed, falling back to orphaning");
+        persistent_ = false;
+        glDeleteBuffers(1, &id_);
+        Create(regionSize);
+        return;
+    }
+#endif
+    glBufferData(target, static_cast<GLsizeiptr>(regionSize_), nullptr, GL_STREAM_DRAW);
+    glBindBuffer(target, 0);
+    staging_.resize(regionSize_);
+}
+
+void StreamBuffer::Release()
+{
+    for (void*& fence : fences_) {
+        if (fence) glDeleteSync(static_cast<GLsync>(fence));
+        fence = nullptr;
+    }
+    if (mapped_) {
+        const GLenum target = ToGLTarget(target_);
+        glBindBuffer(target, id_);
+        glUnmapBuffer(target);
+        glBindBuffer(target, 0);
+        mapped_ = nullptr;
+    }
+    if (id_) retired_.push_back(id_);
+    id_ = 0;
+}
+
+void StreamBuffer::BeginFrame()
+{
+    // GL keeps a deleted buffer's storage alive until the GPU is done with it,
+    // so last frame's outgrown buffers only had to outlive its bindings.
+    if (!retired_.empty()) {
+        glDeleteBuffers(static_cast<GLsizei>(retired_.size()), retired_.data());
+        retired_.clear();
+    }
+
+    lastFrameBytes_ = frameBytes_;
+    frameBytes_     = 0;
+    head_           = 0;
+    flushed_        = 0;
+
+    if (persistent_) {
+        fences_[region_] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        region_ = (region_ + 1) % kRegions;
+        if (void* fence = fences_[region_]) {
+            const auto sync = static_cast<GLsync>(fence);
+            while (glClientWaitSync(sync, GL_SYNC_FLUSH_COMMANDS_BIT, kWaitTimeoutNs) == GL_TIMEOUT_EXPIRED) {}
+            glDeleteSync(sync);
+            fences_[region_] = nullptr;
+        }
+    } else if (lastFrameBytes_ > 0) {
+        // Orphan: the driver hands out fresh storage and frees the old once
+        // the GPU has read it.
+        const GLenum target = ToGLTarget(target_);
+        glBindBuffer(target, id_);
+        glBufferData(target, static_cast<GLsizeiptr>(regionSize_), nullptr, GL_STREAM_DRAW);
+        glBindBuffer(target, 0);
+    }
+}
+
+StreamBuffer::Allocation StreamBuffer::Allocate(std::size_t size, std::size_t alignment)
+{
+    ENGINE_ASSERT(alignment > 0 && (alignment & (alignment - 1u)) == 0 &&
+                  alignment <= kRegionAlignment,
+                  "StreamBuffer::Allocate alignment must be a power of two up to 256");
+
+    std::size_t offset = AlignUp(head_, alignment);
+    if (offset + size > regionSize_) {
+        Flush();   // orphan mode: this frame's earlier writes go to the old buffer
+        std::size_t grown = regionSize_ * 2;
+        while (grown < size) grown *= 2;
+        LOG_INFO("StreamBuffer: region grown to {} KiB", grown / 1024);
+        Release();
+        Create(grown);
+        offset = 0;
+    }
+    head_        = offset + size;
+    frameBytes_ += size;
+
+    if (persistent_) {
+        const std::size_t at = region_ * regionSize_ + offset;
+        return {id_, at, mapped_ + at};
+    }
+    return {id_, offset, staging_.data() + offset};
+}
+
+void StreamBuffer::Flush()
+{
+    if (persistent_ || head_ == flushed_) return;
+
+    // Nothing in [flushed_, head_) of this frame's storage has been used by a
+    // draw yet, so the copy need not wait for the GPU.
+    const GLenum     target = ToGLTarget(target_);
+    const auto       offset = static_cast<GLintptr>(flushed_);
+    const auto       length = static_cast<GLsizeiptr>(head_ - flushed_);
+    const std::byte* source = staging_.data() + flushed_;
+    glBindBuffer(target, id_);
+    void* dst = glMapBufferRange(target, offset, length,
+                                 GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT |
+                                 GL_MAP_UNSYNCHRONIZED_BIT);
+    if (dst) {
+        std::memcpy(dst, source, static_cast<std::size_t>(length));
+        glUnmapBuffer(target);
+    } else {
+        glBufferSubData(target, offset, length, source);
+    }
+    glBindBuffer(target, 0);
+    flushed_ = head_;
+}
+
+void StreamBuffer::BindRange(std::uint32_t bindingPoint, const Allocation& allocation,
+                             std::size_t size) const
+{
+    ENGINE_ASSERT(target_ == BufferTarget::Uniform ||
+                  target_ == BufferTarget::ShaderStorage,
+                  "BindRange is only valid for Uniform and ShaderStorage stream buffers");
+    glBindBufferRange(ToGLTarget(target_), bindingPoint, allocation.buffer,
+                      static_cast<GLintptr>(allocation.offset), static_cast<GLsizeiptr>(size));
+}
+
+} // namespace engine
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <renderer/backend/Buffer.hpp>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace engine {
+
+// ─── StreamBuffer ─────────────────────────────────────────────────────────────
+// Ring buffer for data the CPU rewrites every frame (uniform blocks, instance
+// attributes, indirect draws).  Callers Allocate a range, write it through
+// the returned pointer and point GL at (buffer, offset) — glBindBufferRange
+// for uniform and storage blocks, attribute offsets or base instances for
+// vertex data, the indirect offset for draw commands — instead of issuing a
+// glBufferSubData per draw.
+//
+// GL 4.4: one buffer of kRegions regions, created with glBufferStorage and
+// mapped persistent + coherent once.  Each frame writes a region; BeginFrame
+// fences the region just written and waits for the fence of the one it moves
+// to, which the GPU last read kRegions frames ago.
+//
+// GL 4.1 (no buffer storage): a single region orphaned by BeginFrame.  Writes
+// go to CPU staging and Flush copies the new range in with an unsynchronised
+// map — safe, since nothing in the fresh storage has been handed to GL yet.
+//
+// A frame that outgrows its region moves to a larger buffer; the old one is
+// deleted at the next BeginFrame, so allocations made before the move stay
+// valid for the rest of the frame through Allocation::buffer.
+class StreamBuffer {
+public:
+    static constexpr std::uint32_t kRegions = 3;
+
+    struct Allocation {
+        std::uint32_t buffer = 0;      // GL buffer name
+        std::size_t   offset = 0;      // bytes from the start of buffer
+        void*         data   = nullptr;
+    };
+
+    StreamBuffer(BufferTarget target, std::size_t regionSize);
+    ~StreamBuffer();
+
+    StreamBuffer(const StreamBuffer&)            = delete;
+    StreamBuffer& operator=(const StreamBuffer&) = delete;
+
+    // Start a frame: retire the region written last frame and claim the next.
+    void BeginFrame();
+
+    // Reserve size bytes at an offset that is a multiple of alignment (a power
+    // of two).  Write the allocation before the next Allocate call; on GL 4.1
+    // it is staging memory that may move.
+    Allocation Allocate(std::size_t size, std::size_t alignment);
+
+    // Make everything allocated so far visible to GL.  A no-op when the
+    // buffer is persistently mapped (coherent writes need no flush).
+    void Flush();
+
+    // Bind size bytes of allocation to an indexed uniform or storage binding
+    // point.
+    void BindRange(std::uint32_t bindingPoint, const Allocation& allocation, std::size_t size) const;
+
+    bool          Persistent()     const { return persistent_; }
+    std::uint32_t GetID()          const { return id_; }
+    std::size_t   BytesLastFrame() const { return lastFrameBytes_; }
+
+private:
+    void Create(std::size_t regionSize);
+    void Release();
+
+    BufferTarget  target_;
+    std::uint32_t id_         = 0;
+    std::size_t   regionSize_ = 0;
+    bool          persistent_ = false;
+
+    std::byte*    mapped_  = nullptr;   // persistent: start of the whole buffer
+    std::uint32_t region_  = 0;         // persistent: region being written
+    std::size_t   head_    = 0;         // next free byte within the region
+    std::size_t   flushed_ = 0;         // orphan: bytes of the region already in GL
+
+    std::array<void*, kRegions> fences_{};   // GLsync per region, null when idle
+    std::vector<std::byte>      staging_;    // orphan: CPU copy of the region
+    std::vector<std::uint32_t>  retired_;    // outgrown buffers, deleted next frame
+
+    std::size_t frameBytes_     = 0;
+    std::size_t lastFrameBytes_ = 0;
+};
+
+} // namespace engine
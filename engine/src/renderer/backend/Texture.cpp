@@ -4,6 +4,8 @@
 #include <glad/gl.h>
 #include <stb_image.h>
 
+#include <algorithm>
+
 namespace engine {
 
 // ─── GL enum helpers (backend-only) ──────────────────────────────────────────
@@ -49,6 +51,14 @@ static GLenum ToGLWrap(TextureWrap w) noexcept
     return GL_REPEAT;
 }
 
+// Levels of a full mip chain down to 1×1.
+static std::uint32_t MipLevelCount(std::uint32_t w, std::uint32_t h) noexcept
+{
+    std::uint32_t levels = 1;
+    for (std::uint32_t extent = std::max(w, h); extent > 1; extent >>= 1) ++levels;
+    return levels;
+}
+
 // ─── Factory — FromFile ───────────────────────────────────────────────────────
 
 Texture Texture::FromFile(const std::filesystem::path& path, bool genMipmaps)
@@ -115,7 +125,7 @@ Texture Texture::Create(std::uint32_t w, std::uint32_t h,
     }
 
     glBindTexture(GL_TEXTURE_2D, 0);
-    return Texture(id, {w, h});
+    return Texture(id, {w, h}, format, 1, minFilter, magFilter, wrap);
 }
 
 // ─── Factory — FromData ───────────────────────────────────────────────────────
@@ -136,8 +146,10 @@ Texture Texture::FromData(std::uint32_t w, std::uint32_t h,
                  static_cast<GLsizei>(w), static_cast<GLsizei>(h),
                  0, baseFmt, dataType, pixels);
 
-    const GLenum minFilter = genMipmaps ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR;
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, static_cast<GLint>(minFilter));
+    const TextureFilter minFilter = genMipmaps ? TextureFilter::LinearMipmapLinear
+                                               : TextureFilter::Linear;
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER,
+                    static_cast<GLint>(ToGLFilter(minFilter)));
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
@@ -145,7 +157,8 @@ Texture Texture::FromData(std::uint32_t w, std::uint32_t h,
     if (genMipmaps) glGenerateMipmap(GL_TEXTURE_2D);
 
     glBindTexture(GL_TEXTURE_2D, 0);
-    return Texture(id, {w, h});
+    return Texture(id, {w, h}, format, genMipmaps ? MipLevelCount(w, h) : 1u,
+                   minFilter, TextureFilter::Linear, TextureWrap::Repeat);
 }
 
 // ─── Lifecycle ────────────────────────────────────────────────────────────────
@@ -156,7 +169,8 @@ Texture::~Texture()
 }
 
 Texture::Texture(Texture&& other) noexcept
-    : id_(other.id_), size_(other.size_)
+    : id_(other.id_), size_(other.size_), format_(other.format_), levels_(other.levels_)
+    , minFilter_(other.minFilter_), magFilter_(other.magFilter_), wrap_(other.wrap_)
 {
     other.id_   = 0;
     other.size_ = {0u, 0u};
@@ -168,6 +182,11 @@ Texture& Texture::operator=(Texture&& other) noexcept
         if (id_) glDeleteTextures(1, &id_);
         id_       = other.id_;
         size_     = other.size_;
+        format_    = other.format_;
+        levels_    = other.levels_;
+        minFilter_ = other.minFilter_;
+        magFilter_ = other.magFilter_;
+        wrap_      = other.wrap_;
         other.id_   = 0;
         other.size_ = {0u, 0u};
     }
@@ -180,4 +199,81 @@ void Texture::Bind(std::uint32_t unit) const
     glBindTexture(GL_TEXTURE_2D, id_);
 }
 
+// ─── TextureArray ─────────────────────────────────────────────────────────────
+
+TextureArray::TextureArray(glm::uvec2 size, std::uint32_t layers,
+                           TextureFormat format, std::uint32_t mipLevels,
+                           TextureFilter minFilter, TextureFilter magFilter, TextureWrap wrap)
+    : size_(size), layers_(layers), levels_(mipLevels)
+{
+#if defined(GL_VERSION_4_3)
+    glGenTextures(1, &id_);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, id_);
+    glTexStorage3D(GL_TEXTURE_2D_ARRAY, static_cast<GLsizei>(mipLevels),
+                   ToGLFormats(format).internalFormat,
+                   static_cast<GLsizei>(size.x), static_cast<GLsizei>(size.y),
+                   static_cast<GLsizei>(layers));
+
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER,
+                    static_cast<GLint>(ToGLFilter(minFilter)));
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER,
+                    static_cast<GLint>(ToGLFilter(magFilter)));
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S,
+                    static_cast<GLint>(ToGLWrap(wrap)));
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T,
+                    static_cast<GLint>(ToGLWrap(wrap)));
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+#else
+    (void)format; (void)minFilter; (void)magFilter; (void)wrap;
+    ENGINE_ASSERT(false, "TextureArray needs GL 4.3");
+#endif
+}
+
+TextureArray::~TextureArray()
+{
+    if (id_) glDeleteTextures(1, &id_);
+}
+
+TextureArray::TextureArray(TextureArray&& other) noexcept
+    : id_(other.id_), size_(other.size_), layers_(other.layers_), levels_(other.levels_)
+{
+    other.id_     = 0;
+    other.layers_ = 0;
+}
+
+TextureArray& TextureArray::operator=(TextureArray&& other) noexcept
+{
+    if (this != &other) {
+        if (id_) glDeleteTextures(1, &id_);
+        id_     = other.id_;
+        size_   = other.size_;
+        layers_ = other.layers_;
+        levels_ = other.levels_;
+        other.id_     = 0;
+        other.layers_ = 0;
+    }
+    return *this;
+}
+
+void TextureArray::CopyLayer(std::uint32_t layer, const Texture& src)
+{
+    ENGINE_ASSERT(layer < layers_ && src.GetSize() == size_ && src.GetMipLevels() == levels_,
+                  "TextureArray::CopyLayer — texture does not match the array");
+#if defined(GL_VERSION_4_3)
+    for (std::uint32_t level = 0; level < levels_; ++level) {
+        const GLsizei w = static_cast<GLsizei>(std::max(size_.x >> level, 1u));
+        const GLsizei h = static_cast<GLsizei>(std::max(size_.y >> level, 1u));
+        glCopyImageSubData(src.GetID(), GL_TEXTURE_2D,       static_cast<GLint>(level), 0, 0, 0,
+                           id_,         GL_TEXTURE_2D_ARRAY, static_cast<GLint>(level), 0, 0,
+                           static_cast<GLint>(layer), w, h, 1);
+    }
+#endif
+}
+
+void TextureArray::Bind(std::uint32_t unit) const
+{
+    glActiveTexture(GL_TEXTURE0 + unit);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, id_);
+}
+
 } // namespace engine
@@ -50,16 +50,64 @@ public:
 
     void Bind(std::uint32_t unit) const;
 
-    std::uint32_t GetID()   const { return id_; }
-    glm::uvec2    GetSize() const { return size_; }
-    bool          IsValid() const { return id_ != 0; }
+    std::uint32_t GetID()        const { return id_; }
+    glm::uvec2    GetSize()      const { return size_; }
+    TextureFormat GetFormat()    const { return format_; }
+    std::uint32_t GetMipLevels() const { return levels_; }
+    TextureFilter GetMinFilter() const { return minFilter_; }
+    TextureFilter GetMagFilter() const { return magFilter_; }
+    TextureWrap   GetWrap()      const { return wrap_; }
+    bool          IsValid()      const { return id_ != 0; }
 
 private:
-    std::uint32_t id_   = 0;
-    glm::uvec2    size_ = {0u, 0u};
+    std::uint32_t id_        = 0;
+    glm::uvec2    size_      = {0u, 0u};
+    TextureFormat format_    = TextureFormat::RGBA8;
+    std::uint32_t levels_    = 0;
+    TextureFilter minFilter_ = TextureFilter::Linear;
+    TextureFilter magFilter_ = TextureFilter::Linear;
+    TextureWrap   wrap_      = TextureWrap::Repeat;
 
     // Internal constructor used by the factory methods.
-    Texture(std::uint32_t id, glm::uvec2 size) : id_(id), size_(size) {}
+    Texture(std::uint32_t id, glm::uvec2 size, TextureFormat format, std::uint32_t levels,
+            TextureFilter minFilter, TextureFilter magFilter, TextureWrap wrap)
+        : id_(id), size_(size), format_(format), levels_(levels)
+        , minFilter_(minFilter), magFilter_(magFilter), wrap_(wrap) {}
+};
+
+// ─── TextureArray ─────────────────────────────────────────────────────────────
+// GL_TEXTURE_2D_ARRAY with immutable storage, filled by copying whole
+// Textures of the same size, format and mip count into its layers on the GPU.
+// Sampled with the filters and wrap its layers' Textures were created with.
+// Needs GL 4.3 (glCopyImageSubData); callers check before constructing.
+class TextureArray {
+public:
+    TextureArray() = default;
+    TextureArray(glm::uvec2 size, std::uint32_t layers,
+                 TextureFormat format, std::uint32_t mipLevels,
+                 TextureFilter minFilter, TextureFilter magFilter, TextureWrap wrap);
+    ~TextureArray();
+
+    TextureArray(const TextureArray&)            = delete;
+    TextureArray& operator=(const TextureArray&) = delete;
+    TextureArray(TextureArray&&) noexcept;
+    TextureArray& operator=(TextureArray&&) noexcept;
+
+    // Copy every mip level of src into layer.  src must match the array's
+    // size, format and mip count.
+    void CopyLayer(std::uint32_t layer, const Texture& src);
+
+    void Bind(std::uint32_t unit) const;
+
+    std::uint32_t GetID()     const { return id_; }
+    std::uint32_t GetLayers() const { return layers_; }
+    bool          IsValid()   const { return id_ != 0; }
+
+private:
+    std::uint32_t id_     = 0;
+    glm::uvec2    size_   = {0u, 0u};
+    std::uint32_t layers_ = 0;
+    std::uint32_t levels_ = 0;
 };
 
 } // namespace engine
@@ -0,0 +1,203 @@
+#include <renderer/frontend/GpuCulling.hpp>
+#include <renderer/frontend/RenderQueue.hpp>
+#include <core/Assert.hpp>
+#include <core/Log.hpp>
+
+#include <glad/gl.h>
+#include <algorithm>
+#include <numeric>
+
+#ifndef ENGINE_ASSET_DIR
+#  define ENGINE_ASSET_DIR "assets"
+#endif
+#define ASSET(rel) ENGINE_ASSET_DIR "/" rel
+
+namespace engine {
+
+namespace {
+
+// local_size_x in cull.comp.
+constexpr std::uint32_t kWorkGroupSize = 64;
+
+// SSBO binding points declared in instances.glsl and cull.comp.
+constexpr std::uint32_t kInstanceBinding        = 0;
+constexpr std::uint32_t kGeometryCommandBinding = 1;
+constexpr std::uint32_t kShadowCommandBinding   = 2;
+constexpr std::uint32_t kDrawCountBinding       = 3;
+
+} // namespace
+
+GpuInstance MakeGpuInstance(const RenderCommand& cmd)
+{
+    GpuInstance inst{};
+    inst.model           = cmd.modelMatrix;
+    inst.normalMatrix    = cmd.normalMatrix;
+    inst.boundsCenter    = glm::vec4(cmd.worldBounds.Center(),  0.f);
+    inst.boundsExtents   = glm::vec4(cmd.worldBounds.Extents(), 0.f);
+    inst.material        = cmd.materialID;
+    inst.castsShadow     = cmd.castsShadow ? 1u : 0u;
+    inst.indexCount      = cmd.indexCount;
+    inst.firstIndex      = cmd.baseIndex;
+    inst.baseVertex      = static_cast<std::int32_t>(cmd.baseVertex);
+    return inst;
+}
+
+bool GpuCulling::IsSupported()
+{
+#if defined(GL_VERSION_4_3)
+    static const bool supported = [] {
+        if (!GLAD_GL_VERSION_4_3) return false;
+        // GL 4.3 only guarantees SSBOs in the fragment and compute stages;
+        // the indirect vertex shaders read the instance buffer.
+        GLint vertexBlocks = 0;
+        glGetIntegerv(GL_MAX_VERTEX_SHADER_STORAGE_BLOCKS, &vertexBlocks);
+        return vertexBlocks > 0;
+    }();
+    return supported;
+#else
+    return false;   // GL 4.1 loader (macOS)
+#endif
+}
+
+GpuCulling::GpuCulling()
+    : shader_          (Shader::FromComputeFile(ASSET("shaders/culling/cull.comp")))
+    , instances_       (BufferTarget::ShaderStorage, BufferUsage::StreamDraw,
+                        static_cast<std::size_t>(kMaxInstances) * sizeof(GpuInstance))
+    , geometryCommands_(BufferTarget::ShaderStorage, BufferUsage::DynamicDraw,
+                        static_cast<std::size_t>(kMaxInstances) * sizeof(DrawElementsIndirectCommand))
+    , shadowCommands_  (BufferTarget::ShaderStorage, BufferUsage::DynamicDraw,
+                        static_cast<std::size_t>(kMaxInstances) * sizeof(DrawElementsIndirectCommand))
+    , drawCounts_      (BufferTarget::ShaderStorage, BufferUsage::StreamDraw,
+                        static_cast<std::size_t>(kMaxBatches + 1) * sizeof(std::uint32_t))
+    , zeroCounts_      (kMaxBatches + 1, 0u)
+{
+    ENGINE_ASSERT(shader_.IsValid(), "GpuCulling: cull shader failed to compile");
+
+#if defined(GL_VERSION_4_6)
+    drawCount_ = GLAD_GL_VERSION_4_6 && glMultiDrawElementsIndirectCount != nullptr;
+#endif
+    LOG_INFO("GpuCulling: enabled, drawing with {}",
+             drawCount_ ? "glMultiDrawElementsIndirectCount" : "glMultiDrawElementsIndirect");
+}
+
+bool GpuCulling::Cull(const RenderQueue&   queue,
+                      const MaterialTable& materials,
+                      const glm::mat4&     viewProjection,
+                      const glm::mat4&     lightSpace)
+{
+    const CommandView opaques = queue.OpaqueCommands();
+    instanceCount_ = 0;
+    materials_     = &materials;
+    batches_.clear();
+    if (opaques.size() > kMaxInstances) return false;
+
+    // Group by texture set.  The queue already sorts by material, so this
+    // merges materials whose textures share arrays; stable, so each batch
+    // keeps the queue's front-to-back order (the fixed-slot path draws in
+    // slot order).
+    order_.resize(opaques.size());
+    std::iota(order_.begin(), order_.end(), 0u);
+    std::stable_sort(order_.begin(), order_.end(), [&](std::uint32_t a, std::uint32_t b) {
+        return materials.Textures(opaques[a].materialID) < materials.Textures(opaques[b].materialID);
+    });
+
+    upload_.clear();
+    for (std::uint32_t slot = 0; slot < order_.size(); ++slot) {
+        const RenderCommand&             cmd      = opaques[order_[slot]];
+        const MaterialTable::TextureSet& textures = materials.Textures(cmd.materialID);
+        if (batches_.empty() || batches_.back().textures != textures) {
+            if (batches_.size() == kMaxBatches) {
+                batches_.clear();
+                return false;
+            }
+            batches_.push_back({textures, slot, 0});
+        }
+        Batch& batch = batches_.back();
+        ++batch.count;
+
+        GpuInstance& inst = upload_.emplace_back(MakeGpuInstance(cmd));
+        inst.batch        = static_cast<std::uint32_t>(batches_.size() - 1);
+        inst.batchFirst   = batch.first;
+    }
+    if (upload_.empty()) return true;
+
+    vaoID_         = opaques.front().vaoID;   // all meshes share one VAO
+    instanceCount_ = static_cast<std::uint32_t>(upload_.size());
+
+    instances_.Upload(0, upload_.size() * sizeof(GpuInstance), upload_.data());
+    drawCounts_.Upload(0, (batches_.size() + 1) * sizeof(std::uint32_t), zeroCounts_.data());
+
+    shader_.Bind();
+    shader_.SetMat4("u_CullViewProjection", viewProjection);
+    shader_.SetMat4("u_CullLightSpace",     lightSpace);
+    shader_.SetInt ("u_InstanceCount", static_cast<int>(instanceCount_));
+    shader_.SetInt ("u_BatchCount",    static_cast<int>(batches_.size()));
+    shader_.SetInt ("u_Compact",       drawCount_ ? 1 : 0);
+
+    instances_.BindBase(kInstanceBinding);
+    geometryCommands_.BindBase(kGeometryCommandBinding);
+    shadowCommands_.BindBase(kShadowCommandBinding);
+    drawCounts_.BindBase(kDrawCountBinding);
+
+#if defined(GL_VERSION_4_3)
+    glDispatchCompute((instanceCount_ + kWorkGroupSize - 1) / kWorkGroupSize, 1, 1);
+    // The commands and counts are read next as indirect / parameter buffers.
+    glMemoryBarrier(GL_COMMAND_BARRIER_BIT);
+#endif
+    return true;
+}
+
+std::uint32_t GpuCulling::DrawCallCount() const
+{
+    return static_cast<std::uint32_t>(batches_.size()) + (instanceCount_ > 0 ? 1u : 0u);
+}
+
+void GpuCulling::DrawGeometryBatch(std::size_t i) const
+{
+    const Batch& batch = batches_[i];
+    materials_->Bind();
+    MultiDraw(geometryCommands_, batch.first, batch.count, static_cast<std::uint32_t>(i));
+}
+
+void GpuCulling::DrawShadowCasters() const
+{
+    MultiDraw(shadowCommands_, 0, instanceCount_, static_cast<std::uint32_t>(batches_.size()));
+}
+
+void GpuCulling::MultiDraw(const Buffer&  commands,
+                           std::uint32_t  first,
+                           std::uint32_t  maxCount,
+                           std::uint32_t  countIndex) const
+{
+#if defined(GL_VERSION_4_3)
+    if (maxCount == 0) return;
+
+    instances_.BindBase(kInstanceBinding);
+    glBindVertexArray(vaoID_);
+    glEnableVertexAttribArray(MeshBuffer::kDrawIDLocation);   // InstanceBuffer disables it
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, commands.GetID());
+    const void* offset = reinterpret_cast<const void*>(
+        static_cast<std::uintptr_t>(first) * sizeof(DrawElementsIndirectCommand));
+
+    bool drawn = false;
+#  if defined(GL_VERSION_4_6)
+    if (drawCount_) {
+        glBindBuffer(GL_PARAMETER_BUFFER, drawCounts_.GetID());
+        glMultiDrawElementsIndirectCount(GL_TRIANGLES, GL_UNSIGNED_INT, offset,
+                                         static_cast<GLintptr>(countIndex * sizeof(std::uint32_t)),
+                                         static_cast<GLsizei>(maxCount), 0);
+        glBindBuffer(GL_PARAMETER_BUFFER, 0);
+        drawn = true;
+    }
+#  endif
+    if (!drawn)
+        glMultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT, offset,
+                                    static_cast<GLsizei>(maxCount), 0);
+
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+#else
+    (void)commands; (void)first; (void)maxCount; (void)countIndex;
+#endif
+}
+
+} // namespace engine
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <renderer/backend/Buffer.hpp>
+#include <renderer/backend/Shader.hpp>
+#include <renderer/frontend/IndirectDrawSource.hpp>
+#include <resources/MeshBuffer.hpp>
+#include <glm/mat4x4.hpp>
+#include <glm/vec4.hpp>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace engine {
+
+class RenderQueue;
+struct RenderCommand;
+
+// CPU-side mirror of GpuInstance in common/instances.glsl (std430).
+struct alignas(16) GpuInstance {
+    glm::mat4     model;            //  offset   0, size 64
+    glm::mat4     normalMatrix;     //  offset  64, size 64
+    glm::vec4     boundsCenter;     //  offset 128, size 16  (xyz)
+    glm::vec4     boundsExtents;    //  offset 144, size 16  (xyz)
+    std::uint32_t material;         //  offset 160  MaterialTable index
+    std::uint32_t castsShadow;      //  offset 164
+    std::uint32_t batch;            //  offset 168
+    std::uint32_t batchFirst;       //  offset 172
+    std::uint32_t indexCount;       //  offset 176
+    std::uint32_t firstIndex;       //  offset 180
+    std::int32_t  baseVertex;       //  offset 184
+    std::uint32_t _pad0;            //  offset 188
+                                    //  total: 192 bytes
+};
+static_assert(sizeof(GpuInstance) == 192,
+              "GpuInstance size mismatch — std430 layout broken");
+
+// Instance record of cmd; batch and batchFirst are left zero.
+GpuInstance MakeGpuInstance(const RenderCommand& cmd);
+
+// ─── GpuCulling ───────────────────────────────────────────────────────────────
+// GPU-driven frustum culling and indirect draw generation.
+//
+// Each frame the queue's opaque commands are uploaded as GpuInstances to an
+// SSBO and a compute shader (culling/cull.comp) tests their world bounds
+// against the camera frustum and, for shadow casters, the light frustum.  It
+// writes one DrawElementsIndirectCommand per survivor, so the geometry and
+// shadow passes draw everything the CPU submitted with multi-draw indirect
+// calls whose draw count never leaves the GPU.
+//
+// Instances are grouped into batches whose materials sample the same
+// MaterialTable arrays: the arrays can only change between draws, so the
+// geometry pass issues one multi-draw per batch and the shadow pass, which
+// samples nothing, exactly one.
+//
+// Requires GL 4.3 (compute shaders, SSBOs readable from the vertex stage,
+// glMultiDrawElementsIndirect).  With GL 4.6, culled commands are compacted
+// and drawn through glMultiDrawElementsIndirectCount; on 4.3 - 4.5 (e.g. Mesa
+// llvmpipe) each instance keeps a fixed slot and culled ones draw zero
+// instances.  Renderer falls back to the CPU path when IsSupported is false.
+class GpuCulling final : public IndirectDrawSource {
+public:
+    static constexpr std::uint32_t kMaxInstances = MeshBuffer::kMaxDrawIDs;
+    static constexpr std::uint32_t kMaxBatches   = 1024;
+
+    // True when the current context can run the GPU path.  Needs a current
+    // GL context; the result is cached.
+    static bool IsSupported();
+
+    // Only construct when IsSupported() is true.
+    GpuCulling();
+
+    // Upload the queue's opaque commands and dispatch the culling shader.
+    // materials must be built and outlive the frame's draws.  Returns false,
+    // leaving nothing to draw, when the queue exceeds kMaxInstances or
+    // kMaxBatches; the caller then draws on the CPU path.
+    bool Cull(const RenderQueue&   queue,
+              const MaterialTable& materials,
+              const glm::mat4&     viewProjection,
+              const glm::mat4&     lightSpace);
+
+    // IndirectDrawSource, for the last Cull.  A batch covers command slots
+    // [first, first + count) of the geometry command buffer.
+    std::span<const Batch> Batches() const override { return batches_; }
+    void DrawGeometryBatch(std::size_t i) const override;
+    void DrawShadowCasters() const override;
+    std::uint32_t DrawCallCount() const override;
+
+    // Instances uploaded by the last Cull.
+    std::uint32_t InstanceCount() const { return instanceCount_; }
+
+    // True when commands are compacted and drawn with a GPU-side count.
+    bool UsesDrawCount() const { return drawCount_; }
+
+    Shader& GetShader() { return shader_; }
+
+private:
+    // One multi-draw over command slots [first, first + maxCount); with a
+    // GPU-side count, the count is drawCounts[countIndex].
+    void MultiDraw(const Buffer& commands, std::uint32_t first,
+                   std::uint32_t maxCount, std::uint32_t countIndex) const;
+
+    Shader shader_;
+    Buffer instances_;          // GpuInstance[kMaxInstances]
+    Buffer geometryCommands_;   // DrawElementsIndirectCommand[kMaxInstances]
+    Buffer shadowCommands_;     // DrawElementsIndirectCommand[kMaxInstances]
+    Buffer drawCounts_;         // uint[kMaxBatches + 1]
+
+    bool                 drawCount_     = false;
+    std::uint32_t        vaoID_         = 0;
+    std::uint32_t        instanceCount_ = 0;
+    const MaterialTable* materials_     = nullptr;   // of the last Cull
+
+    // Scratch reused across frames.
+    std::vector<std::uint32_t> order_;
+    std::vector<GpuInstance>   upload_;
+    std::vector<Batch>         batches_;
+    std::vector<std::uint32_t> zeroCounts_;
+};
+
+} // namespace engine
@@ -0,0 +1,123 @@
+#include <renderer/frontend/IndirectDrawBuilder.hpp>
+#include <renderer/frontend/GpuCulling.hpp>
+#include <renderer/frontend/RenderQueue.hpp>
+
+#include <glad/gl.h>
+#include <algorithm>
+
+namespace engine {
+
+namespace {
+
+// Instances and commands of a few thousand draws before the ring grows.
+constexpr std::size_t kRegionSize = 1u << 20;
+
+// Instances binding declared in instances.glsl.
+constexpr std::uint32_t kInstanceBinding = 0;
+
+DrawElementsIndirectCommand ToCommand(const RenderCommand& cmd, const InstanceBatch& batch,
+                                      std::uint32_t instanceBase)
+{
+    return {cmd.indexCount, batch.count, cmd.baseIndex,
+            static_cast<std::int32_t>(cmd.baseVertex), instanceBase + batch.first};
+}
+
+} // namespace
+
+IndirectDrawBuilder::IndirectDrawBuilder()
+    : ring_(BufferTarget::ShaderStorage, kRegionSize)
+    , alignment_(16)
+{
+#if defined(GL_VERSION_4_3)
+    GLint alignment = 0;
+    glGetIntegerv(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, &alignment);
+    alignment_ = std::max<std::size_t>(static_cast<std::size_t>(alignment), alignment_);
+#endif
+}
+
+bool IndirectDrawBuilder::Build(const RenderQueue& queue, const MaterialTable& materials)
+{
+    const CommandView opaques       = queue.OpaqueCommands();
+    const CommandView casters       = queue.ShadowCasters();
+    const auto        opaqueBatches = queue.OpaqueBatches();
+    const auto        shadowBatches = queue.ShadowBatches();
+
+    batches_.clear();
+    materials_     = &materials;
+    instanceBytes_ = 0;
+    shadowCount_   = 0;
+
+    const std::size_t instanceCount = opaques.size() + casters.size();
+    if (instanceCount > kMaxInstances) return false;
+    if (instanceCount == 0) return true;
+
+    // All meshes share one VAO.
+    vaoID_ = (opaques.empty() ? casters.front() : opaques.front()).vaoID;
+
+    instanceBytes_ = instanceCount * sizeof(GpuInstance);
+    instances_     = ring_.Allocate(instanceBytes_, alignment_);
+    auto* instance = static_cast<GpuInstance*>(instances_.data);
+    for (const RenderCommand& cmd : opaques) *instance++ = MakeGpuInstance(cmd);
+    for (const RenderCommand& cmd : casters) *instance++ = MakeGpuInstance(cmd);
+
+    geometryCommands_ = ring_.Allocate(opaqueBatches.size() * sizeof(DrawElementsIndirectCommand),
+                                       alignof(DrawElementsIndirectCommand));
+    auto* command = static_cast<DrawElementsIndirectCommand*>(geometryCommands_.data);
+    for (std::uint32_t i = 0; i < opaqueBatches.size(); ++i) {
+        const RenderCommand&             cmd      = opaques[opaqueBatches[i].first];
+        const MaterialTable::TextureSet& textures = materials.Textures(cmd.materialID);
+        *command++ = ToCommand(cmd, opaqueBatches[i], 0);
+        if (batches_.empty() || batches_.back().textures != textures)
+            batches_.push_back({textures, i, 0});
+        ++batches_.back().count;
+    }
+
+    const auto shadowBase = static_cast<std::uint32_t>(opaques.size());
+    shadowCommands_ = ring_.Allocate(shadowBatches.size() * sizeof(DrawElementsIndirectCommand),
+                                     alignof(DrawElementsIndirectCommand));
+    command = static_cast<DrawElementsIndirectCommand*>(shadowCommands_.data);
+    for (const InstanceBatch& batch : shadowBatches)
+        *command++ = ToCommand(casters[batch.first], batch, shadowBase);
+    shadowCount_ = static_cast<std::uint32_t>(shadowBatches.size());
+
+    ring_.Flush();
+    return true;
+}
+
+std::uint32_t IndirectDrawBuilder::DrawCallCount() const
+{
+    return static_cast<std::uint32_t>(batches_.size()) + (shadowCount_ > 0 ? 1u : 0u);
+}
+
+void IndirectDrawBuilder::DrawGeometryBatch(std::size_t i) const
+{
+    materials_->Bind();
+    MultiDraw(geometryCommands_, batches_[i].first, batches_[i].count);
+}
+
+void IndirectDrawBuilder::DrawShadowCasters() const
+{
+    MultiDraw(shadowCommands_, 0, shadowCount_);
+}
+
+void IndirectDrawBuilder::MultiDraw(const StreamBuffer::Allocation& commands,
+                                    std::uint32_t first, std::uint32_t count) const
+{
+#if defined(GL_VERSION_4_3)
+    if (count == 0) return;
+
+    ring_.BindRange(kInstanceBinding, instances_, instanceBytes_);
+    glBindVertexArray(vaoID_);
+    glEnableVertexAttribArray(MeshBuffer::kDrawIDLocation);   // InstanceBuffer disables it
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, commands.buffer);
+    const void* offset = reinterpret_cast<const void*>(static_cast<std::uintptr_t>(
+        commands.offset + first * sizeof(DrawElementsIndirectCommand)));
+    glMultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT, offset,
+                                static_cast<GLsizei>(count), 0);
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+#else
+    (void)commands; (void)first; (void)count;
+#endif
+}
+
+} // namespace engine
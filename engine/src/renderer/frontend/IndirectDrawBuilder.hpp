@@ -0,0 +1,74 @@
+#pragma once
+
+#include <renderer/backend/StreamBuffer.hpp>
+#include <renderer/frontend/IndirectDrawSource.hpp>
+#include <resources/MeshBuffer.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace engine {
+
+class RenderQueue;
+
+// ─── IndirectDrawBuilder ──────────────────────────────────────────────────────
+// Multi-draw indirect submission for the CPU-culled queue.  Once per frame
+// Build writes, into one StreamBuffer:
+//   - a GpuInstance per opaque command, then per shadow caster, in the
+//     queue's sorted order — the per-draw data the indirect vertex shaders
+//     read through the draw ID;
+//   - a DrawElementsIndirectCommand per opaque InstanceBatch, then per shadow
+//     InstanceBatch, whose baseInstance is the batch's first GpuInstance.
+// Consecutive opaque batches whose materials sample the same MaterialTable
+// arrays form one geometry multi-draw; every caster is in the single shadow
+// multi-draw.  Instances carry their material index, so materials that differ
+// in factors or layers still merge.
+//
+// Same requirements as the GpuCulling draws (GL 4.3, storage blocks in the
+// vertex stage); Renderer keeps the per-batch instanced loop for GL 4.1.
+class IndirectDrawBuilder final : public IndirectDrawSource {
+public:
+    // Draw IDs come from MeshBuffer's static stream.
+    static constexpr std::uint32_t kMaxInstances = MeshBuffer::kMaxDrawIDs;
+
+    // Only construct when GpuCulling::IsSupported() is true.
+    IndirectDrawBuilder();
+
+    // Move the ring to the next region; once per frame, before Build.
+    void BeginFrame() { ring_.BeginFrame(); }
+
+    // Write the instances and commands of queue's sorted opaque and shadow
+    // batches.  materials must be built and outlive the frame's draws.
+    // Returns false, leaving nothing to draw, when the queue holds more than
+    // kMaxInstances commands; the caller then draws with the loop.
+    bool Build(const RenderQueue& queue, const MaterialTable& materials);
+
+    std::span<const Batch> Batches() const override { return batches_; }
+    void DrawGeometryBatch(std::size_t i) const override;
+    void DrawShadowCasters() const override;
+    std::uint32_t DrawCallCount() const override;
+
+    // Bytes written into the ring last frame.
+    std::size_t BytesLastFrame() const { return ring_.BytesLastFrame(); }
+
+private:
+    // One glMultiDrawElementsIndirect over count commands from first on.
+    void MultiDraw(const StreamBuffer::Allocation& commands,
+                   std::uint32_t first, std::uint32_t count) const;
+
+    StreamBuffer  ring_;
+    std::size_t   alignment_;   // GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT
+
+    StreamBuffer::Allocation instances_;
+    StreamBuffer::Allocation geometryCommands_;
+    StreamBuffer::Allocation shadowCommands_;
+    std::size_t              instanceBytes_ = 0;
+    std::uint32_t            shadowCount_   = 0;   // shadow commands
+    std::uint32_t            vaoID_         = 0;
+    const MaterialTable*     materials_     = nullptr;   // of the last Build
+
+    std::vector<Batch> batches_;   // reused across frames
+};
+
+} // namespace engine
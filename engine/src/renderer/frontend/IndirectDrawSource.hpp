@@ -0,0 +1,58 @@
+#pragma once
+
+#include <resources/MaterialTable.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace engine {
+
+// Layout fixed by the GL spec; DrawCommand in cull.comp mirrors it.
+struct DrawElementsIndirectCommand {
+    std::uint32_t count;
+    std::uint32_t instanceCount;
+    std::uint32_t firstIndex;
+    std::int32_t  baseVertex;
+    std::uint32_t baseInstance;
+};
+static_assert(sizeof(DrawElementsIndirectCommand) == 20,
+              "DrawElementsIndirectCommand must be tightly packed");
+
+// ─── IndirectDrawSource ───────────────────────────────────────────────────────
+// What the geometry and shadow passes need to draw a frame with multi-draw
+// indirect calls: texture-set batches for the geometry pass, one multi-draw
+// for all shadow casters.  Every draw reads its GpuInstance through the draw
+// ID (see MeshBuffer), and through it its GpuMaterial, so the passes bind the
+// *_indirect programs and never touch per-object state.
+//
+// Implemented by GpuCulling, whose commands a compute shader writes, and by
+// IndirectDrawBuilder, which writes them on the CPU from the sorted queue.
+class IndirectDrawSource {
+public:
+    // A run of draws whose materials sample the same MaterialTable arrays;
+    // the arrays can only change between multi-draws.
+    struct Batch {
+        MaterialTable::TextureSet textures;
+        std::uint32_t             first = 0;   // first geometry command
+        std::uint32_t             count = 0;
+    };
+
+    // Texture-set batches of this frame, for the geometry pass.
+    virtual std::span<const Batch> Batches() const = 0;
+
+    // Issue the multi-draw for batch i with the gbuffer_indirect program and
+    // the batch's texture arrays bound.
+    virtual void DrawGeometryBatch(std::size_t i) const = 0;
+
+    // Issue the multi-draw for all shadow casters with the shadow_indirect
+    // program bound.
+    virtual void DrawShadowCasters() const = 0;
+
+    // Multi-draw calls this frame leads to (batches + shadow).
+    virtual std::uint32_t DrawCallCount() const = 0;
+
+protected:
+    ~IndirectDrawSource() = default;
+};
+
+} // namespace engine
@@ -0,0 +1,103 @@
+#include <renderer/frontend/InstanceBuffer.hpp>
+#include <renderer/frontend/RenderQueue.hpp>
+#include <resources/MeshBuffer.hpp>
+
+#include <glad/gl.h>
+#include <cstddef>
+
+namespace engine {
+
+InstanceBuffer::InstanceBuffer()
+    : ring_(BufferTarget::Vertex,
+            static_cast<std::size_t>(MeshBuffer::kMaxDrawIDs) * sizeof(InstanceData))
+{
+#if defined(GL_VERSION_4_2)
+    baseInstance_ = GLAD_GL_VERSION_4_2 != 0;
+#endif
+}
+
+void InstanceBuffer::Upload(const RenderQueue& queue)
+{
+    const CommandView opaques = queue.OpaqueCommands();
+    const CommandView casters = queue.ShadowCasters();
+
+    shadowBase_ = static_cast<std::uint32_t>(opaques.size());
+    const std::size_t count = opaques.size() + casters.size();
+    if (count == 0) return;
+
+    const StreamBuffer::Allocation region = ring_.Allocate(count * sizeof(InstanceData),
+                                                           sizeof(InstanceData));
+    auto* out = static_cast<InstanceData*>(region.data);
+    for (const RenderCommand& cmd : opaques) *out++ = {cmd.modelMatrix, cmd.normalMatrix};
+    for (const RenderCommand& cmd : casters) *out++ = {cmd.modelMatrix, cmd.normalMatrix};
+    ring_.Flush();
+
+    frameBase_ = static_cast<std::uint32_t>(region.offset / sizeof(InstanceData));
+
+    // Set the VAO up again on the first draw: the ring may have grown into a
+    // new buffer, and indirect draws since will have re-enabled the draw ID.
+    attachedVAO_ = 0;
+}
+
+void InstanceBuffer::Draw(const RenderCommand& cmd, const InstanceBatch& batch,
+                          std::uint32_t base) const
+{
+    if (attachedVAO_ != cmd.vaoID) {
+        for (std::uint32_t i = 0; i < 4; ++i) {
+            glEnableVertexAttribArray(kModelLocation + i);
+            glVertexAttribDivisor(kModelLocation + i, 1);
+        }
+        for (std::uint32_t i = 0; i < 3; ++i) {
+            glEnableVertexAttribArray(kNormalLocation + i);
+            glVertexAttribDivisor(kNormalLocation + i, 1);
+        }
+        // The draw ID stream holds kMaxDrawIDs entries, fewer than the
+        // instances of the ring; the instanced shaders do not read it.
+        glDisableVertexAttribArray(MeshBuffer::kDrawIDLocation);
+        PointAttributes(0);
+        attachedVAO_ = cmd.vaoID;
+    }
+
+    const std::uint32_t first = frameBase_ + base + batch.first;
+    const void* indexOffset = reinterpret_cast<const void*>(
+        static_cast<std::uintptr_t>(cmd.baseIndex) * sizeof(std::uint32_t));
+
+#if defined(GL_VERSION_4_2)
+    if (baseInstance_) {
+        glDrawElementsInstancedBaseVertexBaseInstance(GL_TRIANGLES,
+                                                      static_cast<GLsizei>(cmd.indexCount),
+                                                      GL_UNSIGNED_INT, indexOffset,
+                                                      static_cast<GLsizei>(batch.count),
+                                                      static_cast<GLint>(cmd.baseVertex),
+                                                      first);
+        return;
+    }
+#endif
+    if (pointedAt_ != first) PointAttributes(first);
+    glDrawElementsInstancedBaseVertex(GL_TRIANGLES,
+                                      static_cast<GLsizei>(cmd.indexCount),
+                                      GL_UNSIGNED_INT, indexOffset,
+                                      static_cast<GLsizei>(batch.count),
+                                      static_cast<GLint>(cmd.baseVertex));
+}
+
+void InstanceBuffer::PointAttributes(std::uint32_t first) const
+{
+    constexpr GLsizei kStride = sizeof(InstanceData);
+    const std::uintptr_t at = static_cast<std::uintptr_t>(first) * sizeof(InstanceData);
+    const auto column = [&](std::uintptr_t matrixOffset, std::uint32_t i) {
+        return reinterpret_cast<const void*>(at + matrixOffset + i * sizeof(glm::vec4));
+    };
+
+    glBindBuffer(GL_ARRAY_BUFFER, ring_.GetID());
+    for (std::uint32_t i = 0; i < 4; ++i)
+        glVertexAttribPointer(kModelLocation + i, 4, GL_FLOAT, GL_FALSE, kStride,
+                              column(offsetof(InstanceData, model), i));
+    for (std::uint32_t i = 0; i < 3; ++i)
+        glVertexAttribPointer(kNormalLocation + i, 3, GL_FLOAT, GL_FALSE, kStride,
+                              column(offsetof(InstanceData, normalMatrix), i));
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    pointedAt_ = first;
+}
+
+} // namespace engine
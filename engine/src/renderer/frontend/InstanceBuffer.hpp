@@ -0,0 +1,82 @@
+#pragma once
+
+#include <renderer/backend/StreamBuffer.hpp>
+#include <renderer/frontend/RenderCommand.hpp>
+#include <glm/mat4x4.hpp>
+#include <cstddef>
+#include <cstdint>
+
+namespace engine {
+
+class RenderQueue;
+struct InstanceBatch;
+
+// CPU-side mirror of the per-instance vertex attributes in
+// common/instancing.glsl: aModel (mat4) reads model, aNormalMatrix (mat3)
+// the xyz of normalMatrix's first three columns.
+struct alignas(16) InstanceData {
+    glm::mat4 model;          // offset  0, size 64
+    glm::mat4 normalMatrix;   // offset 64, size 64  transpose(inverse(model))
+};
+static_assert(sizeof(InstanceData) == 128, "InstanceData size mismatch");
+
+// ─── InstanceBuffer ───────────────────────────────────────────────────────────
+// Per-instance matrices for the CPU draw path.  Once per frame Upload writes
+// the model and normal matrices of the queue's opaque commands, then of its
+// shadow casters, each in draw order, into a StreamBuffer region; the geometry
+// and shadow passes then draw every InstanceBatch with a single instanced
+// call whose instances read their matrices as vertex attributes (divisor 1)
+// at kModelLocation and kNormalLocation of the shared MeshBuffer VAO.
+//
+// With GL 4.2, a batch is selected by glDrawElementsInstancedBaseVertex-
+// BaseInstance's baseInstance.  GL 4.1 has no base instance, so the
+// attribute pointers are moved to the batch's first instance before each
+// glDrawElementsInstancedBaseVertex instead.
+//
+// With base instances the attributes stay pointed at the start of the ring
+// and the region's offset is folded into baseInstance, which thus runs past
+// MeshBuffer::kMaxDrawIDs; the draw ID attribute is disabled while these
+// draws are made, and the indirect draws enable it again.  Conversely each
+// region holds at least kMaxDrawIDs instances: the indirect draws use base
+// instances up to that many, and the VAO fetches these attributes for them
+// too even though their shaders do not declare them.
+class InstanceBuffer {
+public:
+    static constexpr std::uint32_t kModelLocation  = 5;   // mat4: 5 - 8
+    static constexpr std::uint32_t kNormalLocation = 9;   // mat3: 9 - 11
+
+    InstanceBuffer();
+
+    // Move the ring to the next region; once per frame, before Upload.
+    void BeginFrame() { ring_.BeginFrame(); }
+
+    // Write the matrices of queue's sorted opaque commands and shadow
+    // casters.  Grows the ring when they do not fit.
+    void Upload(const RenderQueue& queue);
+
+    // Instance bytes written last frame.
+    std::size_t BytesLastFrame() const { return ring_.BytesLastFrame(); }
+
+    // Instance of the first shadow caster; opaque commands start at 0.
+    std::uint32_t ShadowBase() const { return shadowBase_; }
+
+    // Draw batch of cmd's mesh range, its instances starting at instance
+    // base + batch.first.  The VAO of cmd must be bound.
+    void Draw(const RenderCommand& cmd, const InstanceBatch& batch, std::uint32_t base) const;
+
+private:
+    // Point the instance attributes of the bound VAO at instance first.
+    void PointAttributes(std::uint32_t first) const;
+
+    StreamBuffer  ring_;
+    std::uint32_t frameBase_    = 0;   // ring instance of this frame's first
+    std::uint32_t shadowBase_   = 0;
+    bool          baseInstance_ = false;
+
+    // VAO the attributes were last set up on this frame, and the instance
+    // they point at; attribute state lives in the VAO, not the buffer.
+    mutable std::uint32_t attachedVAO_ = 0;
+    mutable std::uint32_t pointedAt_   = 0;
+};
+
+} // namespace engine
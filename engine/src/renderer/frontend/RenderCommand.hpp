@@ -1,5 +1,6 @@
 #pragma once
 
+#include <core/Geometry.hpp>
 #include <glm/mat4x4.hpp>
 #include <glm/vec3.hpp>
 #include <cstdint>
@@ -19,6 +20,7 @@ struct RenderCommand {
     // ── Transform ─────────────────────────────────────────────────────────────
     glm::mat4 modelMatrix  = glm::mat4(1.f);
     glm::mat4 normalMatrix = glm::mat4(1.f);  // transpose(inverse(model))
+    AABB      worldBounds;                    // mesh bounds in world space
 
     // ── Material (pre-resolved GL texture IDs) ────────────────────────────────
     std::uint32_t albedoTexID       = 0;   // texture unit 0 in G-buffer pass
@@ -32,7 +34,12 @@ struct RenderCommand {
     // ── Flags and sorting ─────────────────────────────────────────────────────
     bool  castsShadow      = true;
     bool  transparent      = false;
-    float distanceToCamera = 0.f;   // for back-to-front sorting of transparents
+    float distanceToCamera = 0.f;   // depth part of the sort key
+
+    // State identities for the sort key: commands that share them can be
+    // drawn without rebinding.  Raw resource handle indices.
+    std::uint32_t meshID     = 0;
+    std::uint32_t materialID = 0;
 };
 
 } // namespace engine
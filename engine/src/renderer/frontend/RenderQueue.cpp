@@ -1,50 +1,239 @@
 #include <renderer/frontend/RenderQueue.hpp>
+#include <core/RadixSort.hpp>
+#include <core/Jobs/JobSystem.hpp>
 #include <algorithm>
+#include <bit>
 
 namespace engine {
 
-void RenderQueue::Submit(const RenderCommand& cmd)
+namespace {
+
+constexpr int kPassShift = 62;
+
+// Opaque layout.
+constexpr int           kMaterialShift = 42;
+constexpr int           kMeshShift     = 16;
+constexpr std::uint64_t kMaterialMask  = (1ull << 20) - 1;
+constexpr std::uint64_t kMeshMask      = (1ull << 26) - 1;
+
+// Transparent layout.
+constexpr int           kInvDepthShift       = 30;
+constexpr std::uint64_t kTransparentMeshMask = (1ull << 30) - 1;
+
+// Initial arena size per frame buffer; it grows to fit the scene.
+constexpr std::size_t kArenaCapacity = std::size_t{4} << 20;
+
+constexpr std::uint64_t kOpaquePass      = 0;
+constexpr std::uint64_t kTransparentPass = 1;
+
+// Bit pattern of a distance, ordered like the distance itself.  Negative
+// distances and NaN (never produced by RenderSystem) sort as 0.
+std::uint32_t DepthBits(float distance)
+{
+    return std::bit_cast<std::uint32_t>(distance > 0.f ? distance : 0.f);
+}
+
+// Grow bounds by cmd: its world bounds, or its origin when it has none.
+void ExpandBounds(AABB& bounds, const RenderCommand& cmd)
+{
+    if (cmd.worldBounds.IsValid())
+        bounds.Expand(cmd.worldBounds);
+    else
+        bounds.Expand(glm::vec3(cmd.modelMatrix[3]));
+}
+
+// True when b can be drawn as another instance of a: same mesh range, and
+// for the geometry pass the same material.
+bool SameMesh(const RenderCommand& a, const RenderCommand& b)
+{
+    return a.vaoID == b.vaoID && a.baseVertex == b.baseVertex &&
+           a.baseIndex == b.baseIndex && a.indexCount == b.indexCount;
+}
+
+bool SameDraw(const RenderCommand& a, const RenderCommand& b)
+{
+    return SameMesh(a, b) && a.materialID == b.materialID;
+}
+
+// Cut the sorted order into runs of commands that sameFn says can share an
+// instanced draw.
+template<typename SameFn>
+void BuildBatches(FrameArena&                      arena,
+                  const FrameArray<RenderCommand>& commands,
+                  const FrameArray<std::uint32_t>& order,
+                  FrameArray<InstanceBatch>&       batches,
+                  SameFn&&                         sameFn)
+{
+    batches.Resize(arena, 0);
+    for (std::uint32_t i = 0; i < order.size(); ++i) {
+        if (i == 0 || !sameFn(commands[order[i - 1]], commands[order[i]]))
+            batches.Push(arena, {i, 0});
+        ++batches[batches.size() - 1].count;
+    }
+}
+
+// Reorder the command indices in order by keyOf, with key storage from arena.
+template<typename KeyFn>
+void SortByKey(FrameArena&                          arena,
+               const FrameArray<RenderCommand>&     commands,
+               FrameArray<std::uint32_t>&           order,
+               KeyFn&&                              keyOf)
+{
+    const std::uint32_t n = order.size();
+    if (n < 2) return;
+
+    const std::span<SortKey> keys   {arena.AllocateArray<SortKey>(n), n};
+    const std::span<SortKey> scratch{arena.AllocateArray<SortKey>(n), n};
+    for (std::uint32_t i = 0; i < n; ++i) keys[i] = {keyOf(commands[order[i]]), order[i]};
+
+    const std::span<SortKey> sorted = RadixSort(keys, scratch);
+    for (std::uint32_t i = 0; i < n; ++i) order[i] = sorted[i].index;
+}
+
+} // namespace
+
+std::uint64_t RenderQueue::OpaqueKey(const RenderCommand& cmd)
+{
+    return  (kOpaquePass << kPassShift)
+          | ((static_cast<std::uint64_t>(cmd.materialID) & kMaterialMask) << kMaterialShift)
+          | ((static_cast<std::uint64_t>(cmd.meshID) & kMeshMask) << kMeshShift)
+          | static_cast<std::uint64_t>(DepthBits(cmd.distanceToCamera) >> 16);
+}
+
+std::uint64_t RenderQueue::TransparentKey(const RenderCommand& cmd)
+{
+    return  (kTransparentPass << kPassShift)
+          | (static_cast<std::uint64_t>(~DepthBits(cmd.distanceToCamera)) << kInvDepthShift)
+          | (static_cast<std::uint64_t>(cmd.meshID) & kTransparentMeshMask);
+}
+
+RenderQueue::RenderQueue()
+    : arena_(kArenaCapacity)
+{
+    heapAllocationsAtClear_ = arena_.HeapAllocations();
+    Reserve();
+}
+
+std::uint32_t RenderQueue::Submit(const RenderCommand& cmd)
 {
+    const std::uint32_t index = commands_.Push(arena_, cmd);
     if (cmd.transparent)
-        transparents_.push_back(cmd);
+        transparents_.Push(arena_, index);
     else
-        opaques_.push_back(cmd);
+        opaques_.Push(arena_, index);
 
-    // Expand scene AABB using the mesh's transformed origin as an approximation.
-    // A tighter fit (transforming the local AABB) is done by Phase 6 culling.
-    const glm::vec3 origin = glm::vec3(cmd.modelMatrix[3]);
-    sceneBounds_.Expand(origin);
+    // World bounds are precomputed by RenderSystem; commands submitted
+    // without them (invalid AABB) contribute their origin.
+    ExpandBounds(sceneBounds_, cmd);
+    return index;
+}
+
+void RenderQueue::Segment::Submit(const RenderCommand& cmd)
+{
+    commands_.push_back(cmd);
+    if (cmd.transparent) ++transparentCount_;
+    ExpandBounds(bounds_, cmd);
+}
+
+void RenderQueue::Segment::Clear()
+{
+    commands_.clear();
+    transparentCount_ = 0;
+    bounds_           = AABB{};
+}
+
+std::uint32_t RenderQueue::Merge(std::span<const Segment> segments, JobSystem& jobs)
+{
+    // Where each segment's commands and indices go: running totals.
+    struct Offsets {
+        std::uint32_t command, opaque, transparent;
+    };
+    const std::uint32_t segmentCount = static_cast<std::uint32_t>(segments.size());
+    Offsets* offsets = arena_.AllocateArray<Offsets>(segmentCount);
+
+    Offsets end{commands_.size(), opaques_.size(), transparents_.size()};
+    const std::uint32_t first = end.command;
+    for (std::uint32_t i = 0; i < segmentCount; ++i) {
+        const Segment& segment = segments[i];
+        offsets[i]       = end;
+        end.command     += segment.Size();
+        end.opaque      += segment.Size() - segment.transparentCount_;
+        end.transparent += segment.transparentCount_;
+        if (segment.bounds_.IsValid()) sceneBounds_.Expand(segment.bounds_);
+    }
+    commands_.Resize(arena_, end.command);
+    opaques_.Resize(arena_, end.opaque);
+    transparents_.Resize(arena_, end.transparent);
+
+    jobs.ParallelFor(segmentCount, 1, [&](std::uint32_t begin, std::uint32_t stop) {
+        for (std::uint32_t i = begin; i < stop; ++i) {
+            Offsets at = offsets[i];
+            for (const RenderCommand& cmd : segments[i].commands_) {
+                commands_[at.command] = cmd;
+                if (cmd.transparent)
+                    transparents_[at.transparent++] = at.command;
+                else
+                    opaques_[at.opaque++] = at.command;
+                ++at.command;
+            }
+        }
+    });
+    return first;
+}
+
+void RenderQueue::SubmitShadowCaster(const RenderCommand& cmd)
+{
+    AddShadowCaster(commands_.Push(arena_, cmd));
+}
+
+void RenderQueue::AddShadowCaster(std::uint32_t index)
+{
+    shadowCasters_.Push(arena_, index);
+    ExpandBounds(casterBounds_, commands_[index]);
 }
 
 void RenderQueue::Sort()
 {
-    // Opaques: front-to-back (minimise overdraw)
-    std::sort(opaques_.begin(), opaques_.end(),
-              [](const RenderCommand& a, const RenderCommand& b) {
-                  return a.distanceToCamera < b.distanceToCamera;
-              });
+    // Opaques: by material, then front-to-back (minimise binds and overdraw)
+    SortByKey(arena_, commands_, opaques_, OpaqueKey);
 
     // Transparents: back-to-front (correct alpha blending)
-    std::sort(transparents_.begin(), transparents_.end(),
-              [](const RenderCommand& a, const RenderCommand& b) {
-                  return a.distanceToCamera > b.distanceToCamera;
-              });
+    SortByKey(arena_, commands_, transparents_, TransparentKey);
+
+    // Shadow casters: depth-only, so only the mesh and its LOD matter.
+    SortByKey(arena_, commands_, shadowCasters_, [](const RenderCommand& cmd) {
+        return (static_cast<std::uint64_t>(cmd.meshID) << 32) | cmd.baseIndex;
+    });
+
+    BuildBatches(arena_, commands_, opaques_,       opaqueBatches_, SameDraw);
+    BuildBatches(arena_, commands_, shadowCasters_, shadowBatches_, SameMesh);
 }
 
 void RenderQueue::Clear()
 {
-    opaques_.clear();
-    transparents_.clear();
-    sceneBounds_ = AABB{};
+    lastFrameHeapAllocations_ = arena_.HeapAllocations() - heapAllocationsAtClear_;
+    lastFrameBytes_           = arena_.Used();
+
+    // The other buffer still holds the frame before this one; reset it and
+    // leave this frame's commands readable until the next Clear.
+    arena_.NextFrame();
+    heapAllocationsAtClear_ = arena_.HeapAllocations();
+    Reserve();
+
+    sceneBounds_       = AABB{};
+    casterBounds_      = AABB{};
+    receiverBounds_    = AABB{};
+    hasReceiverBounds_ = false;
 }
 
-std::vector<RenderCommand> RenderQueue::ShadowCasters() const
+void RenderQueue::Reserve()
 {
-    std::vector<RenderCommand> result;
-    result.reserve(opaques_.size());
-    for (const auto& cmd : opaques_)
-        if (cmd.castsShadow) result.push_back(cmd);
-    return result;
+    commands_.Reset(arena_, commands_.size());
+    opaques_.Reset(arena_, opaques_.size());
+    transparents_.Reset(arena_, transparents_.size());
+    shadowCasters_.Reset(arena_, shadowCasters_.size());
+    opaqueBatches_.Reset(arena_, opaqueBatches_.size());
+    shadowBatches_.Reset(arena_, shadowBatches_.size());
 }
 
 } // namespace engine
@@ -2,38 +2,209 @@
 
 #include <renderer/frontend/RenderCommand.hpp>
 #include <core/Geometry.hpp>
+#include <core/Memory/FrameArena.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <span>
 #include <vector>
 
 namespace engine {
 
+class JobSystem;
+
+// ─── CommandView ──────────────────────────────────────────────────────────────
+// Commands in draw order, read through an index array over storage that is
+// never moved.
+class CommandView {
+public:
+    class Iterator {
+    public:
+        Iterator(const RenderCommand* commands, const std::uint32_t* at)
+            : commands_(commands), at_(at) {}
+
+        const RenderCommand& operator*()  const { return commands_[*at_]; }
+        const RenderCommand* operator->() const { return &commands_[*at_]; }
+        Iterator& operator++() { ++at_; return *this; }
+        bool operator==(const Iterator& other) const { return at_ == other.at_; }
+
+    private:
+        const RenderCommand* commands_;
+        const std::uint32_t* at_;
+    };
+
+    CommandView() = default;
+    CommandView(std::span<const RenderCommand> commands, std::span<const std::uint32_t> order)
+        : commands_(commands), order_(order) {}
+
+    const RenderCommand& operator[](std::size_t i) const { return commands_[order_[i]]; }
+    const RenderCommand& front() const { return (*this)[0]; }
+
+    std::size_t size()  const { return order_.size(); }
+    bool        empty() const { return order_.empty(); }
+
+    Iterator begin() const { return {commands_.data(), order_.data()}; }
+    Iterator end()   const { return {commands_.data(), order_.data() + order_.size()}; }
+
+private:
+    std::span<const RenderCommand> commands_;
+    std::span<const std::uint32_t> order_;
+};
+
+// ─── InstanceBatch ────────────────────────────────────────────────────────────
+// A run of commands, consecutive in a sorted CommandView, that draw the same
+// mesh range with the same material: one instanced draw.  first and count
+// are positions in the view.
+struct InstanceBatch {
+    std::uint32_t first = 0;
+    std::uint32_t count = 0;
+};
+
 // ─── RenderQueue ──────────────────────────────────────────────────────────────
 // Collects RenderCommands for a single frame, then sorts and exposes them
 // to render passes.  Cleared at the start of each frame by the Renderer.
+//
+// Sort never moves a command.  Each one gets a packed 64-bit key and the
+// (key, index) pairs are radix sorted (core/RadixSort.hpp); passes read the
+// commands through the sorted indices (CommandView).  Opaque keys put state
+// first so draws sharing a material and mesh are adjacent, front-to-back
+// within a mesh; transparent keys are back-to-front.  Sort then cuts the
+// opaque and shadow orders into InstanceBatches, so N copies of a mesh and
+// material cost one instanced draw.
+//
+// Shadow casters are a list of their own: they are gathered against the
+// light's volume rather than the camera frustum (see
+// RenderSystem::GatherShadowCasters), so an off-screen caster can still
+// shadow what the camera sees.
+//
+// All commands live in one array, and the opaque, transparent and shadow
+// lists are index lists into it, so a caster also drawn by the geometry pass
+// is stored once.  The array, the lists and the sort keys are allocated from
+// a double-buffered FrameArena sized from the previous frame: once it has
+// grown to the working set, a frame does no heap allocation (see
+// LastFrameHeapAllocations).  Views stay valid until the Clear after next.
+//
+// Submit is single-threaded.  Threads building commands concurrently each
+// fill a Segment of their own instead, and Merge appends the segments in one
+// step before the sort.
 class RenderQueue {
 public:
-    void Submit(const RenderCommand& cmd);
+    // ─── Segment ──────────────────────────────────────────────────────────────
+    // One thread's commands for the queue, appended by Merge.  Storage is kept
+    // across Clear, so a segment reused every frame stops allocating once it
+    // has held its largest frame.  Cache-line aligned: segments of different
+    // threads sit side by side.
+    class alignas(64) Segment {
+    public:
+        // As RenderQueue::Submit.
+        void Submit(const RenderCommand& cmd);
+
+        void Clear();
+
+        std::uint32_t Size() const { return static_cast<std::uint32_t>(commands_.size()); }
+
+    private:
+        friend class RenderQueue;
+
+        std::vector<RenderCommand> commands_;
+        std::uint32_t              transparentCount_ = 0;
+        AABB                       bounds_;
+    };
 
-    // Sort opaque front-to-back, transparents back-to-front, then append.
+    RenderQueue();
+
+    // Queue cmd for the geometry pass; returns its command index.
+    std::uint32_t Submit(const RenderCommand& cmd);
+
+    // Queue cmd for the shadow pass only.
+    void SubmitShadowCaster(const RenderCommand& cmd);
+
+    // Also draw the command Submit returned index for into the shadow map.
+    void AddShadowCaster(std::uint32_t index);
+
+    // Append the commands of segments, in order, as if each had been passed
+    // to Submit.  Each segment is copied by its own job into a range no other
+    // touches, so the copies take no locks.  Returns the index of the first
+    // command; the rest follow consecutively.  Segments are left unchanged.
+    std::uint32_t Merge(std::span<const Segment> segments, JobSystem& jobs);
+
+    // Sort opaque by state then front-to-back, transparents back-to-front,
+    // shadow casters by mesh, and batch opaques and casters for instancing.
+    // The views below are in submission order, and there are no batches,
+    // until Sort runs.
     void Sort();
 
     void Clear();
 
-    // Separate views for shadow and geometry passes.
-    // All shadow-casting opaques (transparents excluded from shadow).
-    std::vector<RenderCommand> ShadowCasters() const;
+    CommandView OpaqueCommands()      const { return {commands_.Span(), opaques_.Span()};      }
+    CommandView TransparentCommands() const { return {commands_.Span(), transparents_.Span()}; }
 
-    const std::vector<RenderCommand>& OpaqueCommands()      const { return opaques_; }
-    const std::vector<RenderCommand>& TransparentCommands() const { return transparents_; }
+    // Commands for the shadow pass: SubmitShadowCaster and AddShadowCaster.
+    CommandView ShadowCasters()       const { return {commands_.Span(), shadowCasters_.Span()}; }
 
-    // Accumulated AABB of all submitted commands (updated on Submit).
+    // Instanced draws covering OpaqueCommands (same mesh range and material)
+    // and ShadowCasters (same mesh range: depth-only draws ignore material).
+    std::span<const InstanceBatch> OpaqueBatches() const { return opaqueBatches_.Span(); }
+    std::span<const InstanceBatch> ShadowBatches() const { return shadowBatches_.Span(); }
+
+    // Union of the world bounds of all submitted commands (updated on Submit).
     const AABB& SceneBounds() const { return sceneBounds_; }
 
+    // Union of the world bounds of the shadow casters.
+    const AABB& CasterBounds() const { return casterBounds_; }
+
+    // Receivers the shadow map covers: what SetReceiverBounds gave this
+    // frame, or SceneBounds when the queue holds only what the camera sees.
+    const AABB& ReceiverBounds() const { return hasReceiverBounds_ ? receiverBounds_ : sceneBounds_; }
+
+    // Override ReceiverBounds until Clear, for a queue that holds more than
+    // the camera sees (everything, when the GPU culls).
+    void SetReceiverBounds(const AABB& bounds)
+    {
+        receiverBounds_    = bounds;
+        hasReceiverBounds_ = true;
+    }
+
     std::size_t TotalCount() const { return opaques_.size() + transparents_.size(); }
 
+    // Heap allocations made by the queue during the last cleared frame; zero
+    // in steady state.  Only arena growth allocates.
+    std::size_t LastFrameHeapAllocations() const { return lastFrameHeapAllocations_; }
+
+    // Arena bytes used by the last cleared frame.
+    std::size_t LastFrameBytes() const { return lastFrameBytes_; }
+
+    // Sort keys, exposed for benchmarks and debugging.  Layout, MSB first:
+    //   opaque       | pass 2 | material 20 | mesh 26 | depth 16 |
+    //   transparent  | pass 2 | inverted depth 32    | mesh 30 |
+    // depth is the float bit pattern of distanceToCamera, whose order matches
+    // the value's for non-negative floats; the opaque key keeps its top 16
+    // bits (exponent and 7 mantissa bits), i.e. buckets under 1% deep.
+    static std::uint64_t OpaqueKey     (const RenderCommand& cmd);
+    static std::uint64_t TransparentKey(const RenderCommand& cmd);
+
 private:
-    std::vector<RenderCommand> opaques_;
-    std::vector<RenderCommand> transparents_;
-    AABB                       sceneBounds_;
+    // Start a frame's arrays, reserving what the last frame used.
+    void Reserve();
+
+    FrameArena arena_;
+
+    FrameArray<RenderCommand> commands_;
+    AABB                      sceneBounds_;
+    AABB                      casterBounds_;
+    AABB                      receiverBounds_;
+    bool                      hasReceiverBounds_ = false;
+
+    // Draw order: indices into commands_.
+    FrameArray<std::uint32_t> opaques_;
+    FrameArray<std::uint32_t> transparents_;
+    FrameArray<std::uint32_t> shadowCasters_;
+
+    FrameArray<InstanceBatch> opaqueBatches_;
+    FrameArray<InstanceBatch> shadowBatches_;
+
+    std::size_t heapAllocationsAtClear_   = 0;
+    std::size_t lastFrameHeapAllocations_ = 0;
+    std::size_t lastFrameBytes_           = 0;
 };
 
 } // namespace engine
@@ -1,24 +1,43 @@
 #include <renderer/frontend/Renderer.hpp>
+#include <core/Log.hpp>
+
+#include <glad/gl.h>
+#include <algorithm>
+#include <cstring>
 
 namespace engine {
 
 // ─── UniformBufferCache ───────────────────────────────────────────────────────
 
-template<typename T>
-void UniformBufferCache::Upload(std::optional<Buffer>& slot,
-                                std::uint32_t          bindingPoint,
-                                const T&               data)
+namespace {
+// Room for the frame and shadow blocks, with plenty to spare.
+constexpr std::size_t kUniformRegionSize = 1u << 16;
+} // namespace
+
+UniformBufferCache::UniformBufferCache()
+    : ring_(BufferTarget::Uniform, kUniformRegionSize)
+{
+    GLint alignment = 0;
+    glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+    alignment_ = std::max<std::size_t>(static_cast<std::size_t>(alignment), 16);
+}
+
+void UniformBufferCache::BeginFrame()
 {
-    if (!slot.has_value())
-        slot.emplace(BufferTarget::Uniform, BufferUsage::DynamicDraw, sizeof(T));
+    ring_.BeginFrame();
+}
 
-    slot->Upload(0, sizeof(T), &data);
-    slot->BindBase(bindingPoint);
+template<typename T>
+void UniformBufferCache::Upload(std::uint32_t bindingPoint, const T& data)
+{
+    const StreamBuffer::Allocation block = ring_.Allocate(sizeof(T), alignment_);
+    std::memcpy(block.data, &data, sizeof(T));
+    ring_.Flush();
+    ring_.BindRange(bindingPoint, block, sizeof(T));
 }
 
-void UniformBufferCache::UploadPerFrame (const PerFrameData&  d) { Upload(perFrameUBO_,  0, d); }
-void UniformBufferCache::UploadPerObject(const PerObjectData& d) { Upload(perObjectUBO_, 1, d); }
-void UniformBufferCache::UploadShadow   (const ShadowData&    d) { Upload(shadowUBO_,    2, d); }
+void UniformBufferCache::UploadPerFrame(const PerFrameData& d) { Upload(0, d); }
+void UniformBufferCache::UploadShadow  (const ShadowData&   d) { Upload(2, d); }
 
 // ─── Renderer ─────────────────────────────────────────────────────────────────
 
@@ -27,7 +46,15 @@ Renderer::Renderer(std::uint32_t w, std::uint32_t h)
     , geoPass_    (w, h)
     , lightingPass_(w, h)
     , postPass_   (w, h)
-{}
+{
+    if (GpuCulling::IsSupported()) {
+        gpuCulling_.emplace();
+        indirectBuilder_.emplace();
+    } else {
+        LOG_INFO("Renderer: GPU culling and multi-draw unavailable (needs GL 4.3), "
+                 "drawing instance batches one at a time");
+    }
+}
 
 void Renderer::Resize(std::uint32_t w, std::uint32_t h)
 {
@@ -57,15 +84,44 @@ const Texture& Renderer::RenderFrame(const FrameContext& ctx)
 
     queue_.Sort();
 
+    ubos_.BeginFrame();
+    instances_.BeginFrame();
+    if (indirectBuilder_) indirectBuilder_->BeginFrame();
     ubos_.UploadPerFrame(ctx.frame);
 
+    // GPU culling against the camera and the same light frustum the shadow
+    // pass fits.  A queue too large for it is drawn, unculled, on the CPU path.
+    const IndirectDrawSource* indirect = nullptr;
+    if (GpuCullingActive()) {
+        gpuTimer_.Begin("Cull");
+        const glm::mat4 lightSpace = ShadowPass::FitLightSpace(queue_.ReceiverBounds(),
+                                                               queue_.CasterBounds(), ctx.lightDir);
+        if (gpuCulling_->Cull(queue_, *materials_, ctx.frame.viewProjection, lightSpace))
+            indirect = &*gpuCulling_;
+        gpuTimer_.End("Cull");
+    }
+
+    // Otherwise build the multi-draws from the sorted batches, or, failing
+    // that, stream the batches' matrices once for both passes' instanced
+    // draws.
+    if (!indirect && indirectBuilder_ && multiDrawEnabled_ && MaterialsReady() &&
+        indirectBuilder_->Build(queue_, *materials_))
+        indirect = &*indirectBuilder_;
+    if (indirect) {
+        drawCalls_ = indirect->DrawCallCount();
+    } else {
+        instances_.Upload(queue_);
+        drawCalls_ = static_cast<std::uint32_t>(queue_.OpaqueBatches().size() +
+                                                queue_.ShadowBatches().size());
+    }
+
     gpuTimer_.Begin("Shadow");
-    shadowPass_.Execute(queue_, ctx.frame, ubos_,
-                        ctx.lightDir, ctx.lightColor, ctx.lightIntensity);
+    shadowPass_.Execute(queue_, ubos_, instances_,
+                        ctx.lightDir, ctx.lightColor, ctx.lightIntensity, indirect);
     gpuTimer_.End("Shadow");
 
     gpuTimer_.Begin("GBuffer");
-    geoPass_.Execute(queue_, ctx.frame, ubos_);
+    geoPass_.Execute(queue_, instances_, indirect);
     gpuTimer_.End("GBuffer");
 
     gpuTimer_.Begin("Lighting");
@@ -1,9 +1,12 @@
 #pragma once
 
-#include <renderer/backend/Buffer.hpp>
+#include <renderer/backend/StreamBuffer.hpp>
 #include <renderer/backend/Texture.hpp>
 #include <renderer/frontend/UniformData.hpp>
 #include <renderer/frontend/RenderQueue.hpp>
+#include <renderer/frontend/GpuCulling.hpp>
+#include <renderer/frontend/IndirectDrawBuilder.hpp>
+#include <renderer/frontend/InstanceBuffer.hpp>
 #include <renderer/frontend/passes/ShadowPass.hpp>
 #include <renderer/frontend/passes/GeometryPass.hpp>
 #include <renderer/frontend/passes/LightingPass.hpp>
@@ -12,6 +15,7 @@
 #include <resources/ResourceManager.hpp>
 #include <glm/vec3.hpp>
 #include <optional>
+#include <cstddef>
 #include <cstdint>
 #include <unordered_map>
 #include <string>
@@ -19,21 +23,28 @@
 namespace engine {
 
 // ─── UniformBufferCache ───────────────────────────────────────────────────────
+// Every uniform block of a frame is written into one StreamBuffer ring and
+// bound with glBindBufferRange at its offset, so an upload never touches
+// storage the GPU may still be reading.  Call BeginFrame once per frame,
+// before the first upload.
 class UniformBufferCache {
 public:
+    UniformBufferCache();
+
+    void BeginFrame();
+
     void UploadPerFrame (const PerFrameData&  data);
-    void UploadPerObject(const PerObjectData& data);
     void UploadShadow   (const ShadowData&    data);
 
+    // Uniform bytes written into the ring last frame.
+    std::size_t BytesLastFrame() const { return ring_.BytesLastFrame(); }
+
 private:
-    std::optional<Buffer> perFrameUBO_;
-    std::optional<Buffer> perObjectUBO_;
-    std::optional<Buffer> shadowUBO_;
+    StreamBuffer ring_;
+    std::size_t  alignment_;   // GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT
 
     template<typename T>
-    static void Upload(std::optional<Buffer>& slot,
-                       std::uint32_t          bindingPoint,
-                       const T&               data);
+    void Upload(std::uint32_t bindingPoint, const T& data);
 };
 
 // ─── FrameContext ─────────────────────────────────────────────────────────────
@@ -50,6 +61,13 @@ struct FrameContext {
 // ─── Renderer ────────────────────────────────────────────────────────────────
 // Top-level renderer. Owns all render passes and drives a complete
 // deferred-shading frame: Shadow → GBuffer → Lighting → PostProcess.
+//
+// When the context supports it (GL 4.3+, see GpuCulling), opaque commands are
+// frustum-culled on the GPU and the shadow and geometry passes draw them with
+// multi-draw indirect calls.  Callers then submit every mesh unculled (see
+// GpuCullingActive).  With GPU culling off, the CPU-culled queue is still
+// drawn with multi-draw indirect calls, built by IndirectDrawBuilder; on
+// GL 4.1, or with that toggle off too, each instance batch is its own draw.
 class Renderer {
 public:
     Renderer(std::uint32_t viewportW, std::uint32_t viewportH);
@@ -70,6 +88,31 @@ public:
     // Access the UBO cache if a caller needs to upload custom data.
     UniformBufferCache& UBOs() { return ubos_; }
 
+    // Materials the multi-draw paths sample; must outlive the renderer.  The
+    // indirect paths stay off until it is set and built.
+    void SetMaterialTable(const MaterialTable* materials) { materials_ = materials; }
+
+    // GPU culling: available when the context supports it, active when also
+    // enabled and the material table is built.  Query GpuCullingActive before
+    // gathering commands — when true, the queue must hold every mesh, not
+    // just the CPU frustum survivors.
+    bool  GpuCullingAvailable() const { return gpuCulling_.has_value(); }
+    bool  GpuCullingActive()    const { return gpuCulling_ && gpuCullingEnabled_ && MaterialsReady(); }
+    bool& GpuCullingEnabled()         { return gpuCullingEnabled_; }
+
+    // Multi-draw indirect for the CPU-culled queue (same availability).
+    bool& MultiDrawEnabled() { return multiDrawEnabled_; }
+
+    // Draw calls the shadow and geometry passes issued last frame: multi-draw
+    // indirect calls, or instanced draws on the loop path.
+    std::uint32_t DrawCallCount() const { return drawCalls_; }
+
+    // Bytes written into the uniform and instance stream buffers last frame.
+    std::size_t StreamedBytes() const {
+        return ubos_.BytesLastFrame() + instances_.BytesLastFrame() +
+               (indirectBuilder_ ? indirectBuilder_->BytesLastFrame() : 0);
+    }
+
     float& BloomThreshold() { return postPass_.BloomThreshold; }
     float& BloomStrength()  { return postPass_.BloomStrength;  }
 
@@ -78,6 +121,11 @@ public:
         rm.TrackShaderForReload(shadowPass_.GetShader());
         rm.TrackShaderForReload(geoPass_.GetShader());
         rm.TrackShaderForReload(lightingPass_.GetShader());
+        if (gpuCulling_) {
+            rm.TrackShaderForReload(gpuCulling_->GetShader());
+            rm.TrackShaderForReload(*shadowPass_.GetIndirectShader());
+            rm.TrackShaderForReload(*geoPass_.GetIndirectShader());
+        }
         postPass_.ForEachShader([&](Shader& s){ rm.TrackShaderForReload(s); });
     }
 
@@ -93,14 +141,25 @@ public:
     std::uint32_t GetHDRTexID()       const { return lightingPass_.HDROutput().GetID(); }
 
 private:
+    bool MaterialsReady() const { return materials_ && materials_->IsBuilt(); }
+
     UniformBufferCache ubos_;
     RenderQueue        queue_;
+    InstanceBuffer     instances_;
+    std::uint32_t      drawCalls_ = 0;
 
     ShadowPass      shadowPass_;
     GeometryPass    geoPass_;
     LightingPass    lightingPass_;
     PostProcessPass postPass_;
 
+    std::optional<GpuCulling> gpuCulling_;   // engaged when GpuCulling::IsSupported()
+    bool                      gpuCullingEnabled_ = true;
+
+    std::optional<IndirectDrawBuilder> indirectBuilder_;   // engaged alongside gpuCulling_
+    bool                               multiDrawEnabled_ = true;
+    const MaterialTable*               materials_        = nullptr;
+
     GPUTimer                                 gpuTimer_;
     std::unordered_map<std::string, float>   lastGPUTimes_;
 };
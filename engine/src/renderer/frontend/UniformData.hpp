@@ -33,7 +33,7 @@ struct alignas(16) PerFrameData {
 static_assert(sizeof(PerFrameData) == 288,
               "PerFrameData size mismatch — std140 alignment broken");
 
-// ─── binding = 1 — updated per draw call ─────────────────────────────────────
+// ─── binding = 1 — no pass binds it anymore (see InstanceBuffer) ────────────
 struct alignas(16) PerObjectData {
     glm::mat4 model;             //  offset  0, size 64
     glm::mat4 normalMatrix;      //  offset 64, size 64  (mat4 so std140 padding is trivial)
@@ -1,6 +1,9 @@
 #include <renderer/frontend/passes/GeometryPass.hpp>
 #include <renderer/frontend/RenderQueue.hpp>
 #include <renderer/frontend/Renderer.hpp>
+#include <renderer/frontend/GpuCulling.hpp>
+#include <renderer/frontend/IndirectDrawSource.hpp>
+#include <renderer/frontend/InstanceBuffer.hpp>
 #include <core/Assert.hpp>
 
 #include <glad/gl.h>
@@ -25,13 +28,20 @@ GeometryPass::GeometryPass(std::uint32_t w, std::uint32_t h)
                                 ASSET("shaders/geometry/gbuffer.frag")))
 {
     ENGINE_ASSERT(shader_.IsValid(), "GeometryPass: gbuffer shader failed to compile");
+
+    if (GpuCulling::IsSupported()) {
+        indirectShader_.emplace(Shader::FromFiles(ASSET("shaders/geometry/gbuffer_indirect.vert"),
+                                                  ASSET("shaders/geometry/gbuffer_indirect.frag")));
+        ENGINE_ASSERT(indirectShader_->IsValid(),
+                      "GeometryPass: indirect gbuffer shader failed to compile");
+    }
 }
 
 void GeometryPass::OnResize(std::uint32_t w, std::uint32_t h) { fbo_.Resize(w, h); }
 
-void GeometryPass::Execute(const RenderQueue&  queue,
-                           const PerFrameData& /*frameData*/,
-                           UniformBufferCache& ubos)
+void GeometryPass::Execute(const RenderQueue&        queue,
+                           const InstanceBuffer&     instances,
+                           const IndirectDrawSource* indirect)
 {
     const auto sz = fbo_.GetSize();
     fbo_.Bind();
@@ -41,6 +51,37 @@ void GeometryPass::Execute(const RenderQueue&  queue,
     glEnable(GL_DEPTH_TEST);
     glEnable(GL_CULL_FACE);
 
+    if (indirect && indirectShader_) {
+        // Each draw finds its factors and layers in the material table; only
+        // the texture arrays change between multi-draws, and only what
+        // changed is rebound.
+        indirectShader_->Bind();
+        indirectShader_->SetTexture("u_AlbedoArray",    0);
+        indirectShader_->SetTexture("u_NormalArray",    1);
+        indirectShader_->SetTexture("u_MetalRoughArray",2);
+
+        const MaterialTable::TextureSet* prevSet = nullptr;
+        const auto bindArray = [&](GLenum unit, std::uint32_t id, std::uint32_t prevID) {
+            if (prevSet && id == prevID) return;
+            glActiveTexture(unit);
+            glBindTexture(GL_TEXTURE_2D_ARRAY, id);
+        };
+
+        const auto batches = indirect->Batches();
+        for (std::size_t i = 0; i < batches.size(); ++i) {
+            const MaterialTable::TextureSet& set = batches[i].textures;
+            bindArray(GL_TEXTURE0, set.albedoArrayID,        prevSet ? prevSet->albedoArrayID        : 0);
+            bindArray(GL_TEXTURE1, set.normalArrayID,        prevSet ? prevSet->normalArrayID        : 0);
+            bindArray(GL_TEXTURE2, set.metallicRoughArrayID, prevSet ? prevSet->metallicRoughArrayID : 0);
+            prevSet = &set;
+            indirect->DrawGeometryBatch(i);
+        }
+
+        glBindVertexArray(0);
+        Framebuffer::BindDefault();
+        return;
+    }
+
     shader_.Bind();
 
     // Bind fixed texture units once for the whole pass
@@ -48,30 +89,36 @@ void GeometryPass::Execute(const RenderQueue&  queue,
     shader_.SetTexture("u_NormalMap",    1);
     shader_.SetTexture("u_MetalRoughMap",2);
 
-    for (const RenderCommand& cmd : queue.OpaqueCommands()) {
-        // Per-object UBO
-        PerObjectData obj{};
-        obj.model        = cmd.modelMatrix;
-        obj.normalMatrix = cmd.normalMatrix;
-        ubos.UploadPerObject(obj);
+    // One instanced draw per batch of identical mesh and material.  The
+    // queue is sorted by material, so consecutive batches mostly share
+    // textures and factors; only what changed is rebound.
+    const CommandView    opaques = queue.OpaqueCommands();
+    const RenderCommand* prev    = nullptr;
+    const auto bindTexture = [&](GLenum unit, std::uint32_t id, std::uint32_t prevID) {
+        if (prev && id == prevID) return;
+        glActiveTexture(unit);
+        glBindTexture(GL_TEXTURE_2D, id);
+    };
+
+    for (const InstanceBatch& batch : queue.OpaqueBatches()) {
+        const RenderCommand& cmd = opaques[batch.first];
 
         // Material uniforms (texture unit bindings are the only direct set)
-        glActiveTexture(GL_TEXTURE0); glBindTexture(GL_TEXTURE_2D, cmd.albedoTexID);
-        glActiveTexture(GL_TEXTURE1); glBindTexture(GL_TEXTURE_2D, cmd.normalTexID);
-        glActiveTexture(GL_TEXTURE2); glBindTexture(GL_TEXTURE_2D, cmd.metallicRoughTexID);
-
-        shader_.SetVec3 ("u_AlbedoFactor",    cmd.albedoFactor);
-        shader_.SetFloat("u_MetallicFactor",  cmd.metallicFactor);
-        shader_.SetFloat("u_RoughnessFactor", cmd.roughnessFactor);
-
-        glBindVertexArray(cmd.vaoID);
-        const void* indexOffset = reinterpret_cast<const void*>(
-            static_cast<std::uintptr_t>(cmd.baseIndex) * sizeof(std::uint32_t));
-        glDrawElementsBaseVertex(GL_TRIANGLES,
-                                 static_cast<GLsizei>(cmd.indexCount),
-                                 GL_UNSIGNED_INT,
-                                 indexOffset,
-                                 static_cast<GLint>(cmd.baseVertex));
+        bindTexture(GL_TEXTURE0, cmd.albedoTexID,        prev ? prev->albedoTexID        : 0);
+        bindTexture(GL_TEXTURE1, cmd.normalTexID,        prev ? prev->normalTexID        : 0);
+        bindTexture(GL_TEXTURE2, cmd.metallicRoughTexID, prev ? prev->metallicRoughTexID : 0);
+
+        if (!prev || cmd.albedoFactor    != prev->albedoFactor   ||
+                     cmd.metallicFactor  != prev->metallicFactor ||
+                     cmd.roughnessFactor != prev->roughnessFactor) {
+            shader_.SetVec3 ("u_AlbedoFactor",    cmd.albedoFactor);
+            shader_.SetFloat("u_MetallicFactor",  cmd.metallicFactor);
+            shader_.SetFloat("u_RoughnessFactor", cmd.roughnessFactor);
+        }
+
+        if (!prev || cmd.vaoID != prev->vaoID) glBindVertexArray(cmd.vaoID);
+        prev = &cmd;
+        instances.Draw(cmd, batch, 0);
     }
 
     glBindVertexArray(0);
@@ -2,13 +2,14 @@
 
 #include <renderer/backend/Framebuffer.hpp>
 #include <renderer/backend/Shader.hpp>
-#include <renderer/frontend/UniformData.hpp>
 #include <cstdint>
+#include <optional>
 
 namespace engine {
 
 class RenderQueue;
-class UniformBufferCache;
+class IndirectDrawSource;
+class InstanceBuffer;
 
 // ─── GeometryPass ─────────────────────────────────────────────────────────────
 // Fills the G-Buffer (MRT) with world-space normal, albedo, and PBR material
@@ -19,15 +20,23 @@ class UniformBufferCache;
 //   Color 1 (RGBA8)   — albedo
 //   Color 2 (RGBA8)   — metallic(r), roughness(g), ao(b)
 //   Depth              — hardware depth
+//
+// Given an IndirectDrawSource for this frame (GpuCulling or the CPU-built
+// IndirectDrawBuilder), each of its texture-set batches is drawn with one
+// multi-draw indirect call, sampling the MaterialTable's texture arrays.
+// Otherwise (GL 4.1) each of the queue's opaque InstanceBatches is one
+// instanced draw, its matrices read from the InstanceBuffer.
 class GeometryPass {
 public:
     GeometryPass(std::uint32_t w, std::uint32_t h);
 
     void OnResize(std::uint32_t w, std::uint32_t h);
 
-    void Execute(const RenderQueue&  queue,
-                 const PerFrameData& frameData,
-                 UniformBufferCache& ubos);
+    // indirect may be null; instances must then hold this frame's upload of
+    // queue.
+    void Execute(const RenderQueue&        queue,
+                 const InstanceBuffer&     instances,
+                 const IndirectDrawSource* indirect = nullptr);
 
     const Texture& Normal()   const { return fbo_.GetColorAttachment(0); }
     const Texture& Albedo()   const { return fbo_.GetColorAttachment(1); }
@@ -35,9 +44,13 @@ public:
     const Texture& Depth()    const { return fbo_.GetDepthAttachment();  }
     Shader&        GetShader()      { return shader_; }
 
+    // Program for indirect draws; null when they are unsupported.
+    Shader*        GetIndirectShader() { return indirectShader_ ? &*indirectShader_ : nullptr; }
+
 private:
-    Framebuffer fbo_;
-    Shader      shader_;
+    Framebuffer           fbo_;
+    Shader                shader_;
+    std::optional<Shader> indirectShader_;
 };
 
 } // namespace engine
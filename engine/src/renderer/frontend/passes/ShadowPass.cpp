@@ -1,12 +1,17 @@
 #include <renderer/frontend/passes/ShadowPass.hpp>
 #include <renderer/frontend/RenderQueue.hpp>
+#include <renderer/frontend/InstanceBuffer.hpp>
 #include <renderer/frontend/Renderer.hpp>
+#include <renderer/frontend/GpuCulling.hpp>
+#include <renderer/frontend/IndirectDrawSource.hpp>
 #include <renderer/frontend/UniformData.hpp>
 #include <core/Assert.hpp>
 #include <core/Log.hpp>
 
 #include <glad/gl.h>
+#include <glm/geometric.hpp>
 #include <glm/gtc/matrix_transform.hpp>
+#include <cmath>
 #include <span>
 
 #ifndef ENGINE_ASSET_DIR
@@ -16,6 +21,60 @@
 
 namespace engine {
 
+namespace {
+
+// box in light view space, as the bounds of its eight transformed corners.
+AABB ToLightView(const AABB& box, const glm::mat4& view)
+{
+    AABB result;
+    for (int i = 0; i < 8; ++i) {
+        const glm::vec3 corner((i & 1) ? box.max.x : box.min.x,
+                               (i & 2) ? box.max.y : box.min.y,
+                               (i & 4) ? box.max.z : box.min.z);
+        result.Expand(glm::vec3(view * glm::vec4(corner, 1.f)));
+    }
+    return result;
+}
+
+} // namespace
+
+// Orthographic light frustum fitted to the world bounds of the receivers: the
+// light looks at their center from outside their bounding sphere, and the
+// projection is their extent in light view space, deepened toward the light
+// to take in the casters.
+glm::mat4 ShadowPass::FitLightSpace(const AABB&      receivers,
+                                    const AABB&      casters,
+                                    const glm::vec3& lightDir)
+{
+    const glm::vec3 dir = glm::normalize(lightDir);
+    const glm::vec3 up  = (std::abs(dir.y) < 0.99f)
+                              ? glm::vec3(0.f, 1.f, 0.f)
+                              : glm::vec3(1.f, 0.f, 0.f);
+
+    // Nothing submitted: fall back to a fixed box around the origin.
+    if (!receivers.IsValid()) {
+        constexpr float kExtent = 8.f;
+        constexpr float kDepth  = 20.f;
+        const glm::mat4 view = glm::lookAt(-dir * (kDepth * 0.5f), glm::vec3(0.f), up);
+        return glm::ortho(-kExtent, kExtent, -kExtent, kExtent, 0.1f, kDepth) * view;
+    }
+
+    const glm::vec3 center = receivers.Center();
+    const float     radius = glm::max(glm::length(receivers.Extents()), 1e-3f);
+    const glm::mat4 view   = glm::lookAt(center - dir * radius, center, up);
+
+    AABB lightBounds = ToLightView(receivers, view);
+    if (casters.IsValid())
+        lightBounds.max.z = glm::max(lightBounds.max.z, ToLightView(casters, view).max.z);
+
+    // The light looks down -Z: near / far are the negated max / min depths.
+    // A small margin keeps receivers on the bounds from clipping.
+    constexpr float kMargin = 0.05f;
+    return glm::ortho(lightBounds.min.x - kMargin, lightBounds.max.x + kMargin,
+                      lightBounds.min.y - kMargin, lightBounds.max.y + kMargin,
+                      -lightBounds.max.z - kMargin, -lightBounds.min.z + kMargin) * view;
+}
+
 ShadowPass::ShadowPass()
     : fbo_   (kShadowMapSize, kShadowMapSize,
                std::span<const AttachmentSpec>{}, // depth-only
@@ -24,30 +83,24 @@ ShadowPass::ShadowPass()
                                 ASSET("shaders/shadow/shadow.frag")))
 {
     ENGINE_ASSERT(shader_.IsValid(), "ShadowPass: shadow shader failed to compile");
+
+    if (GpuCulling::IsSupported()) {
+        indirectShader_.emplace(Shader::FromFiles(ASSET("shaders/shadow/shadow_indirect.vert"),
+                                                  ASSET("shaders/shadow/shadow.frag")));
+        ENGINE_ASSERT(indirectShader_->IsValid(),
+                      "ShadowPass: indirect shadow shader failed to compile");
+    }
 }
 
-void ShadowPass::Execute(const RenderQueue&  queue,
-                         const PerFrameData& /*frameData*/,
-                         UniformBufferCache& ubos,
-                         const glm::vec3&    lightDir,
-                         const glm::vec3&    lightColor,
-                         float               lightIntensity)
+void ShadowPass::Execute(const RenderQueue&        queue,
+                         UniformBufferCache&       ubos,
+                         const InstanceBuffer&     instances,
+                         const glm::vec3&          lightDir,
+                         const glm::vec3&          lightColor,
+                         float                     lightIntensity,
+                         const IndirectDrawSource* indirect)
 {
-    // Orthographic light frustum sized to enclose the visible scene.
-    // Use a generous fixed extent for Phase 4; Phase 6 fits it tightly.
-    constexpr float kExtent = 8.f;
-    constexpr float kDepth  = 20.f;
-
-    const glm::vec3 up      = (std::abs(lightDir.y) < 0.99f)
-                                  ? glm::vec3(0.f, 1.f, 0.f)
-                                  : glm::vec3(1.f, 0.f, 0.f);
-    const glm::vec3 lightPos = -glm::normalize(lightDir) * (kDepth * 0.5f);
-
-    const glm::mat4 lightView  = glm::lookAt(lightPos, glm::vec3(0.f), up);
-    const glm::mat4 lightProj  = glm::ortho(-kExtent, kExtent,
-                                             -kExtent, kExtent,
-                                             0.1f, kDepth);
-    const glm::mat4 lightSpace = lightProj * lightView;
+    const glm::mat4 lightSpace = FitLightSpace(queue.ReceiverBounds(), queue.CasterBounds(), lightDir);
 
     // Upload ShadowData UBO
     ShadowData sd{};
@@ -66,22 +119,23 @@ void ShadowPass::Execute(const RenderQueue&  queue,
     glEnable(GL_DEPTH_TEST);
     glCullFace(GL_FRONT); // reduce peter-panning
 
-    shader_.Bind();
-
-    for (const RenderCommand& cmd : queue.ShadowCasters()) {
-        PerObjectData obj{};
-        obj.model        = cmd.modelMatrix;
-        obj.normalMatrix = cmd.normalMatrix;
-        ubos.UploadPerObject(obj);
-
-        glBindVertexArray(cmd.vaoID);
-        const void* indexOffset = reinterpret_cast<const void*>(
-            static_cast<std::uintptr_t>(cmd.baseIndex) * sizeof(std::uint32_t));
-        glDrawElementsBaseVertex(GL_TRIANGLES,
-                                 static_cast<GLsizei>(cmd.indexCount),
-                                 GL_UNSIGNED_INT,
-                                 indexOffset,
-                                 static_cast<GLint>(cmd.baseVertex));
+    if (indirect && indirectShader_) {
+        // With GPU culling, casters outside the light frustum were dropped
+        // by the cull shader.
+        indirectShader_->Bind();
+        indirect->DrawShadowCasters();
+    } else {
+        shader_.Bind();
+
+        // One instanced draw per run of casters sharing a mesh range.
+        const CommandView    casters = queue.ShadowCasters();
+        const RenderCommand* prev    = nullptr;
+        for (const InstanceBatch& batch : queue.ShadowBatches()) {
+            const RenderCommand& cmd = casters[batch.first];
+            if (!prev || cmd.vaoID != prev->vaoID) glBindVertexArray(cmd.vaoID);
+            prev = &cmd;
+            instances.Draw(cmd, batch, instances.ShadowBase());
+        }
     }
 
     glCullFace(GL_BACK);
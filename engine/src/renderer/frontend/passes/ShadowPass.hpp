@@ -4,18 +4,30 @@
 #include <renderer/backend/Shader.hpp>
 #include <renderer/frontend/UniformData.hpp>
 #include <renderer/frontend/RenderPass.hpp>
+#include <core/Geometry.hpp>
+#include <glm/mat4x4.hpp>
 #include <glm/vec3.hpp>
 #include <cstdint>
+#include <optional>
 
 namespace engine {
 
 class RenderQueue;
 class UniformBufferCache;
+class IndirectDrawSource;
+class InstanceBuffer;
 
 // ─── ShadowPass ───────────────────────────────────────────────────────────────
-// Renders all shadow-casting meshes into a 2048×2048 depth-only FBO from the
-// directional light's perspective. Computes the LightSpaceMatrix and uploads
-// it via the ShadowData UBO.
+// Renders RenderQueue::ShadowCasters into a 2048×2048 depth-only FBO from the
+// directional light's perspective. Computes the LightSpaceMatrix — an
+// orthographic frustum fitted to RenderQueue::ReceiverBounds, the receivers
+// the camera sees, with its near plane pulled back to the nearest caster — and
+// uploads it via the ShadowData UBO.
+//
+// Given an IndirectDrawSource for this frame (GpuCulling or the CPU-built
+// IndirectDrawBuilder), the casters are drawn with its single multi-draw
+// indirect call.  Otherwise (GL 4.1) each of the queue's shadow
+// InstanceBatches is one instanced draw.
 class ShadowPass {
 public:
     static constexpr std::uint32_t kShadowMapSize = 2048;
@@ -24,21 +36,36 @@ public:
 
     void OnResize(std::uint32_t /*w*/, std::uint32_t /*h*/) {}
 
+    // Orthographic light view-projection fitted to receivers: the light looks
+    // at their center from outside their bounding sphere, and the map covers
+    // their extent.  casters (may be invalid) only extend the depth range
+    // toward the light, so casters outside the receivers' view still land
+    // in front of the near plane.
+    static glm::mat4 FitLightSpace(const AABB&      receivers,
+                                   const AABB&      casters,
+                                   const glm::vec3& lightDir);
+
     // Execute the depth-only shadow render.
-    // Updates ubos with the computed ShadowData.
-    void Execute(const RenderQueue&  queue,
-                 const PerFrameData& frameData,
-                 UniformBufferCache& ubos,
-                 const glm::vec3&    lightDir,
-                 const glm::vec3&    lightColor,
-                 float               lightIntensity);
+    // Updates ubos with the computed ShadowData.  indirect may be null;
+    // instances must then hold this frame's upload of queue.
+    void Execute(const RenderQueue&        queue,
+                 UniformBufferCache&       ubos,
+                 const InstanceBuffer&     instances,
+                 const glm::vec3&          lightDir,
+                 const glm::vec3&          lightColor,
+                 float                     lightIntensity,
+                 const IndirectDrawSource* indirect = nullptr);
 
     const Texture& ShadowMap() const { return fbo_.GetDepthAttachment(); }
     Shader&        GetShader()       { return shader_; }
 
+    // Program for indirect draws; null when they are unsupported.
+    Shader*        GetIndirectShader() { return indirectShader_ ? &*indirectShader_ : nullptr; }
+
 private:
-    Framebuffer fbo_;
-    Shader      shader_;
+    Framebuffer           fbo_;
+    Shader                shader_;
+    std::optional<Shader> indirectShader_;
 };
 
 } // namespace engine
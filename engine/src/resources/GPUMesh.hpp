@@ -1,10 +1,12 @@
 #pragma once
 
 #include <core/Geometry.hpp>
+#include <resources/MeshLOD.hpp>
 #include <renderer/backend/Buffer.hpp>
 #include <renderer/backend/VertexArray.hpp>
 #include <glm/vec2.hpp>
 #include <glm/vec3.hpp>
+#include <array>
 #include <cstdint>
 #include <vector>
 
@@ -42,10 +44,23 @@ inline constexpr std::array<VertexAttribute, 4> kMeshVertexAttributes = {{
 // ─── RawMesh (CPU-side) ───────────────────────────────────────────────────────
 // Intermediate representation before upload to the GPU mega-buffer.
 // Produced by MeshLoader; consumed by ResourceManager::AddMesh.
+// Empty lods means a single level covering all indices.
 struct RawMesh {
     std::vector<MeshVertex>    vertices;
     std::vector<std::uint32_t> indices;
     AABB                       localBounds;
+    std::vector<MeshLOD>       lods;
+};
+
+// ─── OccluderMesh (CPU-side) ──────────────────────────────────────────────────
+// Positions and triangle indices kept in system memory for the software
+// occlusion rasterizer (core/Math/OcclusionBuffer).  Usually a much coarser
+// stand-in for the rendered mesh: it must lie inside what it stands for, or
+// it will hide geometry that should be visible.
+struct OccluderMesh {
+    std::vector<glm::vec3>     positions;
+    std::vector<std::uint32_t> indices;
+    AABB                       localBounds;
 };
 
 // ─── GPUMesh (GPU-side, lightweight) ─────────────────────────────────────────
@@ -56,9 +71,13 @@ struct GPUMesh {
     std::uint32_t sharedVAOID = 0;   // the ResourceManager's mega-buffer VAO
     std::uint32_t baseVertex  = 0;   // first vertex in the shared VBO
     std::uint32_t baseIndex   = 0;   // first index in the shared IBO
-    std::uint32_t indexCount  = 0;
+    std::uint32_t indexCount  = 0;   // level 0
     AABB          localBounds;
 
+    // Levels of detail; lods[0] is baseIndex / indexCount.
+    std::array<MeshLOD, kMaxMeshLODs> lods{};
+    std::uint32_t                     lodCount = 1;
+
     GPUMesh() = default;
     GPUMesh(GPUMesh&&) noexcept            = default;
     GPUMesh& operator=(GPUMesh&&) noexcept = default;
@@ -0,0 +1,127 @@
+#include <resources/MaterialTable.hpp>
+#include <core/Assert.hpp>
+#include <core/Log.hpp>
+
+#include <glad/gl.h>
+#include <algorithm>
+
+namespace engine {
+
+namespace {
+
+// Where a texture lives: layer of bucket.
+struct Slot {
+    std::uint32_t bucket = 0;
+    std::uint32_t layer  = 0;
+};
+
+// Textures that can share one array: same storage and same sampling.
+struct Bucket {
+    glm::uvec2                  size;
+    TextureFormat               format;
+    std::uint32_t               levels;
+    TextureFilter               minFilter;
+    TextureFilter               magFilter;
+    TextureWrap                 wrap;
+    std::vector<const Texture*> layers;
+};
+
+Slot Place(std::vector<Bucket>& buckets, const Texture& tex)
+{
+    const auto fits = [&](const Bucket& b) {
+        return b.size.x == tex.GetSize().x && b.size.y == tex.GetSize().y &&
+               b.format == tex.GetFormat() && b.levels == tex.GetMipLevels() &&
+               b.minFilter == tex.GetMinFilter() && b.magFilter == tex.GetMagFilter() &&
+               b.wrap == tex.GetWrap();
+    };
+    auto it = std::find_if(buckets.begin(), buckets.end(), fits);
+    if (it == buckets.end())
+        it = buckets.insert(buckets.end(), {tex.GetSize(), tex.GetFormat(), tex.GetMipLevels(),
+                                            tex.GetMinFilter(), tex.GetMagFilter(),
+                                            tex.GetWrap(), {}});
+    it->layers.push_back(&tex);
+    return {static_cast<std::uint32_t>(it - buckets.begin()),
+            static_cast<std::uint32_t>(it->layers.size() - 1)};
+}
+
+} // namespace
+
+bool MaterialTable::IsSupported()
+{
+#if defined(GL_VERSION_4_3)
+    return GLAD_GL_VERSION_4_3 != 0;
+#else
+    return false;   // GL 4.1 loader (macOS)
+#endif
+}
+
+void MaterialTable::Build(std::span<const Texture* const>  textures,
+                          std::span<const Material* const> materials,
+                          const Defaults&                  defaults)
+{
+    ENGINE_ASSERT(IsSupported(), "MaterialTable::Build needs GL 4.3");
+
+    // ── Bucket the textures ───────────────────────────────────────────────────
+    std::vector<Bucket> buckets;
+    std::vector<Slot>   slots(textures.size());
+    for (std::size_t i = 0; i < textures.size(); ++i)
+        if (textures[i] && textures[i]->IsValid()) slots[i] = Place(buckets, *textures[i]);
+    const Slot defaultAlbedo        = Place(buckets, *defaults.albedo);
+    const Slot defaultNormal        = Place(buckets, *defaults.normal);
+    const Slot defaultMetallicRough = Place(buckets, *defaults.metallicRough);
+
+    arrays_.clear();
+    arrays_.reserve(buckets.size());
+    for (const Bucket& bucket : buckets) {
+        TextureArray& array = arrays_.emplace_back(bucket.size,
+                                                   static_cast<std::uint32_t>(bucket.layers.size()),
+                                                   bucket.format, bucket.levels,
+                                                   bucket.minFilter, bucket.magFilter,
+                                                   bucket.wrap);
+        for (std::uint32_t layer = 0; layer < bucket.layers.size(); ++layer)
+            array.CopyLayer(layer, *bucket.layers[layer]);
+    }
+
+    // ── One GpuMaterial and TextureSet per material, then the default ─────────
+    const auto resolve = [&](std::uint32_t texIndex, const Slot& fallback) -> const Slot& {
+        const bool set = texIndex != kInvalidTexIndex && texIndex < textures.size() &&
+                         textures[texIndex] && textures[texIndex]->IsValid();
+        return set ? slots[texIndex] : fallback;
+    };
+
+    std::vector<GpuMaterial> upload;
+    upload.reserve(materials.size() + 1);
+    sets_.clear();
+    sets_.reserve(materials.size() + 1);
+    const Material defaultMaterial;
+    for (std::size_t i = 0; i <= materials.size(); ++i) {
+        const Material& mat = i < materials.size() && materials[i] ? *materials[i] : defaultMaterial;
+        const Slot& albedo        = resolve(mat.albedoTexIndex,     defaultAlbedo);
+        const Slot& normal        = resolve(mat.normalTexIndex,     defaultNormal);
+        const Slot& metallicRough = resolve(mat.metallicRoughIndex, defaultMetallicRough);
+
+        upload.push_back({glm::vec4(mat.albedoFactor, mat.metallicFactor), mat.roughnessFactor,
+                          albedo.layer, normal.layer, metallicRough.layer});
+        sets_.push_back({arrays_[albedo.bucket].GetID(), arrays_[normal.bucket].GetID(),
+                         arrays_[metallicRough.bucket].GetID()});
+    }
+
+    materials_.emplace(BufferTarget::ShaderStorage, BufferUsage::StaticDraw,
+                       upload.size() * sizeof(GpuMaterial), upload.data());
+
+    LOG_INFO("MaterialTable: {} materials sampling {} texture arrays",
+             materials.size(), arrays_.size());
+}
+
+const MaterialTable::TextureSet& MaterialTable::Textures(std::uint32_t materialID) const
+{
+    ENGINE_ASSERT(IsBuilt(), "MaterialTable::Textures before Build");
+    return sets_[std::min<std::size_t>(materialID, sets_.size() - 1)];
+}
+
+void MaterialTable::Bind() const
+{
+    if (materials_) materials_->BindBase(kBinding);
+}
+
+} // namespace engine
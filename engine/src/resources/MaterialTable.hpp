@@ -0,0 +1,89 @@
+#pragma once
+
+#include <resources/Material.hpp>
+#include <renderer/backend/Buffer.hpp>
+#include <renderer/backend/Texture.hpp>
+#include <glm/vec4.hpp>
+#include <compare>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace engine {
+
+// CPU-side mirror of GpuMaterial in common/materials.glsl (std430).
+struct alignas(16) GpuMaterial {
+    glm::vec4     albedoMetallic;       //  offset  0, size 16  (rgb albedo, a metallic)
+    float         roughnessFactor;      //  offset 16
+    std::uint32_t albedoLayer;          //  offset 20
+    std::uint32_t normalLayer;          //  offset 24
+    std::uint32_t metallicRoughLayer;   //  offset 28
+                                        //  total: 32 bytes
+};
+static_assert(sizeof(GpuMaterial) == 32,
+              "GpuMaterial size mismatch — std430 layout broken");
+
+// ─── MaterialTable ────────────────────────────────────────────────────────────
+// Every material's textures kept resident for the multi-draw paths.
+//
+// Textures are bucketed by size, format, mip count, filters and wrap; each
+// bucket is one GL_TEXTURE_2D_ARRAY holding its textures as layers, sampled
+// as they are on the 2D path.  Every material gets a GpuMaterial (factors
+// and its three layers) in one SSBO, indexed by the material's handle index,
+// and a TextureSet (the arrays it samples).  The indirect shaders find the
+// material through their instance, so draws whose materials sample the same
+// three arrays — every material whose textures share sizes and sampling — go
+// into one multi-draw.
+//
+// The entry past the last material is the default (fallback textures,
+// default factors); shaders clamp out-of-range indices to it, which covers
+// commands without a material.  ResourceManager rebuilds the table after
+// textures or materials are added.  Needs GL 4.3 (see IsSupported).
+class MaterialTable {
+public:
+    static constexpr std::uint32_t kBinding = 4;   // SSBO binding in materials.glsl
+
+    // Arrays a material samples; the batch key of the multi-draw paths.
+    struct TextureSet {
+        std::uint32_t albedoArrayID        = 0;
+        std::uint32_t normalArrayID        = 0;
+        std::uint32_t metallicRoughArrayID = 0;
+
+        auto operator<=>(const TextureSet&) const = default;
+    };
+
+    // Fallback textures for unset texture indices.
+    struct Defaults {
+        const Texture* albedo;
+        const Texture* normal;
+        const Texture* metallicRough;
+    };
+
+    // True when the current context can build the table.
+    static bool IsSupported();
+
+    // Rebuild from the texture and material pools, each indexed by handle
+    // index with null for free slots.
+    void Build(std::span<const Texture* const>  textures,
+               std::span<const Material* const> materials,
+               const Defaults&                  defaults);
+
+    bool IsBuilt() const { return !sets_.empty(); }
+
+    // Texture set of the material at handle index materialID; the default
+    // material's for indices past the table.
+    const TextureSet& Textures(std::uint32_t materialID) const;
+
+    // Bind the GpuMaterial SSBO at kBinding.
+    void Bind() const;
+
+    std::size_t ArrayCount() const { return arrays_.size(); }
+
+private:
+    std::vector<TextureArray> arrays_;
+    std::vector<TextureSet>   sets_;       // by material index, default last
+    std::optional<Buffer>     materials_;  // GpuMaterial[sets_.size()]
+};
+
+} // namespace engine
@@ -2,18 +2,39 @@
 #include <core/Assert.hpp>
 #include <core/Log.hpp>
 
+#include <numeric>
+#include <vector>
+
 namespace engine {
 
+namespace {
+
+std::vector<std::uint32_t> SequentialDrawIDs()
+{
+    std::vector<std::uint32_t> ids(MeshBuffer::kMaxDrawIDs);
+    std::iota(ids.begin(), ids.end(), 0u);
+    return ids;
+}
+
+} // namespace
+
 MeshBuffer::MeshBuffer()
     : vbo_(BufferTarget::Vertex, BufferUsage::DynamicDraw,
            static_cast<std::size_t>(kMaxVertices) * sizeof(MeshVertex))
     , ibo_(BufferTarget::Index,  BufferUsage::DynamicDraw,
            static_cast<std::size_t>(kMaxIndices)  * sizeof(std::uint32_t))
+    , drawIDs_(BufferTarget::Vertex, BufferUsage::StaticDraw,
+               static_cast<std::size_t>(kMaxDrawIDs) * sizeof(std::uint32_t),
+               SequentialDrawIDs().data())
 {
     // Attach the VBO and IBO to the shared VAO once; all meshes reuse this.
     vao_.AttachVertexBuffer(vbo_, std::span(kMeshVertexAttributes));
     vao_.AttachIndexBuffer(ibo_);
 
+    const VertexAttribute drawID{kDrawIDLocation, 1, VertexAttributeType::UnsignedInt, false,
+                                 static_cast<std::uint32_t>(sizeof(std::uint32_t)), 0, 1};
+    vao_.AttachVertexBuffer(drawIDs_, std::span(&drawID, 1));
+
     LOG_INFO("MeshBuffer: allocated {:.1f} MB VBO + {:.1f} MB IBO",
              static_cast<float>(kMaxVertices * sizeof(MeshVertex))  / (1024.f * 1024.f),
              static_cast<float>(kMaxIndices  * sizeof(std::uint32_t))/ (1024.f * 1024.f));
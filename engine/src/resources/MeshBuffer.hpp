@@ -15,6 +15,14 @@ namespace engine {
 //
 // All GPUMeshes share this VAO; draw calls use glDrawElementsBaseVertex to
 // address each mesh's slice of the shared buffers.
+//
+// The VAO also carries a per-instance draw ID at kDrawIDLocation, read from
+// a static 0, 1, 2, ... stream with divisor 1.  A single-instance draw with
+// baseInstance b therefore sees draw ID b, which is how the indirect draws of
+// GpuCulling find their instance data without gl_BaseInstance (GLSL 4.60).
+// Plain draws read element 0 and shaders that do not declare it ignore it;
+// InstanceBuffer disables it for instanced draws, whose base instances run
+// past the stream, and the indirect draws enable it again.
 class MeshBuffer {
 public:
     // Pre-allocate GPU storage for up to kMaxVertices / kMaxIndices.
@@ -38,10 +46,14 @@ public:
     // Capacities (compile-time; bump these if a scene overflows)
     static constexpr std::uint32_t kMaxVertices = 524288u;  // 512 K × 44 B = 22 MB
     static constexpr std::uint32_t kMaxIndices  = 1572864u; //  1.5 M × 4 B  =  6 MB
+    static constexpr std::uint32_t kMaxDrawIDs  = 65536u;   //   64 K × 4 B  = 256 KB
+
+    static constexpr std::uint32_t kDrawIDLocation = 4;
 
 private:
     Buffer      vbo_;
     Buffer      ibo_;
+    Buffer      drawIDs_;
     VertexArray vao_;
 
     std::uint32_t nextVertex_ = 0;
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace engine {
+
+// ─── MeshLOD ──────────────────────────────────────────────────────────────────
+// One level of detail: a range of a mesh's index list.  All levels share the
+// mesh's vertices.  A level is drawn while the mesh's bounding sphere covers
+// at least screenSize of the viewport height; levels run finest first with
+// falling thresholds, and the last one's is 0.
+struct MeshLOD {
+    std::uint32_t firstIndex = 0;     // RawMesh: into indices; GPUMesh: into the shared IBO
+    std::uint32_t indexCount = 0;
+    float         screenSize = 0.f;
+};
+
+inline constexpr std::size_t kMaxMeshLODs = 4;
+
+} // namespace engine
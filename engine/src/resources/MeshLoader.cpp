@@ -8,6 +8,10 @@
 #include <glm/vec3.hpp>
 #include <glm/vec2.hpp>
 
+#include <algorithm>
+#include <cstdint>
+#include <unordered_map>
+
 namespace engine {
 
 // ─── Assimp helper ────────────────────────────────────────────────────────────
@@ -71,14 +75,83 @@ std::vector<RawMesh> MeshLoader::Load(const std::filesystem::path& path)
 
     std::vector<RawMesh> result;
     result.reserve(scene->mNumMeshes);
-    for (unsigned i = 0; i < scene->mNumMeshes; ++i)
-        result.push_back(BuildRawMesh(scene->mMeshes[i]));
+    for (unsigned i = 0; i < scene->mNumMeshes; ++i) {
+        RawMesh& raw = result.emplace_back(BuildRawMesh(scene->mMeshes[i]));
+        if (raw.indices.size() / 3 >= kLODMinTriangles) GenerateLODs(raw);
+    }
 
     LOG_INFO("MeshLoader: loaded {} mesh(es) from '{}'",
              result.size(), path.string());
     return result;
 }
 
+// ─── Levels of detail ─────────────────────────────────────────────────────────
+
+namespace {
+
+// Grid cells along the longest bounds axis for level 1; each further level halves it.
+constexpr float kLODBaseGrid = 32.f;
+
+// Screen-height fraction at which each level starts being drawn (level 0
+// above kLODScreenSize[1], and so on); the coarsest level generated gets 0.
+constexpr float kLODScreenSize[kMaxMeshLODs] = {0.f, 0.25f, 0.1f, 0.04f};
+
+// A level must drop at least this fraction of the previous level's triangles.
+constexpr float kLODMinReduction = 0.2f;
+
+} // namespace
+
+void MeshLoader::GenerateLODs(RawMesh& mesh, std::uint32_t levelCount)
+{
+    const auto sourceCount = static_cast<std::uint32_t>(mesh.indices.size());
+    mesh.lods.assign(1, MeshLOD{0u, sourceCount, 0.f});
+    levelCount = std::min<std::uint32_t>(levelCount, kMaxMeshLODs);
+    if (sourceCount < 3 || !mesh.localBounds.IsValid()) return;
+
+    const glm::vec3 size    = mesh.localBounds.Size();
+    const float     longest = std::max({size.x, size.y, size.z, 1e-6f});
+
+    std::unordered_map<std::uint64_t, std::uint32_t> cellVertex;
+    std::vector<std::uint32_t> remap(mesh.vertices.size());
+
+    for (std::uint32_t level = 1; level < levelCount; ++level) {
+        // Every vertex maps to the first vertex that fell into its cell.
+        const float cells = kLODBaseGrid / static_cast<float>(1u << (level - 1));
+        const float scale = cells / longest;
+        cellVertex.clear();
+        for (std::uint32_t v = 0; v < mesh.vertices.size(); ++v) {
+            const glm::vec3 c = (mesh.vertices[v].position - mesh.localBounds.min) * scale;
+            const auto key = (static_cast<std::uint64_t>(c.x) << 42) |
+                             (static_cast<std::uint64_t>(c.y) << 21) |
+                              static_cast<std::uint64_t>(c.z);
+            remap[v] = cellVertex.try_emplace(key, v).first->second;
+        }
+
+        // Clustered from level 0, not the previous level, so error does not compound.
+        const auto first = static_cast<std::uint32_t>(mesh.indices.size());
+        for (std::uint32_t i = 0; i + 2 < sourceCount; i += 3) {
+            const std::uint32_t a = remap[mesh.indices[i]];
+            const std::uint32_t b = remap[mesh.indices[i + 1]];
+            const std::uint32_t c = remap[mesh.indices[i + 2]];
+            if (a == b || b == c || a == c) continue;
+            mesh.indices.insert(mesh.indices.end(), {a, b, c});
+        }
+        const auto count = static_cast<std::uint32_t>(mesh.indices.size()) - first;
+
+        const float previous = static_cast<float>(mesh.lods.back().indexCount);
+        if (count == 0 || static_cast<float>(count) > previous * (1.f - kLODMinReduction)) {
+            mesh.indices.resize(first);
+            break;
+        }
+        mesh.lods.push_back({first, count, 0.f});
+    }
+
+    // Each level is drawn above the next level's threshold; the last has none.
+    for (std::size_t i = 0; i + 1 < mesh.lods.size(); ++i)
+        mesh.lods[i].screenSize = kLODScreenSize[i + 1];
+    mesh.lods.back().screenSize = 0.f;
+}
+
 // ─── Procedural box ───────────────────────────────────────────────────────────
 
 static MeshVertex MV(float px, float py, float pz,
@@ -15,6 +15,15 @@ public:
 
     // Generate a unit box centred at the origin as CPU-side RawMesh data.
     static RawMesh CreateBox(float halfExtent = 0.5f);
+
+    // Append up to levelCount - 1 coarser levels of detail to mesh.indices
+    // by vertex clustering and describe all of them in mesh.lods.  Each level
+    // snaps vertices to a grid half as fine as the previous one's and drops
+    // the triangles that collapse; generation stops early once a level saves
+    // too little.  Load does this for meshes of kLODMinTriangles or more.
+    static void GenerateLODs(RawMesh& mesh, std::uint32_t levelCount = kMaxMeshLODs);
+
+    static constexpr std::size_t kLODMinTriangles = 1024;
 };
 
 } // namespace engine
@@ -2,6 +2,7 @@
 #include <resources/MeshLoader.hpp>
 #include <core/Log.hpp>
 
+#include <algorithm>
 #include <array>
 #include <cstdint>
 #include <filesystem>
@@ -40,10 +41,20 @@ MeshHandle ResourceManager::AddMesh(RawMesh raw)
     GPUMesh gpu;
     gpu.sharedVAOID = meshBuffer_.GetVAO();
     gpu.baseVertex  = alloc.baseVertex;
-    gpu.baseIndex   = alloc.baseIndex;
-    gpu.indexCount  = static_cast<std::uint32_t>(raw.indices.size());
     gpu.localBounds = raw.localBounds;
 
+    // LOD ranges move from the RawMesh's index list into the shared IBO.
+    if (raw.lods.empty())
+        raw.lods.push_back({0u, static_cast<std::uint32_t>(raw.indices.size()), 0.f});
+    gpu.lodCount = static_cast<std::uint32_t>(std::min(raw.lods.size(), kMaxMeshLODs));
+    for (std::uint32_t i = 0; i < gpu.lodCount; ++i) {
+        gpu.lods[i] = raw.lods[i];
+        gpu.lods[i].firstIndex += alloc.baseIndex;
+    }
+    gpu.lods[gpu.lodCount - 1].screenSize = 0.f;   // the coarsest level is the floor
+    gpu.baseIndex  = gpu.lods[0].firstIndex;
+    gpu.indexCount = gpu.lods[0].indexCount;
+
     return meshPool_.Insert(std::move(gpu));
 }
 
@@ -77,6 +88,27 @@ const GPUMesh& ResourceManager::GetMesh(MeshHandle handle) const
     return meshPool_.Get(handle);
 }
 
+// ─── Occluder ─────────────────────────────────────────────────────────────────
+
+OccluderHandle ResourceManager::AddOccluder(const RawMesh& raw)
+{
+    OccluderMesh occluder;
+    occluder.positions.reserve(raw.vertices.size());
+    for (const MeshVertex& v : raw.vertices) occluder.positions.push_back(v.position);
+    // Level 0 only: the coarser levels' triangles would be drawn twice.
+    const std::size_t first = raw.lods.empty() ? 0 : raw.lods[0].firstIndex;
+    const std::size_t count = raw.lods.empty() ? raw.indices.size() : raw.lods[0].indexCount;
+    occluder.indices.assign(raw.indices.begin() + static_cast<std::ptrdiff_t>(first),
+                            raw.indices.begin() + static_cast<std::ptrdiff_t>(first + count));
+    occluder.localBounds = raw.localBounds;
+    return occluderPool_.Insert(std::move(occluder));
+}
+
+const OccluderMesh& ResourceManager::GetOccluder(OccluderHandle handle) const
+{
+    return occluderPool_.Get(handle);
+}
+
 // ─── Texture ─────────────────────────────────────────────────────────────────
 
 TextureHandle ResourceManager::LoadTexture(const std::filesystem::path& path,
@@ -91,6 +123,7 @@ TextureHandle ResourceManager::LoadTexture(const std::filesystem::path& path,
 
     TextureHandle h = texturePool_.Insert(std::move(tex));
     textureCache_.emplace(key, h);
+    materialTableDirty_ = true;
     return h;
 }
 
@@ -103,6 +136,7 @@ const Texture& ResourceManager::GetTexture(TextureHandle handle) const
 
 MaterialHandle ResourceManager::CreateMaterial(const Material& mat)
 {
+    materialTableDirty_ = true;
     return materialPool_.Insert(mat);
 }
 
@@ -111,6 +145,25 @@ const Material& ResourceManager::GetMaterial(MaterialHandle handle) const
     return materialPool_.Get(handle);
 }
 
+// ─── Material table ───────────────────────────────────────────────────────────
+
+void ResourceManager::UpdateMaterialTable()
+{
+    if (!MaterialTable::IsSupported()) return;
+
+    if (materialTableDirty_) {
+        std::vector<const Texture*> textures(texturePool_.SlotCount(), nullptr);
+        texturePool_.ForEach([&](std::uint32_t i, const Texture& tex) { textures[i] = &tex; });
+        std::vector<const Material*> materials(materialPool_.SlotCount(), nullptr);
+        materialPool_.ForEach([&](std::uint32_t i, const Material& mat) { materials[i] = &mat; });
+
+        materialTable_.Build(textures, materials,
+                             {&defaultAlbedo_, &defaultNormal_, &defaultMetalRough_});
+        materialTableDirty_ = false;
+    }
+    materialTable_.Bind();
+}
+
 // ─── Shader hot-reload ────────────────────────────────────────────────────────
 
 void ResourceManager::RefreshTimestamps(ShaderRecord& rec)
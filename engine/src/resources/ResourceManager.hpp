@@ -3,6 +3,7 @@
 #include <core/Memory/HandlePool.hpp>
 #include <resources/GPUMesh.hpp>
 #include <resources/Material.hpp>
+#include <resources/MaterialTable.hpp>
 #include <resources/MeshBuffer.hpp>
 #include <renderer/backend/Texture.hpp>
 #include <renderer/backend/Shader.hpp>
@@ -16,8 +17,10 @@ namespace engine {
 // ─── Handle types ─────────────────────────────────────────────────────────────
 struct MeshTag    {};
 struct TextureTag {};
-using MeshHandle    = Handle<MeshTag>;
-using TextureHandle = Handle<TextureTag>;
+struct OccluderTag {};
+using MeshHandle     = Handle<MeshTag>;
+using TextureHandle  = Handle<TextureTag>;
+using OccluderHandle = Handle<OccluderTag>;
 
 // ─── ResourceManager ──────────────────────────────────────────────────────────
 // Central asset registry.
@@ -28,6 +31,9 @@ using TextureHandle = Handle<TextureTag>;
 //    monitor, then call PollShaderReload() once per frame.
 //  • Path-based caching: LoadMesh / LoadTexture return the cached handle when
 //    the same canonical path is requested more than once.
+//  • On GL 4.3+ the MaterialTable keeps every material's textures resident in
+//    texture arrays for the multi-draw paths; UpdateMaterialTable rebuilds it
+//    after textures or materials were added.
 class ResourceManager {
 public:
     ResourceManager();   // creates default textures, pre-allocates MeshBuffer
@@ -46,6 +52,14 @@ public:
 
     const GPUMesh& GetMesh(MeshHandle handle) const;
 
+    // ── Occluder ──────────────────────────────────────────────────────────────
+
+    // Keep a CPU copy of raw's positions and indices for software occlusion
+    // culling.  Nothing is uploaded; pass a simplified mesh where possible.
+    OccluderHandle AddOccluder(const RawMesh& raw);
+
+    const OccluderMesh& GetOccluder(OccluderHandle handle) const;
+
     // ── Texture ───────────────────────────────────────────────────────────────
 
     TextureHandle LoadTexture(const std::filesystem::path& path,
@@ -59,6 +73,15 @@ public:
     MaterialHandle CreateMaterial(const Material& mat);
     const Material& GetMaterial(MaterialHandle handle) const;
 
+    // Rebuild the material table if textures or materials were added since
+    // the last call, then bind its SSBO.  Call once per frame before
+    // rendering; a no-op without GL 4.3.
+    void UpdateMaterialTable();
+
+    // Resident material textures and parameters; built once
+    // UpdateMaterialTable has run on a GL 4.3 context.
+    const MaterialTable& GetMaterialTable() const { return materialTable_; }
+
     // Default 1×1 fallback textures (always valid after construction).
     const Texture& DefaultAlbedo()     const;
     const Texture& DefaultNormal()     const;
@@ -83,9 +106,10 @@ private:
     // ── Mesh mega-buffer ──────────────────────────────────────────────────────
     MeshBuffer meshBuffer_;
 
-    HandlePool<GPUMesh,   MeshTag>     meshPool_;
-    HandlePool<Texture,   TextureTag>  texturePool_;
-    HandlePool<Material,  MaterialTag> materialPool_;
+    HandlePool<GPUMesh,      MeshTag>     meshPool_;
+    HandlePool<Texture,      TextureTag>  texturePool_;
+    HandlePool<Material,     MaterialTag> materialPool_;
+    HandlePool<OccluderMesh, OccluderTag> occluderPool_;
 
     std::unordered_map<std::string, MeshHandle>    meshCache_;
     std::unordered_map<std::string, TextureHandle> textureCache_;
@@ -95,6 +119,10 @@ private:
     Texture defaultNormal_;
     Texture defaultMetalRough_;
 
+    // ── Material table ────────────────────────────────────────────────────────
+    MaterialTable materialTable_;
+    bool          materialTableDirty_ = true;
+
     // ── Shader hot-reload tracking ────────────────────────────────────────────
     struct ShaderRecord {
         Shader*                                          shader;
@@ -21,8 +21,7 @@ void Scene::SetupOrbitBoxDemo(ResourceManager& rm)
 
     // ── Box entity ────────────────────────────────────────────────────────────
     boxEntity_ = registry.CreateEntity();
-    auto& tc = registry.AddComponent<TransformComponent>(boxEntity_);
-    tc.dirty = true;
+    registry.AddComponent<TransformComponent>(boxEntity_);
 
     // Create a PBR material: warm orange, non-metallic, moderately rough.
     Material mat;
@@ -31,17 +30,21 @@ void Scene::SetupOrbitBoxDemo(ResourceManager& rm)
     mat.roughnessFactor = 0.75f;
     const MaterialHandle matHandle = rm.CreateMaterial(mat);
 
+    const RawMesh boxMesh = MeshLoader::CreateBox(0.5f);
     auto& mc = registry.AddComponent<MeshComponent>(boxEntity_);
-    mc.meshHandle    = rm.AddMesh(MeshLoader::CreateBox(0.5f)).index;  // RawMesh → mega-buffer
+    mc.meshHandle    = rm.AddMesh(boxMesh).index;  // RawMesh → mega-buffer
     mc.materialHandle = matHandle.index;
     mc.visible       = true;
     mc.castsShadow   = true;
 
+    // The box is solid, so its own mesh is an exact occluder.
+    registry.AddComponent<OccluderComponent>(boxEntity_).occluderHandle =
+        rm.AddOccluder(boxMesh).index;
+
     // Camera entity
     cameraEntity_ = registry.CreateEntity();
     auto& camTc = registry.AddComponent<TransformComponent>(cameraEntity_);
     camTc.position = ComputeOrbitPosition();
-    camTc.dirty    = true;
 
     auto& cc = registry.AddComponent<CameraComponent>(cameraEntity_);
     cc.fovY      = 60.f;
@@ -67,7 +70,7 @@ glm::vec3 Scene::ComputeOrbitPosition() const
 // ─── Update ───────────────────────────────────────────────────────────────────
 
 std::optional<PerFrameData> Scene::Update(float time, float deltaTime,
-                                          const Window& window)
+                                          const Window& window, JobSystem& jobs)
 {
     // ── Orbit camera input ────────────────────────────────────────────────────
     const glm::vec2 mousePos = window.GetMousePosition();
@@ -87,17 +90,18 @@ std::optional<PerFrameData> Scene::Update(float time, float deltaTime,
     }
     prevMousePos_ = mousePos;
 
-    // Update camera entity position from orbit state
+    // Update camera entity position from orbit state.  Patch only on an actual
+    // move so an idle camera is skipped by change-filtered systems.
     if (cameraEntity_ != INVALID_ENTITY &&
         registry.HasComponent<TransformComponent>(cameraEntity_))
     {
-        auto& ct      = registry.GetComponent<TransformComponent>(cameraEntity_);
-        ct.position   = ComputeOrbitPosition();
-        ct.dirty      = true;
+        const glm::vec3 orbitPos = ComputeOrbitPosition();
+        if (registry.GetComponent<TransformComponent>(cameraEntity_).position != orbitPos)
+            registry.Patch<TransformComponent>(cameraEntity_).position = orbitPos;
     }
 
     // ── Systems ───────────────────────────────────────────────────────────────
-    TransformSystem::Update(registry);
+    transforms_.Update(registry, jobs);
 
     // Compute a pole-safe up vector.  When pitch approaches ±90° the standard
     // world-up (0,1,0) becomes nearly parallel to the view direction, making
@@ -2,6 +2,8 @@
 
 #include <scene/ecs/Registry.hpp>
 #include <scene/ecs/Components.hpp>
+#include <scene/systems/RenderSystem.hpp>
+#include <scene/systems/TransformSystem.hpp>
 #include <renderer/frontend/UniformData.hpp>
 #include <resources/ResourceManager.hpp>
 #include <platform/Window.hpp>
@@ -11,12 +13,16 @@
 
 namespace engine {
 
+class JobSystem;
+
 // Scene owns the ECS registry and orchestrates system updates each frame.
 //
 // Orbit camera: hold LMB + drag to orbit; scroll (or pinch) to zoom.
 class Scene {
 public:
-    Registry registry;
+    Registry     registry;
+    BoundsTree   bounds;         // world bounds of mesh entities; see RenderSystem
+    RenderSystem renderSystem;   // gathers draws from bounds for the main view
 
     // Set up a demo scene:
     //   • One PBR box entity at the origin.
@@ -25,8 +31,9 @@ public:
     void SetupOrbitBoxDemo(ResourceManager& rm);
 
     // Update ECS, orbit input, and systems. Returns PerFrameData or nullopt if
-    // no primary camera exists.
-    std::optional<PerFrameData> Update(float time, float deltaTime, const Window& window);
+    // no primary camera exists.  Parallel systems run on `jobs`.
+    std::optional<PerFrameData> Update(float time, float deltaTime, const Window& window,
+                                       JobSystem& jobs);
 
     // Directional light parameters (read by Application to build FrameContext).
     glm::vec3 GetLightDir()       const { return lightDir_;       }
@@ -42,6 +49,8 @@ public:
     EntityID BoxEntity()    const { return boxEntity_;    }
 
 private:
+    TransformSystem transforms_;
+
     // Orbit state
     float     orbitYaw_    =  30.f;
     float     orbitPitch_  =  20.f;
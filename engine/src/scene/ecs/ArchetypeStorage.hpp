@@ -0,0 +1,581 @@
+#pragma once
+
+#include <scene/ecs/Entity.hpp>
+#include <scene/ecs/ComponentType.hpp>
+#include <scene/ecs/QueryFilter.hpp>
+#include <core/Assert.hpp>
+#include <core/Jobs/JobSystem.hpp>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace engine {
+
+// ─── ComponentColumn ──────────────────────────────────────────────────────────
+// Densely packed array of one component type inside an archetype.  The base
+// class exposes only the operations needed to move rows between archetypes, so
+// the storage never has to know T outside of the templated accessors.
+//
+// The change ticks of each row are type-independent and live in the base, so
+// query filters can test them without knowing T.
+class IComponentColumn {
+public:
+    virtual ~IComponentColumn() = default;
+
+    std::vector<ChangeTick> added;     // row → tick the component was added
+    std::vector<ChangeTick> changed;   // row → tick the component last changed
+
+    // A new, empty column of the same component type.
+    virtual std::unique_ptr<IComponentColumn> CloneEmpty() const = 0;
+
+    // Move-append element `row` onto the end of dst (which must hold the same
+    // component type).  The moved-from element stays in place until SwapRemove.
+    virtual void MoveRowTo(std::uint32_t row, IComponentColumn& dst) = 0;
+
+    // Destroy element `row`, filling the hole with the last element.
+    virtual void SwapRemove(std::uint32_t row) = 0;
+};
+
+template<typename T>
+class ComponentColumn final : public IComponentColumn {
+public:
+    std::vector<T> data;
+
+    std::unique_ptr<IComponentColumn> CloneEmpty() const override
+    {
+        return std::make_unique<ComponentColumn<T>>();
+    }
+
+    void Push(T component, ChangeTick tick)
+    {
+        data.push_back(std::move(component));
+        added.push_back(tick);
+        changed.push_back(tick);
+    }
+
+    void MoveRowTo(std::uint32_t row, IComponentColumn& dst) override
+    {
+        static_cast<ComponentColumn<T>&>(dst).data.push_back(std::move(data[row]));
+        dst.added.push_back(added[row]);
+        dst.changed.push_back(changed[row]);
+    }
+
+    void SwapRemove(std::uint32_t row) override
+    {
+        if (row + 1u != data.size()) {
+            data[row]    = std::move(data.back());
+            added[row]   = added.back();
+            changed[row] = changed.back();
+        }
+        data.pop_back();
+        added.pop_back();
+        changed.pop_back();
+    }
+};
+
+// ─── Archetype ────────────────────────────────────────────────────────────────
+// All entities that own exactly the same set of component types.  Row i of
+// every column belongs to entities[i], so iterating an archetype is a linear
+// walk over parallel arrays.
+struct Archetype {
+    static constexpr std::int8_t   kNoColumn = -1;
+    static constexpr std::uint32_t kNoEdge   = std::numeric_limits<std::uint32_t>::max();
+
+    ComponentMask                                  mask;
+    std::vector<EntityID>                          entities;   // row → entity
+    std::vector<std::unique_ptr<IComponentColumn>> columns;
+    std::vector<ComponentTypeID>                   types;      // column → type ID
+
+    // type ID → column index (kNoColumn when absent).  A flat table keeps the
+    // per-query column lookup to one array read.
+    std::array<std::int8_t, kMaxComponentTypes> columnOf;
+
+    // Cached archetype transitions: index of the archetype reached by adding /
+    // removing component N, or kNoEdge if not resolved yet.
+    std::array<std::uint32_t, kMaxComponentTypes> addEdge;
+    std::array<std::uint32_t, kMaxComponentTypes> removeEdge;
+
+    Archetype()
+    {
+        columnOf.fill(kNoColumn);
+        addEdge.fill(kNoEdge);
+        removeEdge.fill(kNoEdge);
+    }
+
+    std::uint32_t Size() const { return static_cast<std::uint32_t>(entities.size()); }
+
+    template<typename T>
+    T* Data()
+    {
+        const std::int8_t col = columnOf[ComponentType<T>()];
+        return static_cast<ComponentColumn<T>&>(*columns[col]).data.data();
+    }
+
+    template<typename T>
+    const T* Data() const
+    {
+        const std::int8_t col = columnOf[ComponentType<T>()];
+        return static_cast<const ComponentColumn<T>&>(*columns[col]).data.data();
+    }
+
+    template<typename T>
+    ComponentColumn<T>& Column()
+    {
+        return static_cast<ComponentColumn<T>&>(*columns[columnOf[ComponentType<T>()]]);
+    }
+
+    void AddColumn(ComponentTypeID type, std::unique_ptr<IComponentColumn> column)
+    {
+        columnOf[type] = static_cast<std::int8_t>(columns.size());
+        columns.push_back(std::move(column));
+        types.push_back(type);
+        mask.set(type);
+    }
+};
+
+// ─── ArchetypeStorage ─────────────────────────────────────────────────────────
+// Component storage backend that groups entities by component set.  Adding or
+// removing a component moves the entity's row to the matching archetype;
+// Each<Ts...> visits only archetypes whose mask contains Ts and walks their
+// packed columns.
+//
+// Any structural change (Create, Destroy, Emplace of a new type, Remove) may
+// move rows, invalidating previously returned component references.
+class ArchetypeStorage {
+public:
+    ArchetypeStorage()
+    {
+        // Archetype 0 is the empty set — freshly created entities live here.
+        archetypes_.push_back(std::make_unique<Archetype>());
+        archetypeIndex_.emplace(ComponentMask{}, 0u);
+    }
+
+    ArchetypeStorage(const ArchetypeStorage&)            = delete;
+    ArchetypeStorage& operator=(const ArchetypeStorage&) = delete;
+
+    // ── Entities ──────────────────────────────────────────────────────────────
+
+    void Create(EntityID id)
+    {
+        if (id.index >= records_.size()) records_.resize(static_cast<std::size_t>(id.index) + 1u);
+        Archetype& root = *archetypes_[0];
+        records_[id.index] = Record{0u, root.Size()};
+        root.entities.push_back(id);
+    }
+
+    void Destroy(EntityID id)
+    {
+        const Record rec = records_[id.index];
+        RemoveRow(*archetypes_[rec.archetype], rec.row);
+        records_[id.index] = Record{};
+    }
+
+    bool Contains(EntityID id) const
+    {
+        return id.index < records_.size() && records_[id.index].archetype != kNoArchetype;
+    }
+
+    // ── Components ────────────────────────────────────────────────────────────
+
+    template<typename T>
+    T& Emplace(EntityID id, T component)
+    {
+        const ComponentTypeID type = ComponentType<T>();
+        const Record          rec  = records_[id.index];
+
+        Archetype& src = *archetypes_[rec.archetype];
+        if (src.mask.test(type)) {
+            auto& column = src.Column<T>();
+            column.changed[rec.row] = tick_;
+            T& slot = column.data[rec.row];
+            slot    = std::move(component);
+            return slot;
+        }
+
+        const std::uint32_t dstIndex = AddTransition(rec.archetype, type,
+            [] { return std::make_unique<ComponentColumn<T>>(); });
+        Archetype& dst = *archetypes_[dstIndex];
+
+        const std::uint32_t newRow = MoveRow(id, src, rec.row, dst);
+        auto& column = dst.Column<T>();
+        column.Push(std::move(component), tick_);
+        records_[id.index] = Record{dstIndex, newRow};
+        return column.data.back();
+    }
+
+    template<typename T>
+    void Remove(EntityID id)
+    {
+        const ComponentTypeID type = ComponentType<T>();
+        const Record          rec  = records_[id.index];
+
+        Archetype& src = *archetypes_[rec.archetype];
+        if (!src.mask.test(type)) return;
+
+        const std::uint32_t dstIndex = RemoveTransition(rec.archetype, type);
+        const std::uint32_t newRow   = MoveRow(id, src, rec.row, *archetypes_[dstIndex]);
+        records_[id.index] = Record{dstIndex, newRow};
+    }
+
+    // Stamp T on id as changed at the current tick.  Touches only that row, so
+    // it is safe from inside a (parallel) walk that visits id.
+    template<typename T>
+    void MarkChanged(EntityID id)
+    {
+        const Record rec = records_[id.index];
+        archetypes_[rec.archetype]->Column<T>().changed[rec.row] = tick_;
+    }
+
+    template<typename T>
+    bool Has(EntityID id) const
+    {
+        if (!Contains(id)) return false;
+        return archetypes_[records_[id.index].archetype]->mask.test(ComponentType<T>());
+    }
+
+    template<typename T>
+    T& Get(EntityID id)
+    {
+        const Record rec = records_[id.index];
+        return archetypes_[rec.archetype]->Data<T>()[rec.row];
+    }
+
+    template<typename T>
+    const T& Get(EntityID id) const
+    {
+        const Record rec = records_[id.index];
+        return std::as_const(*archetypes_[rec.archetype]).Data<T>()[rec.row];
+    }
+
+    // ── Iteration ─────────────────────────────────────────────────────────────
+
+    template<typename... Ts, typename Fn>
+    void Each(Fn&& fn)
+    {
+        const ComponentMask required = MakeComponentMask<Ts...>();
+        for (const auto& arch : archetypes_)
+            if ((arch->mask & required) == required) Walk<Ts...>(*arch, fn);
+    }
+
+    template<typename... Ts, typename Fn>
+    void Each(Fn&& fn) const
+    {
+        const ComponentMask required = MakeComponentMask<Ts...>();
+        for (const auto& arch : archetypes_)
+            if ((arch->mask & required) == required)
+                Walk<Ts...>(std::as_const(*arch), fn);
+    }
+
+    // ── Cached queries ────────────────────────────────────────────────────────
+    // A query caches the archetypes whose mask contains its required set.  The
+    // list is extended whenever a new archetype is created, and entities join
+    // or leave a query implicitly as Emplace/Remove/Destroy move their rows,
+    // so iterating a query never tests a mask.
+    //
+    // A filtered query (Changed/Added terms) additionally tests the change
+    // ticks of the filtered columns row by row and advances its cursor after
+    // every run.
+
+    struct QueryState {
+        ComponentMask           required;
+        ComponentMask           changed;
+        ComponentMask           added;
+        ChangeTick              lastRun = 0;   // rows stamped >= lastRun are new
+        std::vector<Archetype*> archetypes;
+
+        bool Filtered() const { return changed.any() || added.any(); }
+    };
+
+    // Returns the state for `key`, creating it on first request.
+    QueryState& RegisterQuery(const QueryKey& key)
+    {
+        if (auto it = queryIndex_.find(key); it != queryIndex_.end())
+            return *it->second;
+
+        auto state = std::make_unique<QueryState>();
+        state->required = key.required;
+        state->changed  = key.changed;
+        state->added    = key.added;
+        for (const auto& arch : archetypes_)
+            if ((arch->mask & key.required) == key.required)
+                state->archetypes.push_back(arch.get());
+
+        QueryState& ref = *state;
+        queryIndex_.emplace(key, state.get());
+        queries_.push_back(std::move(state));
+        return ref;
+    }
+
+    template<typename... Ts, typename Fn>
+    void EachInQuery(QueryState& state, Fn&& fn)
+    {
+        if (!state.Filtered()) {
+            for (Archetype* arch : state.archetypes) Walk<Ts...>(*arch, fn);
+            return;
+        }
+
+        for (Archetype* arch : state.archetypes)
+            WalkRows<Ts...>(*arch, 0u, arch->Size(), fn, RowFilter(*arch, state));
+        Advance(state);
+    }
+
+    // Split each matching archetype into row ranges of at most `grain` and run
+    // them on the job system.  Chunks never straddle archetypes, so every job
+    // walks plain column pointers exactly like EachInQuery.
+    template<typename... Ts, typename Fn>
+    void ParallelEachInQuery(JobSystem& jobs, QueryState& state, Fn& fn,
+                             std::uint32_t grain)
+    {
+        grain = std::max(grain, 1u);
+        const auto chunksOf = [grain](const Archetype& arch) {
+            return (arch.Size() + grain - 1u) / grain;
+        };
+
+        std::uint32_t chunks = 0;
+        for (const Archetype* arch : state.archetypes) chunks += chunksOf(*arch);
+
+        jobs.ParallelFor(chunks, 1u, [&](std::uint32_t first, std::uint32_t last) {
+            for (std::uint32_t chunk = first; chunk < last; ++chunk) {
+                // Matching archetypes per query are few; a linear walk to the
+                // owning archetype is cheaper than building a prefix table.
+                std::uint32_t local = chunk;
+                for (Archetype* arch : state.archetypes) {
+                    const std::uint32_t n = chunksOf(*arch);
+                    if (local < n) {
+                        const std::uint32_t begin = local * grain;
+                        const std::uint32_t end   = std::min(begin + grain, arch->Size());
+                        if (state.Filtered())
+                            WalkRows<Ts...>(*arch, begin, end, fn, RowFilter(*arch, state));
+                        else
+                            WalkRows<Ts...>(*arch, begin, end, fn);
+                        break;
+                    }
+                    local -= n;
+                }
+            }
+        });
+
+        if (state.Filtered()) Advance(state);
+    }
+
+    // Move a filtered query's cursor to now without visiting anything.
+    void ConsumeQuery(QueryState& state) { Advance(state); }
+
+    std::size_t QueryCount(const QueryState& state) const
+    {
+        std::size_t count = 0;
+        for (const Archetype* arch : state.archetypes) count += arch->Size();
+        return count;
+    }
+
+    std::size_t ArchetypeCount() const { return archetypes_.size(); }
+
+private:
+    static constexpr std::uint32_t kNoArchetype = std::numeric_limits<std::uint32_t>::max();
+
+    struct Record {
+        std::uint32_t archetype = kNoArchetype;
+        std::uint32_t row       = 0;
+    };
+
+    std::vector<std::unique_ptr<Archetype>>          archetypes_;
+    std::unordered_map<ComponentMask, std::uint32_t> archetypeIndex_;
+    std::vector<Record>                              records_;   // indexed by entity slot
+
+    std::vector<std::unique_ptr<QueryState>>                queries_;
+    std::unordered_map<QueryKey, QueryState*, QueryKeyHash> queryIndex_;
+
+    ChangeTick tick_ = 1;   // stamped into every add / change
+
+    // Per-archetype view of a filtered query: the tick columns of its Changed
+    // and Added types, tested against the query's cursor.
+    class RowFilter {
+    public:
+        static constexpr std::uint32_t kMaxTerms = 8;
+
+        RowFilter(const Archetype& arch, const QueryState& state)
+            : since_(state.lastRun)
+        {
+            for (std::size_t i = 0; i < arch.types.size(); ++i) {
+                const ComponentTypeID type = arch.types[i];
+                if (state.changed.test(type)) {
+                    ENGINE_ASSERT(changedCount_ < kMaxTerms, "RowFilter: too many Changed<> types");
+                    changed_[changedCount_++] = arch.columns[i]->changed.data();
+                }
+                if (state.added.test(type)) {
+                    ENGINE_ASSERT(addedCount_ < kMaxTerms, "RowFilter: too many Added<> types");
+                    added_[addedCount_++] = arch.columns[i]->added.data();
+                }
+            }
+        }
+
+        bool Passes(std::uint32_t row) const
+        {
+            return AnyNewer(changed_, changedCount_, row) &&
+                   AnyNewer(added_,   addedCount_,   row);
+        }
+
+    private:
+        std::array<const ChangeTick*, kMaxTerms> changed_{};
+        std::array<const ChangeTick*, kMaxTerms> added_{};
+        std::uint32_t                            changedCount_ = 0;
+        std::uint32_t                            addedCount_   = 0;
+        ChangeTick                               since_;
+
+        // True when no term of this kind exists, or any of them is new.
+        bool AnyNewer(const std::array<const ChangeTick*, kMaxTerms>& ticks,
+                      std::uint32_t count, std::uint32_t row) const
+        {
+            if (count == 0) return true;
+            for (std::uint32_t i = 0; i < count; ++i)
+                if (ticks[i][row] >= since_) return true;
+            return false;
+        }
+    };
+
+    // Close a filtered run: everything stamped so far is now old for this
+    // query, and later stamps are new.
+    void Advance(QueryState& state) { state.lastRun = ++tick_; }
+
+    // Call fn(EntityID, Ts&...) for every row of arch.
+    template<typename... Ts, typename Fn>
+    static void Walk(Archetype& arch, Fn& fn)
+    {
+        WalkRows<Ts...>(arch, 0u, arch.Size(), fn);
+    }
+
+    // Call fn(EntityID, Ts&...) for rows [begin, end) of arch.
+    template<typename... Ts, typename Fn>
+    static void WalkRows(Archetype& arch, std::uint32_t begin, std::uint32_t end, Fn& fn)
+    {
+        if (begin >= end) return;
+        const EntityID* ids = arch.entities.data();
+        [&](Ts*... data) {
+            for (std::uint32_t i = begin; i < end; ++i) fn(ids[i], data[i]...);
+        }(arch.Data<Ts>()...);
+    }
+
+    // As above, skipping rows the filter rejects.
+    template<typename... Ts, typename Fn>
+    static void WalkRows(Archetype& arch, std::uint32_t begin, std::uint32_t end, Fn& fn,
+                         const RowFilter& filter)
+    {
+        if (begin >= end) return;
+        const EntityID* ids = arch.entities.data();
+        [&](Ts*... data) {
+            for (std::uint32_t i = begin; i < end; ++i)
+                if (filter.Passes(i)) fn(ids[i], data[i]...);
+        }(arch.Data<Ts>()...);
+    }
+
+    template<typename... Ts, typename Fn>
+    static void Walk(const Archetype& arch, Fn& fn)
+    {
+        const EntityID*     ids = arch.entities.data();
+        const std::uint32_t n   = arch.Size();
+        if (n == 0) return;
+        [&](const Ts*... data) {
+            for (std::uint32_t i = 0; i < n; ++i) fn(ids[i], data[i]...);
+        }(arch.Data<Ts>()...);
+    }
+
+    // Archetype reached from `from` by adding `type`; created on first use.
+    template<typename MakeColumn>
+    std::uint32_t AddTransition(std::uint32_t from, ComponentTypeID type,
+                                MakeColumn&& makeColumn)
+    {
+        const std::uint32_t cached = archetypes_[from]->addEdge[type];
+        if (cached != Archetype::kNoEdge) return cached;
+
+        ComponentMask mask = archetypes_[from]->mask;
+        mask.set(type);
+
+        std::uint32_t to = 0;
+        if (auto it = archetypeIndex_.find(mask); it != archetypeIndex_.end()) {
+            to = it->second;
+        } else {
+            auto arch = std::make_unique<Archetype>();
+            const Archetype& src = *archetypes_[from];
+            for (std::size_t i = 0; i < src.columns.size(); ++i)
+                arch->AddColumn(src.types[i], src.columns[i]->CloneEmpty());
+            arch->AddColumn(type, makeColumn());
+            to = Register(std::move(arch));
+        }
+
+        archetypes_[from]->addEdge[type] = to;
+        archetypes_[to]->removeEdge[type] = from;
+        return to;
+    }
+
+    // Archetype reached from `from` by removing `type`; created on first use.
+    std::uint32_t RemoveTransition(std::uint32_t from, ComponentTypeID type)
+    {
+        const std::uint32_t cached = archetypes_[from]->removeEdge[type];
+        if (cached != Archetype::kNoEdge) return cached;
+
+        ComponentMask mask = archetypes_[from]->mask;
+        mask.reset(type);
+
+        std::uint32_t to = 0;
+        if (auto it = archetypeIndex_.find(mask); it != archetypeIndex_.end()) {
+            to = it->second;
+        } else {
+            auto arch = std::make_unique<Archetype>();
+            const Archetype& src = *archetypes_[from];
+            for (std::size_t i = 0; i < src.columns.size(); ++i)
+                if (src.types[i] != type)
+                    arch->AddColumn(src.types[i], src.columns[i]->CloneEmpty());
+            to = Register(std::move(arch));
+        }
+
+        archetypes_[from]->removeEdge[type] = to;
+        archetypes_[to]->addEdge[type] = from;
+        return to;
+    }
+
+    std::uint32_t Register(std::unique_ptr<Archetype> arch)
+    {
+        const auto index = static_cast<std::uint32_t>(archetypes_.size());
+        archetypeIndex_.emplace(arch->mask, index);
+        for (auto& query : queries_)
+            if ((arch->mask & query->required) == query->required)
+                query->archetypes.push_back(arch.get());
+        archetypes_.push_back(std::move(arch));
+        return index;
+    }
+
+    // Move every component dst also has from src[row] to the end of dst, then
+    // remove the row from src.  Returns the entity's row in dst.  The caller
+    // appends any component dst has that src lacks and updates the record.
+    std::uint32_t MoveRow(EntityID id, Archetype& src, std::uint32_t row, Archetype& dst)
+    {
+        for (std::size_t i = 0; i < src.columns.size(); ++i) {
+            const std::int8_t dstCol = dst.columnOf[src.types[i]];
+            if (dstCol != Archetype::kNoColumn)
+                src.columns[i]->MoveRowTo(row, *dst.columns[dstCol]);
+        }
+        const std::uint32_t newRow = dst.Size();
+        dst.entities.push_back(id);
+        RemoveRow(src, row);
+        return newRow;
+    }
+
+    // Swap-remove `row` from arch, patching the record of the entity that was
+    // moved into the hole.
+    void RemoveRow(Archetype& arch, std::uint32_t row)
+    {
+        for (auto& column : arch.columns) column->SwapRemove(row);
+
+        const EntityID moved = arch.entities.back();
+        arch.entities[row]   = moved;
+        arch.entities.pop_back();
+        if (row < arch.Size()) records_[moved.index].row = row;
+    }
+};
+
+} // namespace engine
@@ -0,0 +1,236 @@
+#pragma once
+
+#include <core/Assert.hpp>
+#include <core/Jobs/JobSystem.hpp>
+#include <scene/ecs/Entity.hpp>
+#include <scene/ecs/Registry.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace engine {
+
+// ─── BasicCommandBuffer ───────────────────────────────────────────────────────
+// Records structural changes — create / destroy entity, add / remove
+// component — for later playback, so they can be issued from inside Each,
+// ParallelEach or any other job where touching the registry's structure is
+// not allowed.  Flush replays them in recording order at a sync point.
+//
+// A buffer is single-threaded; parallel systems use one per thread through
+// BasicCommandBufferSet, which needs no locks.
+//
+//   query.ParallelEach(jobs, [&](EntityID id, const HealthComponent& hp) {
+//       if (hp.value <= 0.f) commands.Local().DestroyEntity(id);
+//   });
+//   commands.Flush(registry);   // ParallelEach has returned: safe point
+//
+// Playback rules:
+//   - CreateEntity returns a deferred ID.  It may be used with the other
+//     commands of the same buffer, which Flush resolves to the real entity,
+//     but it is not alive in the registry and means nothing to other buffers
+//     or when stored in components.
+//   - Commands aimed at an entity that is no longer alive when they play back
+//     (destroyed by an earlier command, another buffer or a stale ID) are
+//     skipped, so independent systems may race to despawn the same entity.
+//
+// Component values are moved into block storage owned by the buffer; blocks
+// are kept across Flush, so steady-state recording does not allocate.
+template<typename Storage>
+class alignas(64) BasicCommandBuffer {
+public:
+    using RegistryType = BasicRegistry<Storage>;
+
+    BasicCommandBuffer() = default;
+    ~BasicCommandBuffer() { Clear(); }
+
+    BasicCommandBuffer(const BasicCommandBuffer&)            = delete;
+    BasicCommandBuffer& operator=(const BasicCommandBuffer&) = delete;
+    BasicCommandBuffer(BasicCommandBuffer&&)                 = default;
+    BasicCommandBuffer& operator=(BasicCommandBuffer&&)      = delete;
+
+    // ── Recording ─────────────────────────────────────────────────────────────
+
+    EntityID CreateEntity()
+    {
+        const EntityID id{createdCount_++, kDeferredGeneration};
+        commands_.push_back({Op::Create, id, nullptr, nullptr, nullptr});
+        return id;
+    }
+
+    void DestroyEntity(EntityID id)
+    {
+        commands_.push_back({Op::Destroy, id, nullptr, nullptr, nullptr});
+    }
+
+    template<typename T>
+    void AddComponent(EntityID id, T component = {})
+    {
+        void* payload = new (Allocate(sizeof(T), alignof(T))) T(std::move(component));
+        commands_.push_back({Op::Component, id, payload,
+            [](RegistryType& registry, EntityID e, void* p) {
+                registry.template AddComponent<T>(e, std::move(*static_cast<T*>(p)));
+            },
+            [](void* p) { static_cast<T*>(p)->~T(); }});
+    }
+
+    template<typename T>
+    void RemoveComponent(EntityID id)
+    {
+        commands_.push_back({Op::Component, id, nullptr,
+            [](RegistryType& registry, EntityID e, void*) {
+                registry.template RemoveComponent<T>(e);
+            },
+            nullptr});
+    }
+
+    // ── Playback ──────────────────────────────────────────────────────────────
+
+    // Apply every recorded command to registry, in order, then clear.  Must
+    // run where structural changes are allowed (not inside Each).
+    void Flush(RegistryType& registry)
+    {
+        created_.resize(createdCount_);
+
+        for (const Command& cmd : commands_) {
+            if (cmd.op == Op::Create) {
+                ENGINE_ASSERT(cmd.entity.index < created_.size(),
+                              "CommandBuffer: deferred ID out of range");
+                created_[cmd.entity.index] = registry.CreateEntity();
+                continue;
+            }
+
+            const EntityID id = Resolve(cmd.entity);
+            if (!registry.IsAlive(id)) continue;
+
+            if (cmd.op == Op::Destroy) registry.DestroyEntity(id);
+            else                       cmd.apply(registry, id, cmd.payload);
+        }
+        Clear();
+    }
+
+    // Discard every recorded command without applying it.
+    void Clear()
+    {
+        for (const Command& cmd : commands_)
+            if (cmd.destroy) cmd.destroy(cmd.payload);
+        commands_.clear();
+        created_.clear();
+        createdCount_ = 0;
+        for (Block& block : blocks_) block.used = 0;
+        activeBlock_ = 0;
+    }
+
+    bool        Empty() const { return commands_.empty(); }
+    std::size_t Size()  const { return commands_.size(); }
+
+private:
+    // Generation reserved for deferred IDs; live entities would need four
+    // billion reuses of one slot to reach it.
+    static constexpr std::uint32_t kDeferredGeneration = EntityID::kInvalid;
+    static constexpr std::size_t   kBlockSize          = 16u * 1024u;
+
+    enum class Op : std::uint8_t { Create, Destroy, Component };
+
+    using ApplyFn   = void (*)(RegistryType&, EntityID, void*);
+    using DestroyFn = void (*)(void*);
+
+    struct Command {
+        Op        op;
+        EntityID  entity;
+        void*     payload;   // component value (AddComponent only)
+        ApplyFn   apply;     // typed registry call (Component only)
+        DestroyFn destroy;   // payload destructor, or nullptr
+    };
+
+    struct Block {
+        std::unique_ptr<std::byte[]> data;
+        std::size_t                  size = 0;
+        std::size_t                  used = 0;
+    };
+
+    EntityID Resolve(EntityID id) const
+    {
+        if (id.generation != kDeferredGeneration) return id;
+        ENGINE_ASSERT(id.index < created_.size(),
+                      "CommandBuffer: deferred ID from another buffer");
+        return created_[id.index];
+    }
+
+    // Stable storage for payloads: blocks never move or shrink, so recorded
+    // pointers stay valid until Clear.
+    void* Allocate(std::size_t size, std::size_t alignment)
+    {
+        for (; activeBlock_ < blocks_.size(); ++activeBlock_) {
+            if (void* p = TryAllocate(blocks_[activeBlock_], size, alignment)) return p;
+        }
+
+        Block block;
+        block.size = std::max(kBlockSize, size + alignment);
+        block.data = std::make_unique<std::byte[]>(block.size);
+        blocks_.push_back(std::move(block));
+        void* p = TryAllocate(blocks_.back(), size, alignment);
+        ENGINE_ASSERT(p != nullptr, "CommandBuffer: payload allocation failed");
+        return p;
+    }
+
+    static void* TryAllocate(Block& block, std::size_t size, std::size_t alignment)
+    {
+        const auto base    = reinterpret_cast<std::uintptr_t>(block.data.get());
+        const auto aligned = (base + block.used + alignment - 1u) & ~(alignment - 1u);
+        const std::size_t end = (aligned - base) + size;
+        if (end > block.size) return nullptr;
+        block.used = end;
+        return reinterpret_cast<void*>(aligned);
+    }
+
+    std::vector<Command>  commands_;
+    std::vector<EntityID> created_;        // deferred index → real entity, during Flush
+    std::uint32_t         createdCount_ = 0;
+    std::vector<Block>    blocks_;
+    std::size_t           activeBlock_  = 0;
+};
+
+// ─── BasicCommandBufferSet ────────────────────────────────────────────────────
+// One command buffer per job-system thread.  Inside a job, Local() returns the
+// calling thread's buffer, so recording never contends; Flush plays the
+// buffers back one after another (thread 0 first) once the jobs are done.
+// The set is sized to the JobSystem it was built with; record into it only
+// from that JobSystem's jobs.
+template<typename Storage>
+class BasicCommandBufferSet {
+public:
+    explicit BasicCommandBufferSet(const JobSystem& jobs)
+        : buffers_(jobs.ThreadCount()) {}
+
+    BasicCommandBuffer<Storage>& Local()
+    {
+        const std::uint32_t thread = JobSystem::ThreadIndex();
+        ENGINE_ASSERT(thread < buffers_.size(),
+                      "CommandBufferSet: thread outside the JobSystem it was built for");
+        return buffers_[thread];
+    }
+
+    void Flush(BasicRegistry<Storage>& registry)
+    {
+        for (auto& buffer : buffers_) buffer.Flush(registry);
+    }
+
+    void Clear()
+    {
+        for (auto& buffer : buffers_) buffer.Clear();
+    }
+
+    std::uint32_t ThreadCount() const { return static_cast<std::uint32_t>(buffers_.size()); }
+
+private:
+    std::vector<BasicCommandBuffer<Storage>> buffers_;
+};
+
+using CommandBuffer    = BasicCommandBuffer<ComponentStorage>;
+using CommandBufferSet = BasicCommandBufferSet<ComponentStorage>;
+
+} // namespace engine
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <core/Assert.hpp>
+#include <bitset>
+#include <cstdint>
+#include <type_traits>
+
+namespace engine {
+
+// ─── ComponentTypeID ──────────────────────────────────────────────────────────
+// Dense, process-wide integer ID per component type.  IDs are assigned on first
+// use, so they index fixed-size tables (archetype column lookup, masks) without
+// a hash probe.  kMaxComponentTypes bounds the number of distinct component
+// types the engine may register.
+using ComponentTypeID = std::uint32_t;
+
+inline constexpr std::uint32_t kMaxComponentTypes = 64;
+
+// Bit N is set when the entity / archetype has the component whose ID is N.
+using ComponentMask = std::bitset<kMaxComponentTypes>;
+
+namespace detail {
+
+inline ComponentTypeID NextComponentTypeID()
+{
+    static ComponentTypeID next = 0;
+    ENGINE_ASSERT(next < kMaxComponentTypes,
+                  "ComponentTypeID: too many component types — raise kMaxComponentTypes");
+    return next++;
+}
+
+} // namespace detail
+
+// Returns the ID of T (cv/ref-qualifiers are ignored).
+template<typename T>
+ComponentTypeID ComponentType()
+{
+    if constexpr (!std::is_same_v<T, std::remove_cvref_t<T>>) {
+        return ComponentType<std::remove_cvref_t<T>>();
+    } else {
+        static const ComponentTypeID id = detail::NextComponentTypeID();
+        return id;
+    }
+}
+
+// Mask with the bits of every listed component type set.
+template<typename... Ts>
+ComponentMask MakeComponentMask()
+{
+    ComponentMask mask;
+    (mask.set(ComponentType<Ts>()), ...);
+    return mask;
+}
+
+} // namespace engine
@@ -1,20 +1,74 @@
 #pragma once
 
+#include <core/DynamicBVH.hpp>
 #include <core/Geometry.hpp>
+#include <scene/ecs/Entity.hpp>
 #include <glm/vec3.hpp>
+#include <glm/mat3x3.hpp>
 #include <glm/mat4x4.hpp>
+#include <glm/trigonometric.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include <cmath>
 #include <cstdint>
 
 namespace engine {
 
 // ─── TransformComponent ───────────────────────────────────────────────────────
-// TransformSystem recomputes worldMatrix whenever dirty == true.
+// TransformSystem recomputes worldMatrix and normalMatrix whenever the
+// component is changed — i.e. added, or edited through Registry::Patch /
+// MarkChanged.  Writing the fields through a plain GetComponent reference is
+// not picked up.
+//
+// rotation is the stored orientation.  Euler angles remain available for
+// authoring through SetEulerAngles / EulerAngles (degrees, applied X→Y→Z);
+// they are converted on the spot and not kept.
 struct TransformComponent {
-    glm::vec3 position    = glm::vec3(0.f);
-    glm::vec3 eulerAngles = glm::vec3(0.f);  // degrees; applied X→Y→Z
-    glm::vec3 scale       = glm::vec3(1.f);
-    glm::mat4 worldMatrix = glm::mat4(1.f);  // computed; do not set manually
-    bool      dirty       = true;
+    glm::vec3 position     = glm::vec3(0.f);
+    glm::quat rotation     = glm::quat(1.f, 0.f, 0.f, 0.f);  // (w, x, y, z)
+    glm::vec3 scale        = glm::vec3(1.f);
+    glm::mat4 worldMatrix  = glm::mat4(1.f);  // computed; do not set manually
+    glm::mat3 normalMatrix = glm::mat3(1.f);  // computed: transpose(inverse(world 3x3))
+
+    void SetEulerAngles(const glm::vec3& degrees)
+    {
+        const glm::vec3 r = glm::radians(degrees);
+        rotation = glm::angleAxis(r.x, glm::vec3(1.f, 0.f, 0.f))
+                 * glm::angleAxis(r.y, glm::vec3(0.f, 1.f, 0.f))
+                 * glm::angleAxis(r.z, glm::vec3(0.f, 0.f, 1.f));
+    }
+
+    // Inverse of SetEulerAngles, from R = Rx * Ry * Rz.  At the gimbal lock
+    // (Y = ±90°) X and Z are ambiguous; Z is reported as 0.
+    glm::vec3 EulerAngles() const
+    {
+        const glm::mat3 m  = glm::mat3_cast(rotation);
+        const float     cy = std::sqrt(m[0][0] * m[0][0] + m[1][0] * m[1][0]);
+        glm::vec3 r(0.f, std::atan2(m[2][0], cy), 0.f);
+        if (cy > 1e-6f) {
+            r.x = std::atan2(-m[2][1], m[2][2]);
+            r.z = std::atan2(-m[1][0], m[0][0]);
+        } else {
+            r.x = std::atan2(m[1][2], m[1][1]);
+        }
+        return glm::degrees(r);
+    }
+};
+
+// ─── HierarchyComponent ───────────────────────────────────────────────────────
+// Parents an entity's transform to another entity: its TransformComponent
+// becomes parent-relative and worldMatrix = parent.worldMatrix * local TRS.
+// Children form an intrusive doubly linked sibling list so TransformSystem can
+// walk a subtree without extra allocation.  Created and maintained by
+// TransformSystem::SetParent — do not edit the links by hand.
+struct HierarchyComponent {
+    EntityID      parent      = INVALID_ENTITY;
+    EntityID      firstChild  = INVALID_ENTITY;
+    EntityID      prevSibling = INVALID_ENTITY;
+    EntityID      nextSibling = INVALID_ENTITY;
+    std::uint32_t depth       = 0;                 // 0 = root
+    std::uint32_t epoch       = 0;                 // last propagation pass that visited it
+    glm::mat4     localMatrix = glm::mat4(1.f);    // cached local TRS; computed
+    glm::mat3     localNormal = glm::mat3(1.f);    // its normal matrix; computed
 };
 
 // ─── MeshComponent ────────────────────────────────────────────────────────────
@@ -26,6 +80,34 @@ struct MeshComponent {
     AABB          localBounds;
 };
 
+// ─── OccluderComponent ────────────────────────────────────────────────────────
+// Marks an entity as an occluder: each frame RenderSystem rasterizes its
+// occluder mesh, placed by the entity's world matrix, into the software
+// occlusion buffer, and meshes entirely behind it are not drawn.  Keep the
+// set small (large walls, floors, terrain) and the meshes coarse; the mesh
+// must lie inside the geometry it stands for.
+struct OccluderComponent {
+    std::uint32_t occluderHandle = 0;      // Handle into ResourceManager occluder pool
+};
+
+// ─── WorldBoundsComponent ─────────────────────────────────────────────────────
+// World-space AABB of an entity's mesh, in center / extent form so culling can
+// load it straight into SoA batches.  RenderSystem attaches it to every entity
+// with Transform + Mesh and recomputes it (TransformAABB of the mesh bounds by
+// the world matrix) only when either of those changes, moving the entity's
+// proxy in the scene's BoundsTree along with it.  Do not edit by hand.
+struct WorldBoundsComponent {
+    glm::vec3     center  = glm::vec3(0.f);
+    glm::vec3     extents = glm::vec3(0.f);   // half-size, >= 0
+    std::uint32_t proxy   = DynamicBVH<EntityID>::kNull;   // leaf in BoundsTree; kNull while hidden
+
+    AABB Bounds() const { return AABB::FromCenterExtents(center, extents); }
+};
+
+// BVH over the WorldBoundsComponent of every visible mesh entity, keyed by
+// EntityID.  Owned by Scene, maintained by RenderSystem::GatherCommands.
+using BoundsTree = DynamicBVH<EntityID>;
+
 // ─── CameraComponent ──────────────────────────────────────────────────────────
 struct CameraComponent {
     float fovY      = 60.f;   // degrees
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <core/Memory/HandlePool.hpp>
+
+namespace engine {
+
+// ─── EntityID ─────────────────────────────────────────────────────────────────
+// Slot index + generation, the same versioned handle HandlePool hands out for
+// resources.  The registry recycles the slots of destroyed entities and bumps
+// their generation, so the entity table stays as large as the peak live count
+// and an ID kept past DestroyEntity is detected as stale instead of aliasing
+// whichever entity reuses its slot.  Default-constructed IDs are invalid.
+struct EntityTag;
+using EntityID = Handle<EntityTag>;
+
+inline constexpr EntityID INVALID_ENTITY{};
+
+} // namespace engine
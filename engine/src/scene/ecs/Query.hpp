@@ -0,0 +1,86 @@
+#pragma once
+
+#include <scene/ecs/Entity.hpp>
+#include <scene/ecs/QueryFilter.hpp>
+#include <cstddef>
+#include <cstdint>
+
+namespace engine {
+
+class JobSystem;
+
+// Default number of entities per ParallelEach job.  Large enough that the
+// per-job overhead (one deque operation) is noise next to the work, small
+// enough that 100k entities still spread across every core.
+inline constexpr std::uint32_t kDefaultParallelGrain = 512;
+
+// ─── BasicQuery ───────────────────────────────────────────────────────────────
+// Handle to a cached query over entities that have ALL of Ts.  The storage
+// keeps the matching set up to date as components are added and removed, so
+// Each() visits exactly the matching entities without re-testing anything.
+//
+// Obtain one via Registry::RegisterQuery<Ts...>().  Registering the same
+// component set again returns a handle to the same cached state, so systems
+// may call RegisterQuery every frame at the cost of one hash lookup.  The
+// handle is a pair of pointers and stays valid for the registry's lifetime.
+//
+// Ts may include Changed<...> / Added<...> filters (see QueryFilter.hpp); they
+// narrow the matching set but are not passed to the callback, so
+// Query<A, Changed<B>, C>::Each takes fn(EntityID, A&, C&).
+template<typename Storage, typename... Ts>
+class BasicQuery {
+public:
+    using State = typename Storage::QueryState;
+
+    BasicQuery(Storage& storage, State& state)
+        : storage_(&storage), state_(&state) {}
+
+    // Call fn(EntityID, Ts&...) for every matching entity.  Structural changes
+    // must not be made from inside fn.
+    template<typename Fn>
+    void Each(Fn&& fn) const
+    {
+        EachImpl(detail::ComponentTerms<Ts...>{}, fn);
+    }
+
+    // Like Each, but matching entities are split into chunks of at most
+    // `grain` and fn runs concurrently on the job system's threads.  fn must be
+    // safe to call from several threads at once; it may write the components
+    // it is handed but must not touch other entities or make structural
+    // changes — those go through a per-thread CommandBufferSet, flushed after
+    // this returns.  Blocks until every chunk has finished.
+    template<typename Fn>
+    void ParallelEach(JobSystem& jobs, Fn&& fn,
+                      std::uint32_t grain = kDefaultParallelGrain) const
+    {
+        ParallelEachImpl(detail::ComponentTerms<Ts...>{}, jobs, fn, grain);
+    }
+
+    // Filtered queries only: treat every change made so far as seen, without
+    // visiting.  A system that stamps changes on the very component it filters
+    // on calls this after its own writes, so it does not pick them up again
+    // next run; other queries still see them.
+    void Consume() const { storage_->ConsumeQuery(*state_); }
+
+    // Number of matching entities.
+    std::size_t Count() const { return storage_->QueryCount(*state_); }
+
+private:
+    Storage* storage_;
+    State*   state_;
+
+    template<typename... Cs, typename Fn>
+    void EachImpl(detail::TypeList<Cs...>, Fn& fn) const
+    {
+        storage_->template EachInQuery<Cs...>(*state_, fn);
+    }
+
+    template<typename... Cs, typename Fn>
+    void ParallelEachImpl(detail::TypeList<Cs...>, JobSystem& jobs, Fn& fn,
+                          std::uint32_t grain) const
+    {
+        storage_->template ParallelEachInQuery<Cs...>(jobs, *state_, fn, grain);
+    }
+};
+
+} // namespace engine
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <scene/ecs/ComponentType.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+
+namespace engine {
+
+// ─── ChangeTick ───────────────────────────────────────────────────────────────
+// Every component instance carries two ticks taken from its storage's counter:
+// when it was added, and when it was last changed (added, re-assigned through
+// AddComponent, or flagged via Registry::Patch / MarkChanged).  The counter
+// advances once per filtered query run, so 64 bits never wrap in practice.
+using ChangeTick = std::uint64_t;
+
+// ─── Query filters ────────────────────────────────────────────────────────────
+// Extra terms for Registry::RegisterQuery / ParallelEach.  A filter requires
+// its component types like a plain term, but is not passed to the callback:
+//
+//   Changed<Us...> — any of Us was added or changed since this query last ran
+//   Added<Us...>   — any of Us was added since this query last ran
+//
+// Terms of the same kind are OR-ed (Changed<A>, Changed<B> ≡ Changed<A, B>);
+// a Changed and an Added term must both pass.  "Since this query last ran" is
+// tracked per cached query state, so a filtered query should have a single
+// consumer — two systems registering the same filtered signature share one
+// cursor and each sees only the changes the other has not consumed.
+//
+//   registry.RegisterQuery<TransformComponent, Changed<TransformComponent>>()
+//       .Each([](EntityID, TransformComponent& tc) { ... });
+template<typename... Us> struct Changed {};
+template<typename... Us> struct Added   {};
+
+// Cache key of a query: the component set plus its filter masks.
+struct QueryKey {
+    ComponentMask required;   // plain terms and filtered types
+    ComponentMask changed;    // types named by Changed<...>
+    ComponentMask added;      // types named by Added<...>
+
+    bool Filtered() const { return changed.any() || added.any(); }
+
+    bool operator==(const QueryKey&) const = default;
+};
+
+struct QueryKeyHash {
+    std::size_t operator()(const QueryKey& key) const
+    {
+        const std::hash<ComponentMask> h;
+        std::size_t seed = h(key.required);
+        seed ^= h(key.changed) + 0x9e3779b9u + (seed << 6) + (seed >> 2);
+        seed ^= h(key.added)   + 0x9e3779b9u + (seed << 6) + (seed >> 2);
+        return seed;
+    }
+};
+
+namespace detail {
+
+template<typename... Ts> struct TypeList {};
+
+// Classifies one query term and records it in a QueryKey.
+template<typename T>
+struct QueryTerm {
+    static constexpr bool kIsFilter = false;
+    static void Apply(QueryKey& key) { key.required.set(ComponentType<T>()); }
+};
+
+template<typename... Us>
+struct QueryTerm<Changed<Us...>> {
+    static constexpr bool kIsFilter = true;
+    static void Apply(QueryKey& key)
+    {
+        (key.required.set(ComponentType<Us>()), ...);
+        (key.changed.set(ComponentType<Us>()), ...);
+    }
+};
+
+template<typename... Us>
+struct QueryTerm<Added<Us...>> {
+    static constexpr bool kIsFilter = true;
+    static void Apply(QueryKey& key)
+    {
+        (key.required.set(ComponentType<Us>()), ...);
+        (key.added.set(ComponentType<Us>()), ...);
+    }
+};
+
+template<typename... Ts>
+inline constexpr bool kHasQueryFilter = (QueryTerm<Ts>::kIsFilter || ...);
+
+template<typename... Ts>
+QueryKey MakeQueryKey()
+{
+    QueryKey key;
+    (QueryTerm<Ts>::Apply(key), ...);
+    return key;
+}
+
+// TypeList of the plain (non-filter) terms of Ts, in order — the component
+// references a query callback receives.
+template<typename List, typename... Ts>
+struct ComponentTermsImpl { using type = List; };
+
+template<typename... Cs, typename T, typename... Rest>
+struct ComponentTermsImpl<TypeList<Cs...>, T, Rest...>
+    : ComponentTermsImpl<std::conditional_t<QueryTerm<T>::kIsFilter,
+                                            TypeList<Cs...>,
+                                            TypeList<Cs..., T>>,
+                         Rest...> {};
+
+template<typename... Ts>
+using ComponentTerms = typename ComponentTermsImpl<TypeList<>, Ts...>::type;
+
+} // namespace detail
+
+} // namespace engine
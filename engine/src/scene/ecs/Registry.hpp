@@ -1,79 +1,135 @@
 #pragma once
 
 #include <core/Assert.hpp>
-#include <any>
+#include <scene/ecs/Entity.hpp>
+#include <scene/ecs/ArchetypeStorage.hpp>
+#include <scene/ecs/SparseSetStorage.hpp>
+#include <scene/ecs/Query.hpp>
 #include <cstdint>
-#include <typeindex>
-#include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace engine {
 
-using EntityID = std::uint32_t;
-constexpr EntityID INVALID_ENTITY = 0;
-
-// ─── Registry ─────────────────────────────────────────────────────────────────
-// Archetype-free ECS registry.
-// Each entity owns an unordered_map<type_index, any> of components.
-// Simple and correct; cache-unfriendly but sufficient until Phase 6+ profiling
-// reveals a need for archetypes.
-class Registry {
+// ─── BasicRegistry ────────────────────────────────────────────────────────────
+// ECS registry.  Entity lifetime is tracked here — a generation per slot and a
+// free list of slots to recycle, so storages can index their per-entity tables
+// by EntityID::index and need not check generations themselves.  Components
+// live in the Storage backend, which must provide Create/Destroy/Contains and
+// templated Emplace/Get/Has/Remove/MarkChanged/Each:
+//
+//   ArchetypeStorage — entities with the same component set are packed into
+//                      contiguous per-type columns; best for wide queries over
+//                      stable entity layouts.
+//   SparseSetStorage — one sparse set per component type; O(1) add/remove/has
+//                      without moving other components.
+//
+// Structural changes (CreateEntity, DestroyEntity, adding a component type the
+// entity does not yet have, RemoveComponent) may move components and
+// invalidate references obtained earlier.  They must not be made from inside
+// Each — record them in a CommandBuffer (CommandBuffer.hpp) and flush it
+// afterwards.
+//
+// Change detection: every component carries added/changed ticks.  Adding a
+// component stamps both; Patch and MarkChanged stamp "changed".  Writes made
+// through plain references are not tracked — systems that mutate components
+// other systems filter on must report them with MarkChanged.
+template<typename Storage>
+class BasicRegistry {
 public:
     // ── Entity management ─────────────────────────────────────────────────────
 
+    // Reuses the most recently freed slot, if any, under its bumped
+    // generation; otherwise appends a slot.
     EntityID CreateEntity()
     {
-        const EntityID id = nextID_++;
-        entities_.emplace(id, ComponentMap{});
+        EntityID id;
+        if (!freeSlots_.empty()) {
+            id.index = freeSlots_.back();
+            freeSlots_.pop_back();
+        } else {
+            ENGINE_ASSERT(generations_.size() < EntityID::kInvalid, "CreateEntity: entity slots exhausted");
+            id.index = static_cast<std::uint32_t>(generations_.size());
+            generations_.push_back(0u);
+        }
+        id.generation = generations_[id.index];
+        storage_.Create(id);
+        ++entityCount_;
         return id;
     }
 
+    // No-op for stale or invalid IDs.
     void DestroyEntity(EntityID id)
     {
-        entities_.erase(id);
+        if (!IsAlive(id)) return;
+        storage_.Destroy(id);
+        ++generations_[id.index];   // invalidates every copy of id
+        freeSlots_.push_back(id.index);
+        --entityCount_;
     }
 
-    bool IsAlive(EntityID id) const { return entities_.contains(id); }
+    // False for INVALID_ENTITY and for IDs whose entity has been destroyed,
+    // even after the slot has been reused.
+    bool IsAlive(EntityID id) const
+    {
+        return id.index < generations_.size() && generations_[id.index] == id.generation;
+    }
 
     // ── Component management ──────────────────────────────────────────────────
 
     template<typename T>
     T& AddComponent(EntityID id, T component = {})
     {
-        ENGINE_ASSERT(entities_.contains(id), "AddComponent: entity does not exist");
-        auto& map = entities_.at(id);
-        map[std::type_index(typeid(T))] = std::move(component);
-        return std::any_cast<T&>(map.at(std::type_index(typeid(T))));
+        ENGINE_ASSERT(IsAlive(id), "AddComponent: entity does not exist");
+        return storage_.template Emplace<T>(id, std::move(component));
     }
 
     template<typename T>
     T& GetComponent(EntityID id)
     {
         ENGINE_ASSERT(HasComponent<T>(id), "GetComponent: component not present");
-        return std::any_cast<T&>(
-            entities_.at(id).at(std::type_index(typeid(T))));
+        return storage_.template Get<T>(id);
     }
 
     template<typename T>
     const T& GetComponent(EntityID id) const
     {
         ENGINE_ASSERT(HasComponent<T>(id), "GetComponent: component not present");
-        return std::any_cast<const T&>(
-            entities_.at(id).at(std::type_index(typeid(T))));
+        return storage_.template Get<T>(id);
+    }
+
+    // GetComponent for writing: also stamps T as changed, so Changed<T> query
+    // filters see the entity on their next run.  Use it (or MarkChanged) for
+    // every out-of-system edit — plain GetComponent writes are invisible to
+    // change detection.
+    template<typename T>
+    T& Patch(EntityID id)
+    {
+        ENGINE_ASSERT(HasComponent<T>(id), "Patch: component not present");
+        storage_.template MarkChanged<T>(id);
+        return storage_.template Get<T>(id);
+    }
+
+    // Stamp T on id as changed.  Safe to call from inside Each / ParallelEach
+    // for the entity currently being visited.
+    template<typename T>
+    void MarkChanged(EntityID id)
+    {
+        ENGINE_ASSERT(HasComponent<T>(id), "MarkChanged: component not present");
+        storage_.template MarkChanged<T>(id);
     }
 
     template<typename T>
     bool HasComponent(EntityID id) const
     {
-        const auto it = entities_.find(id);
-        if (it == entities_.end()) return false;
-        return it->second.contains(std::type_index(typeid(T)));
+        return IsAlive(id) && storage_.template Has<T>(id);
     }
 
     template<typename T>
     void RemoveComponent(EntityID id)
     {
-        ENGINE_ASSERT(entities_.contains(id), "RemoveComponent: entity does not exist");
-        entities_.at(id).erase(std::type_index(typeid(T)));
+        ENGINE_ASSERT(IsAlive(id), "RemoveComponent: entity does not exist");
+        storage_.template Remove<T>(id);
     }
 
     // ── Iteration ─────────────────────────────────────────────────────────────
@@ -84,33 +140,60 @@ public:
     template<typename... Ts, typename Fn>
     void Each(Fn&& fn)
     {
-        for (auto& [id, map] : entities_) {
-            if ((map.contains(std::type_index(typeid(Ts))) && ...)) {
-                fn(id,
-                   std::any_cast<Ts&>(map.at(std::type_index(typeid(Ts))))...);
-            }
-        }
+        static_assert(!detail::kHasQueryFilter<Ts...>,
+                      "Each: Changed/Added filters need a cached query (RegisterQuery)");
+        storage_.template Each<Ts...>(fn);
     }
 
     // Const overload — fn receives const component refs.
     template<typename... Ts, typename Fn>
     void Each(Fn&& fn) const
     {
-        for (const auto& [id, map] : entities_) {
-            if ((map.contains(std::type_index(typeid(Ts))) && ...)) {
-                fn(id,
-                   std::any_cast<const Ts&>(map.at(std::type_index(typeid(Ts))))...);
-            }
-        }
+        static_assert(!detail::kHasQueryFilter<Ts...>,
+                      "Each: Changed/Added filters need a cached query (RegisterQuery)");
+        storage_.template Each<Ts...>(fn);
     }
 
-    std::size_t EntityCount() const { return entities_.size(); }
+    // Register (or look up) the cached query for entities with ALL of Ts.
+    // Prefer this over Each in per-frame systems: membership is maintained
+    // incrementally, so iteration skips non-matching entities for free.
+    // Ts may include Changed<...> / Added<...> filters.
+    template<typename... Ts>
+    BasicQuery<Storage, Ts...> RegisterQuery()
+    {
+        return {storage_, storage_.RegisterQuery(detail::MakeQueryKey<Ts...>())};
+    }
 
-private:
-    using ComponentMap = std::unordered_map<std::type_index, std::any>;
+    // Parallel counterpart of Each over the cached query for Ts; see
+    // BasicQuery::ParallelEach for the rules fn must follow.
+    template<typename... Ts, typename Fn>
+    void ParallelEach(JobSystem& jobs, Fn&& fn,
+                      std::uint32_t grain = kDefaultParallelGrain)
+    {
+        RegisterQuery<Ts...>().ParallelEach(jobs, fn, grain);
+    }
+
+    std::size_t EntityCount() const { return entityCount_; }
 
-    std::unordered_map<EntityID, ComponentMap> entities_;
-    EntityID nextID_ = 1; // 0 is INVALID_ENTITY
+private:
+    Storage                    storage_;
+    std::size_t                entityCount_ = 0;
+    std::vector<std::uint32_t> generations_;   // current generation per slot
+    std::vector<std::uint32_t> freeSlots_;     // slots of destroyed entities
 };
 
+// ─── Registry ─────────────────────────────────────────────────────────────────
+// The engine-wide registry type.  The backend is chosen at configure time via
+// the ENGINE_ECS_BACKEND CMake cache variable (Archetype | SparseSet).
+#if defined(ENGINE_ECS_SPARSE_SET)
+using ComponentStorage = SparseSetStorage;
+#else
+using ComponentStorage = ArchetypeStorage;
+#endif
+
+using Registry = BasicRegistry<ComponentStorage>;
+
+template<typename... Ts>
+using Query = BasicQuery<ComponentStorage, Ts...>;
+
 } // namespace engine
@@ -0,0 +1,434 @@
+#pragma once
+
+#include <scene/ecs/Entity.hpp>
+#include <scene/ecs/ComponentType.hpp>
+#include <scene/ecs/QueryFilter.hpp>
+#include <core/Assert.hpp>
+#include <core/Jobs/JobSystem.hpp>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace engine {
+
+// ─── ComponentPool ────────────────────────────────────────────────────────────
+// Sparse set for one component type.
+//   sparse_[slot]   → index into the packed arrays (kAbsent when missing)
+//   dense_[i]       → owning entity of data_[i]
+// Membership is a bounds check plus one array read; iteration walks data_.
+// added_/changed_ hold the change ticks of data_[i].
+class IComponentPool {
+public:
+    virtual ~IComponentPool() = default;
+
+    virtual bool        Contains(EntityID id) const = 0;
+    virtual void        Remove(EntityID id)         = 0;
+    virtual std::size_t Size() const                = 0;
+
+    // Change ticks of a present component.
+    virtual ChangeTick  AddedTick(EntityID id) const   = 0;
+    virtual ChangeTick  ChangedTick(EntityID id) const = 0;
+};
+
+template<typename T>
+class ComponentPool final : public IComponentPool {
+public:
+    static constexpr std::uint32_t kAbsent = std::numeric_limits<std::uint32_t>::max();
+
+    bool Contains(EntityID id) const override
+    {
+        return id.index < sparse_.size() && sparse_[id.index] != kAbsent;
+    }
+
+    T& Emplace(EntityID id, T component, ChangeTick tick)
+    {
+        if (Contains(id)) {
+            changed_[sparse_[id.index]] = tick;
+            T& slot = data_[sparse_[id.index]];
+            slot    = std::move(component);
+            return slot;
+        }
+        if (id.index >= sparse_.size()) sparse_.resize(static_cast<std::size_t>(id.index) + 1u, kAbsent);
+
+        sparse_[id.index] = static_cast<std::uint32_t>(dense_.size());
+        dense_.push_back(id);
+        data_.push_back(std::move(component));
+        added_.push_back(tick);
+        changed_.push_back(tick);
+        return data_.back();
+    }
+
+    // Swap-remove: the last element fills the hole so the arrays stay packed.
+    void Remove(EntityID id) override
+    {
+        if (!Contains(id)) return;
+
+        const std::uint32_t index = sparse_[id.index];
+        const EntityID      last  = dense_.back();
+        if (index + 1u != dense_.size()) {
+            data_[index]    = std::move(data_.back());
+            added_[index]   = added_.back();
+            changed_[index] = changed_.back();
+            dense_[index]   = last;
+            sparse_[last.index]   = index;
+        }
+        data_.pop_back();
+        added_.pop_back();
+        changed_.pop_back();
+        dense_.pop_back();
+        sparse_[id.index] = kAbsent;
+    }
+
+    std::size_t Size() const override { return dense_.size(); }
+
+    ChangeTick AddedTick(EntityID id) const override   { return added_[sparse_[id.index]]; }
+    ChangeTick ChangedTick(EntityID id) const override { return changed_[sparse_[id.index]]; }
+
+    void MarkChanged(EntityID id, ChangeTick tick) { changed_[sparse_[id.index]] = tick; }
+
+    T&       Get(EntityID id)       { return data_[sparse_[id.index]]; }
+    const T& Get(EntityID id) const { return data_[sparse_[id.index]]; }
+
+    const std::vector<EntityID>& Entities() const { return dense_; }
+    T*                           Data()           { return data_.data(); }
+    const T*                     Data()     const { return data_.data(); }
+
+private:
+    std::vector<std::uint32_t> sparse_;
+    std::vector<EntityID>      dense_;
+    std::vector<T>             data_;
+    std::vector<ChangeTick>    added_;
+    std::vector<ChangeTick>    changed_;
+};
+
+// ─── SparseSetStorage ─────────────────────────────────────────────────────────
+// Component storage backend with one independent sparse set per component
+// type.  Adding or removing a component never touches other pools, so
+// structural changes are cheaper than in ArchetypeStorage; in exchange,
+// multi-component iteration probes the other pools for every entity of the
+// smallest one.
+//
+// References returned by Emplace/Get stay valid until a component of the same
+// type is added to or removed from any entity.
+class SparseSetStorage {
+public:
+    SparseSetStorage() = default;
+
+    SparseSetStorage(const SparseSetStorage&)            = delete;
+    SparseSetStorage& operator=(const SparseSetStorage&) = delete;
+
+    // ── Entities ──────────────────────────────────────────────────────────────
+
+    void Create(EntityID id)
+    {
+        if (id.index >= entities_.size()) {
+            entities_.resize(static_cast<std::size_t>(id.index) + 1u, INVALID_ENTITY);
+            masks_.resize(static_cast<std::size_t>(id.index) + 1u);
+        }
+        entities_[id.index] = id;
+        masks_[id.index].reset();
+        for (auto& query : queries_)
+            if (query->required.none()) query->Insert(id);
+    }
+
+    void Destroy(EntityID id)
+    {
+        for (auto& pool : pools_)
+            if (pool) pool->Remove(id);
+        for (auto& query : queries_) query->Erase(id);
+        entities_[id.index] = INVALID_ENTITY;
+        masks_[id.index].reset();
+    }
+
+    bool Contains(EntityID id) const
+    {
+        return id.index < entities_.size() && entities_[id.index] == id;
+    }
+
+    // ── Components ────────────────────────────────────────────────────────────
+
+    template<typename T>
+    T& Emplace(EntityID id, T component)
+    {
+        const ComponentTypeID type = ComponentType<T>();
+        T& ref = AssurePool<T>().Emplace(id, std::move(component), tick_);
+        if (!masks_[id.index].test(type)) {
+            masks_[id.index].set(type);
+            for (QueryState* query : queriesByType_[type])
+                if ((masks_[id.index] & query->required) == query->required) query->Insert(id);
+        }
+        return ref;
+    }
+
+    template<typename T>
+    void Remove(EntityID id)
+    {
+        const ComponentTypeID type = ComponentType<T>();
+        if (!masks_[id.index].test(type)) return;
+
+        FindPool<T>()->Remove(id);
+        masks_[id.index].reset(type);
+        for (QueryState* query : queriesByType_[type]) query->Erase(id);
+    }
+
+    // Stamp T on id as changed at the current tick.  Touches only that slot, so
+    // it is safe from inside a (parallel) walk that visits id.
+    template<typename T>
+    void MarkChanged(EntityID id) { FindPool<T>()->MarkChanged(id, tick_); }
+
+    template<typename T>
+    bool Has(EntityID id) const
+    {
+        const auto* pool = FindPool<T>();
+        return pool && pool->Contains(id);
+    }
+
+    template<typename T>
+    T& Get(EntityID id) { return FindPool<T>()->Get(id); }
+
+    template<typename T>
+    const T& Get(EntityID id) const { return FindPool<T>()->Get(id); }
+
+    // ── Iteration ─────────────────────────────────────────────────────────────
+
+    // Walks the smallest pool among Ts densely; the remaining pools are probed
+    // through their sparse arrays.
+    template<typename... Ts, typename Fn>
+    void Each(Fn&& fn)
+    {
+        if constexpr (sizeof...(Ts) == 0) {
+            for (const EntityID id : entities_)
+                if (id.IsValid()) fn(id);
+        } else {
+            if (((FindPool<Ts>() == nullptr) || ...)) return;
+            EachImpl(fn, FindPool<Ts>()...);
+        }
+    }
+
+    template<typename... Ts, typename Fn>
+    void Each(Fn&& fn) const
+    {
+        if constexpr (sizeof...(Ts) == 0) {
+            for (const EntityID id : entities_)
+                if (id.IsValid()) fn(id);
+        } else {
+            if (((FindPool<Ts>() == nullptr) || ...)) return;
+            EachImpl(fn, FindPool<Ts>()...);
+        }
+    }
+
+    // ── Cached queries ────────────────────────────────────────────────────────
+    // A query owns a sparse set of the entities that currently match its
+    // required mask.  Emplace/Remove/Destroy update every query that involves
+    // the touched component type, so iterating a query is a dense walk with no
+    // membership probes.
+    //
+    // A filtered query (Changed/Added terms) additionally checks the change
+    // ticks of its filtered types per entity and advances its cursor after
+    // every run.
+
+    struct QueryState {
+        static constexpr std::uint32_t kAbsent = std::numeric_limits<std::uint32_t>::max();
+
+        ComponentMask              required;
+        ComponentMask              changed;
+        ComponentMask              added;
+        ChangeTick                 lastRun = 0;   // ticks >= lastRun are new
+        std::vector<EntityID>      dense;
+        std::vector<std::uint32_t> sparse;   // entity slot → index into dense
+
+        void Insert(EntityID id)
+        {
+            if (id.index >= sparse.size()) sparse.resize(static_cast<std::size_t>(id.index) + 1u, kAbsent);
+            if (sparse[id.index] != kAbsent) return;
+            sparse[id.index] = static_cast<std::uint32_t>(dense.size());
+            dense.push_back(id);
+        }
+
+        void Erase(EntityID id)
+        {
+            if (id.index >= sparse.size() || sparse[id.index] == kAbsent) return;
+            const std::uint32_t index = sparse[id.index];
+            const EntityID      last  = dense.back();
+            dense[index] = last;
+            sparse[last.index] = index;
+            dense.pop_back();
+            sparse[id.index] = kAbsent;
+        }
+
+        bool Filtered() const { return changed.any() || added.any(); }
+    };
+
+    // Returns the state for `key`, creating it on first request.
+    QueryState& RegisterQuery(const QueryKey& key)
+    {
+        if (auto it = queryIndex_.find(key); it != queryIndex_.end())
+            return *it->second;
+
+        auto state = std::make_unique<QueryState>();
+        state->required = key.required;
+        state->changed  = key.changed;
+        state->added    = key.added;
+        for (const EntityID id : entities_)
+            if (id.IsValid() && (masks_[id.index] & key.required) == key.required) state->Insert(id);
+
+        for (ComponentTypeID type = 0; type < kMaxComponentTypes; ++type)
+            if (key.required.test(type)) queriesByType_[type].push_back(state.get());
+
+        QueryState& ref = *state;
+        queryIndex_.emplace(key, state.get());
+        queries_.push_back(std::move(state));
+        return ref;
+    }
+
+    template<typename... Ts, typename Fn>
+    void EachInQuery(QueryState& state, Fn&& fn)
+    {
+        if (state.dense.empty()) return;
+
+        if (!state.Filtered()) {
+            [&](ComponentPool<Ts>*... pools) {
+                for (const EntityID id : state.dense) fn(id, pools->Get(id)...);
+            }(FindPool<Ts>()...);
+            return;
+        }
+
+        const EntityFilter filter(*this, state);
+        [&](ComponentPool<Ts>*... pools) {
+            for (const EntityID id : state.dense)
+                if (filter.Passes(id)) fn(id, pools->Get(id)...);
+        }(FindPool<Ts>()...);
+        Advance(state);
+    }
+
+    // Split the query's dense entity list into ranges of at most `grain` and
+    // run them on the job system.
+    template<typename... Ts, typename Fn>
+    void ParallelEachInQuery(JobSystem& jobs, QueryState& state, Fn& fn,
+                             std::uint32_t grain)
+    {
+        const auto      count = static_cast<std::uint32_t>(state.dense.size());
+        const EntityID* ids   = state.dense.data();
+        if (count == 0) return;
+
+        const bool         filtered = state.Filtered();
+        const EntityFilter filter(*this, state);
+        [&](ComponentPool<Ts>*... pools) {
+            jobs.ParallelFor(count, grain, [&](std::uint32_t begin, std::uint32_t end) {
+                for (std::uint32_t i = begin; i < end; ++i)
+                    if (!filtered || filter.Passes(ids[i])) fn(ids[i], pools->Get(ids[i])...);
+            });
+        }(FindPool<Ts>()...);
+
+        if (filtered) Advance(state);
+    }
+
+    // Move a filtered query's cursor to now without visiting anything.
+    void ConsumeQuery(QueryState& state) { Advance(state); }
+
+    std::size_t QueryCount(const QueryState& state) const { return state.dense.size(); }
+
+private:
+    std::vector<std::unique_ptr<IComponentPool>> pools_;    // indexed by ComponentTypeID
+    std::vector<EntityID>                        entities_; // live handle per slot, or INVALID_ENTITY
+    std::vector<ComponentMask>                   masks_;    // indexed by slot
+
+    std::vector<std::unique_ptr<QueryState>>                 queries_;
+    std::unordered_map<QueryKey, QueryState*, QueryKeyHash>  queryIndex_;
+    std::array<std::vector<QueryState*>, kMaxComponentTypes> queriesByType_;
+
+    ChangeTick tick_ = 1;   // stamped into every add / change
+
+    // A filtered query's Changed/Added pools, tested per entity against the
+    // query's cursor.
+    class EntityFilter {
+    public:
+        static constexpr std::uint32_t kMaxTerms = 8;
+
+        EntityFilter(const SparseSetStorage& storage, const QueryState& state)
+            : since_(state.lastRun)
+        {
+            for (ComponentTypeID type = 0; type < storage.pools_.size(); ++type) {
+                const IComponentPool* pool = storage.pools_[type].get();
+                if (state.changed.test(type)) {
+                    ENGINE_ASSERT(changedCount_ < kMaxTerms, "EntityFilter: too many Changed<> types");
+                    changed_[changedCount_++] = pool;
+                }
+                if (state.added.test(type)) {
+                    ENGINE_ASSERT(addedCount_ < kMaxTerms, "EntityFilter: too many Added<> types");
+                    added_[addedCount_++] = pool;
+                }
+            }
+        }
+
+        bool Passes(EntityID id) const
+        {
+            bool changed = changedCount_ == 0;
+            for (std::uint32_t i = 0; !changed && i < changedCount_; ++i)
+                changed = changed_[i]->ChangedTick(id) >= since_;
+
+            bool added = addedCount_ == 0;
+            for (std::uint32_t i = 0; !added && i < addedCount_; ++i)
+                added = added_[i]->AddedTick(id) >= since_;
+
+            return changed && added;
+        }
+
+    private:
+        std::array<const IComponentPool*, kMaxTerms> changed_{};
+        std::array<const IComponentPool*, kMaxTerms> added_{};
+        std::uint32_t                                changedCount_ = 0;
+        std::uint32_t                                addedCount_   = 0;
+        ChangeTick                                   since_;
+    };
+
+    // Close a filtered run: everything stamped so far is now old for this
+    // query, and later stamps are new.
+    void Advance(QueryState& state) { state.lastRun = ++tick_; }
+
+    template<typename T>
+    ComponentPool<T>* FindPool()
+    {
+        const ComponentTypeID type = ComponentType<T>();
+        if (type >= pools_.size()) return nullptr;
+        return static_cast<ComponentPool<T>*>(pools_[type].get());
+    }
+
+    template<typename T>
+    const ComponentPool<T>* FindPool() const
+    {
+        const ComponentTypeID type = ComponentType<T>();
+        if (type >= pools_.size()) return nullptr;
+        return static_cast<const ComponentPool<T>*>(pools_[type].get());
+    }
+
+    template<typename T>
+    ComponentPool<T>& AssurePool()
+    {
+        const ComponentTypeID type = ComponentType<T>();
+        if (type >= pools_.size()) pools_.resize(static_cast<std::size_t>(type) + 1u);
+        if (!pools_[type]) pools_[type] = std::make_unique<ComponentPool<T>>();
+        return static_cast<ComponentPool<T>&>(*pools_[type]);
+    }
+
+    template<typename Fn, typename... Pools>
+    static void EachImpl(Fn& fn, Pools*... pools)
+    {
+        const IComponentPool* lead = nullptr;
+        ((lead = (!lead || pools->Size() < lead->Size()) ? pools : lead), ...);
+
+        const std::vector<EntityID>* ids = nullptr;
+        ((ids = (lead == pools) ? &pools->Entities() : ids), ...);
+
+        for (const EntityID id : *ids) {
+            if ((pools->Contains(id) && ...))
+                fn(id, pools->Get(id)...);
+        }
+    }
+};
+
+} // namespace engine
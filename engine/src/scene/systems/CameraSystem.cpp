@@ -17,7 +17,7 @@ std::optional<PerFrameData> CameraSystem::Update(
     PerFrameData data{};
     bool         found = false;
 
-    registry.Each<TransformComponent, CameraComponent>(
+    registry.RegisterQuery<TransformComponent, CameraComponent>().Each(
         [&](EntityID, TransformComponent& tc, CameraComponent& cc)
         {
             if (!cc.isPrimary || found) return;
@@ -1,88 +1,542 @@
 #include <scene/systems/RenderSystem.hpp>
 #include <scene/ecs/Components.hpp>
+#include <scene/ecs/CommandBuffer.hpp>
 #include <renderer/frontend/RenderQueue.hpp>
 #include <renderer/frontend/RenderCommand.hpp>
+#include <renderer/frontend/passes/ShadowPass.hpp>
 #include <resources/ResourceManager.hpp>
 #include <resources/GPUMesh.hpp>
 #include <resources/Material.hpp>
+#include <core/Jobs/JobSystem.hpp>
+#include <core/Math/FrustumCull.hpp>
+#include <core/Math/OcclusionBuffer.hpp>
+#include <core/Assert.hpp>
 #include <core/Log.hpp>
 
-#include <glm/gtc/matrix_inverse.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <optional>
+#include <vector>
+
 namespace engine {
 
-RenderSystem::CullStats RenderSystem::GatherCommands(Registry&              registry,
-                                                      const ResourceManager& rm,
-                                                      RenderQueue&           queue,
-                                                      const glm::vec3&       cameraPos,
-                                                      const Frustum&         frustum)
+namespace {
+
+// Boundary leaves of the BVH traversal — those whose ancestors straddle the
+// frustum — are tested kCullBatchSize at a time by the SIMD culler, which
+// wants SoA world-space bounds.
+constexpr std::size_t kCullBatchSize = 64;
+static_assert(kCullBatchSize <= 64, "one visibility mask word per batch");
+
+// Frustum survivors are sized, occlusion-tested and turned into commands in
+// chunks of this many on the job system.
+constexpr std::uint32_t kSubmitGrain = 512;
+
+// Stale proxies are found lazily (see GatherCommands); this many proxy slots
+// are additionally checked per frame.
+constexpr std::uint32_t kSweepPerFrame = 256;
+
+// A frame that inserts at least this many proxies, and at least as many as
+// were already in the tree, rebuilds it with SAH: bulk loads get a good tree
+// rather than an insertion-order one.
+constexpr std::size_t kRebuildMinInserts = 64;
+
+// Cull state.  visible persists across frames: it is last frame's frustum
+// survivors until this frame's cull replaces or patches it.
+struct CullBatch {
+    std::vector<std::uint32_t> visible;   // proxies
+
+    // Pending batch: proxy i and its world bounds.
+    std::array<std::uint32_t, kCullBatchSize> pending;
+    std::array<float, kCullBatchSize> cx, cy, cz, ex, ey, ez;
+    std::size_t                       pendingCount = 0;
+};
+
+// Temporal coherence.  The frustum that CullBatch::visible was computed for,
+// and per proxy slot whether it is in that set.  While the frustum stays the
+// same, only proxies created or moved since can change visibility.
+struct Coherence {
+    Frustum                    frustum{};
+    bool                       valid = false;
+    std::vector<std::uint8_t>  inVisible;   // indexed by proxy
+    std::vector<std::uint32_t> retest;      // proxies created or moved this frame
+};
+
+// The command index each proxy was submitted with, the frame it was
+// submitted in, and the queue those indices point into.  GatherShadowCasters
+// queues a caster that GatherCommands already submitted by index rather than
+// storing its command twice.
+struct SubmittedCommands {
+    const RenderQueue*         queue = nullptr;   // of the latest frame
+    std::uint32_t              frame = 0;
+    std::vector<std::uint32_t> frameOf;   // indexed by proxy
+    std::vector<std::uint32_t> command;   // indexed by proxy
+};
+
+// Per-thread side of command generation, indexed by JobSystem::ThreadIndex()
+// like the RenderQueue::Segment the commands go to: the proxy of each
+// command, in the same order, and this thread's share of the counts.
+struct alignas(64) SubmitCounts {
+    std::vector<std::uint32_t> proxies;
+    std::uint32_t tooSmall   = 0;
+    std::uint32_t occluded   = 0;
+    std::uint32_t reducedLOD = 0;
+    std::uint32_t triangles  = 0;
+};
+
+// Per-thread list of entities whose world bounds were recomputed, indexed by
+// JobSystem::ThreadIndex(); padded so neighbouring threads do not false-share.
+struct alignas(64) ChangedBounds {
+    std::vector<EntityID> ids;
+};
+
+// Queue proxy for the next batch, with its world bounds.
+void Enqueue(CullBatch& batch, std::uint32_t proxy, const AABB& bounds)
 {
-    CullStats stats{};
+    const glm::vec3 c = bounds.Center();
+    const glm::vec3 e = bounds.Extents();
+
+    const std::size_t i = batch.pendingCount++;
+    batch.pending[i] = proxy;
+    batch.cx[i] = c.x; batch.cy[i] = c.y; batch.cz[i] = c.z;
+    batch.ex[i] = e.x; batch.ey[i] = e.y; batch.ez[i] = e.z;
+}
+
+// Cull the pending batch and keep its survivors.
+void Flush(CullBatch& batch, const Frustum& frustum)
+{
+    const std::size_t n = batch.pendingCount;
+    if (n == 0) return;
+
+    std::uint64_t mask = 0;
+    CullAABBs(frustum,
+        {batch.cx.data(), batch.cy.data(), batch.cz.data(),
+         batch.ex.data(), batch.ey.data(), batch.ez.data()}, &mask, n);
+
+    for (; mask != 0; mask &= mask - 1)
+        batch.visible.push_back(batch.pending[std::countr_zero(mask)]);
+    batch.pendingCount = 0;
+}
 
-    registry.Each<TransformComponent, MeshComponent>(
-        [&](EntityID, TransformComponent& tc, MeshComponent& mc)
+// A proxy is stale once its entity is gone or no longer has a mesh to draw.
+bool IsStale(const Registry& registry, EntityID id)
+{
+    return !registry.HasComponent<MeshComponent>(id) ||
+           !registry.HasComponent<DrawRecordComponent>(id);
+}
+
+void DestroyProxy(Registry& registry, BoundsTree& tree, std::uint32_t proxy)
+{
+    const EntityID id = tree.UserData(proxy);
+    if (registry.HasComponent<WorldBoundsComponent>(id)) {
+        WorldBoundsComponent& bounds = registry.GetComponent<WorldBoundsComponent>(id);
+        if (bounds.proxy == proxy) bounds.proxy = BoundsTree::kNull;
+    }
+    tree.DestroyProxy(proxy);
+}
+
+DrawRecordComponent BuildRecord(const TransformComponent& tc,
+                                const MeshComponent&      mc,
+                                const ResourceManager&    rm)
+{
+    const MeshHandle meshHandle{mc.meshHandle, 0u};
+    const GPUMesh& mesh = rm.GetMesh(meshHandle);
+
+    DrawRecordComponent record;
+    RenderCommand& cmd = record.command;
+    cmd.vaoID       = mesh.sharedVAOID;
+    cmd.indexCount  = mesh.indexCount;
+    cmd.baseVertex  = mesh.baseVertex;
+    cmd.baseIndex   = mesh.baseIndex;
+    cmd.modelMatrix = tc.worldMatrix;
+    cmd.normalMatrix= glm::mat4(tc.normalMatrix);   // from TransformSystem
+    cmd.worldBounds = TransformAABB(mesh.localBounds, tc.worldMatrix);
+    cmd.castsShadow = mc.castsShadow;
+    cmd.meshID      = mc.meshHandle;
+    cmd.materialID  = mc.materialHandle;
+    record.lods     = mesh.lods;
+    record.lodCount = mesh.lodCount;
+
+    // Resolve material textures.
+    const MaterialHandle matHandle{mc.materialHandle, 0u};
+    if (matHandle.IsValid()) {
+        const Material& mat = rm.GetMaterial(matHandle);
+        cmd.albedoFactor    = mat.albedoFactor;
+        cmd.metallicFactor  = mat.metallicFactor;
+        cmd.roughnessFactor = mat.roughnessFactor;
+
+        auto resolveTexID = [&](std::uint32_t idx,
+                                const Texture& fallback) -> std::uint32_t {
+            if (idx == kInvalidTexIndex) return fallback.GetID();
+            return rm.GetTexture(TextureHandle{idx, 0u}).GetID();
+        };
+        cmd.albedoTexID        = resolveTexID(mat.albedoTexIndex,    rm.DefaultAlbedo());
+        cmd.normalTexID        = resolveTexID(mat.normalTexIndex,     rm.DefaultNormal());
+        cmd.metallicRoughTexID = resolveTexID(mat.metallicRoughIndex, rm.DefaultMetalRough());
+    } else {
+        cmd.albedoTexID        = rm.DefaultAlbedo().GetID();
+        cmd.normalTexID        = rm.DefaultNormal().GetID();
+        cmd.metallicRoughTexID = rm.DefaultMetalRough().GetID();
+    }
+    return record;
+}
+
+} // namespace
+
+// Gather state of one BoundsTree, reused across frames.
+struct RenderSystem::State {
+    const BoundsTree*          tree = nullptr;   // bound on first GatherCommands
+    std::vector<ChangedBounds> changed;
+    CullBatch                  batch;
+    std::vector<std::uint32_t> stale;
+    std::uint32_t              sweepCursor = 0;   // next proxy slot to check
+    Coherence                  coherence;         // last frame's view of tree
+    SubmittedCommands          submitted;         // latest GatherCommands
+
+    // Attaches records to new entities; rebuilt when the thread count changes.
+    std::optional<CommandBufferSet> commands;
+
+    // Command generation, indexed by JobSystem::ThreadIndex().
+    std::vector<RenderQueue::Segment> segments;
+    std::vector<SubmitCounts>         submitCounts;
+};
+
+RenderSystem::RenderSystem() : state_(std::make_unique<State>()) {}
+RenderSystem::~RenderSystem() = default;
+
+RenderSystem::ScreenSizeCulling
+RenderSystem::ScreenSizeCulling::FromProjection(const glm::mat4& projection,
+                                                float            viewportHeight,
+                                                float            minPixels)
+{
+    ScreenSizeCulling screen;
+    screen.projScaleY     = projection[1][1];
+    screen.viewportHeight = viewportHeight;
+    screen.minPixels      = minPixels;
+    screen.orthographic   = projection[2][3] == 0.f;   // perspective has -1 here
+    return screen;
+}
+
+RenderSystem::CullStats RenderSystem::GatherCommands(Registry&                registry,
+                                                      BoundsTree&              tree,
+                                                      const ResourceManager&   rm,
+                                                      RenderQueue&             queue,
+                                                      const glm::vec3&         cameraPos,
+                                                      const Frustum&           frustum,
+                                                      const ScreenSizeCulling& screen,
+                                                      OcclusionBuffer*         occlusion,
+                                                      JobSystem&               jobs,
+                                                      bool                     gpuCulling)
+{
+    ENGINE_ASSERT(!gpuCulling || !occlusion,
+                  "RenderSystem: occlusion culling runs on the CPU path only");
+    ENGINE_ASSERT(!state_->tree || state_->tree == &tree,
+                  "RenderSystem: each RenderSystem serves a single BoundsTree");
+    state_->tree = &tree;
+
+    // Scratch reused across frames so steady-state culling does not allocate.
+    // GatherCommands is only ever called from the main thread.
+    std::vector<ChangedBounds>&        changed      = state_->changed;
+    CullBatch&                         batch        = state_->batch;
+    std::vector<std::uint32_t>&        stale        = state_->stale;
+    std::uint32_t&                     sweepCursor  = state_->sweepCursor;
+    Coherence&                         coherence    = state_->coherence;
+    std::vector<RenderQueue::Segment>& segments     = state_->segments;
+    std::vector<SubmitCounts>&         submitCounts = state_->submitCounts;
+
+    // ── Attach records to new mesh entities ───────────────────────────────────
+    // Adding a component is a structural change: record it, apply after.  The
+    // set is sized to jobs and kept, blocks and all, until that size changes.
+    if (!state_->commands || state_->commands->ThreadCount() != jobs.ThreadCount())
+        state_->commands.emplace(jobs);
+    CommandBufferSet& commands = *state_->commands;
+    registry.RegisterQuery<TransformComponent, MeshComponent,
+                           Added<TransformComponent, MeshComponent>>().ParallelEach(jobs,
+        [&](EntityID id, const TransformComponent&, const MeshComponent&)
         {
-            if (!mc.visible) return;
+            CommandBuffer& local = commands.Local();
+            if (!registry.HasComponent<DrawRecordComponent>(id))
+                local.AddComponent<DrawRecordComponent>(id);
+            if (!registry.HasComponent<WorldBoundsComponent>(id))
+                local.AddComponent<WorldBoundsComponent>(id);
+        });
+    commands.Flush(registry);
+
+    // ── Refresh records and bounds whose inputs changed ───────────────────────
+    // Components attached above are picked up here too: their Transform / Mesh
+    // were added after this query last ran.  Static entities never reach this
+    // pass, so their world bounds cost nothing per frame.
+    changed.resize(jobs.ThreadCount());
+    registry.ParallelEach<TransformComponent, MeshComponent, DrawRecordComponent,
+                          WorldBoundsComponent,
+                          Changed<TransformComponent, MeshComponent>>(jobs,
+        [&](EntityID id, const TransformComponent& tc, const MeshComponent& mc,
+            DrawRecordComponent& record, WorldBoundsComponent& bounds)
+        {
+            record = BuildRecord(tc, mc, rm);
+            bounds.center  = record.command.worldBounds.Center();
+            bounds.extents = record.command.worldBounds.Extents();
+            changed[JobSystem::ThreadIndex()].ids.push_back(id);
+        });
+
+    // ── Update the BVH ────────────────────────────────────────────────────────
+    // Serial: the tree is not thread-safe.  Hidden meshes have no proxy.
+    std::size_t inserted = 0;
+    for (ChangedBounds& list : changed) {
+        for (const EntityID id : list.ids) {
+            const MeshComponent&  mc     = registry.GetComponent<MeshComponent>(id);
+            WorldBoundsComponent& bounds = registry.GetComponent<WorldBoundsComponent>(id);
+            if (!mc.visible) {
+                if (bounds.proxy != BoundsTree::kNull) DestroyProxy(registry, tree, bounds.proxy);
+            } else if (bounds.proxy == BoundsTree::kNull) {
+                bounds.proxy = tree.CreateProxy(bounds.Bounds(), id);
+                coherence.retest.push_back(bounds.proxy);
+                ++inserted;
+            } else {
+                tree.MoveProxy(bounds.proxy, bounds.Bounds());
+                coherence.retest.push_back(bounds.proxy);
+            }
+        }
+        list.ids.clear();
+    }
+    if (inserted >= kRebuildMinInserts && inserted * 2 >= tree.ProxyCount()) tree.Rebuild();
+
+    // ── Drop stale proxies ────────────────────────────────────────────────────
+    // Nothing notifies RenderSystem when an entity dies or loses its mesh, so
+    // proxies are checked lazily: a rotating window of slots here, and every
+    // proxy the traversal below reaches.
+    stale.clear();
+    for (std::uint32_t n = 0; n < kSweepPerFrame && tree.Capacity() > 0; ++n) {
+        if (sweepCursor >= tree.Capacity()) sweepCursor = 0;
+        if (tree.IsProxy(sweepCursor) && IsStale(registry, tree.UserData(sweepCursor)))
+            stale.push_back(sweepCursor);
+        ++sweepCursor;
+    }
+    for (const std::uint32_t proxy : stale) DestroyProxy(registry, tree, proxy);
+    stale.clear();
 
-            const MeshHandle meshHandle{mc.meshHandle, 0u};
-            const GPUMesh& mesh = rm.GetMesh(meshHandle);
+    // ── Rasterize occluders ───────────────────────────────────────────────────
+    // Serial: there are few of them, and the buffer is small enough that
+    // splitting it between threads would cost more than it saves.
+    if (occlusion) {
+        registry.RegisterQuery<TransformComponent, OccluderComponent>().Each(
+            [&](EntityID, const TransformComponent& tc, const OccluderComponent& oc)
+            {
+                const OccluderMesh& mesh = rm.GetOccluder(OccluderHandle{oc.occluderHandle, 0u});
+                if (!frustum.ContainsAABB(mesh.localBounds, tc.worldMatrix)) return;
+                occlusion->RasterizeOccluder(mesh.positions, mesh.indices, tc.worldMatrix);
+            });
+        occlusion->BuildPyramid();
+    }
 
-            ++stats.total;
+    // ── Frustum test ──────────────────────────────────────────────────────────
+    // With the camera where it was last frame, last frame's visible set is
+    // patched: entities that neither moved nor were created keep their
+    // visibility untested, and the rest are tested one by one.  Otherwise
+    // the tree is walked: subtrees fully outside a plane are skipped and
+    // subtrees fully inside are accepted without tests; only leaves under
+    // straddling nodes go through the batched culler.  Both start each
+    // node's test with the plane that last rejected it.
+    // With GPU culling every live proxy is kept; the cull shader tests them.
+    CullStats stats{};
+    stats.total = static_cast<std::uint32_t>(tree.ProxyCount());
 
-            // Frustum cull — skip the entity if its AABB is fully outside.
-            if (!frustum.ContainsAABB(mesh.localBounds, tc.worldMatrix)) {
-                ++stats.culled;
+    std::vector<std::uint8_t>& inVisible = coherence.inVisible;
+    inVisible.resize(tree.Capacity(), 0);
+    const bool coherent = !gpuCulling && coherence.valid &&
+                          coherence.frustum.planes == frustum.planes;
+    BoundsTree::CullCounts counts;
+    if (coherent) {
+        for (const std::uint32_t proxy : coherence.retest) inVisible[proxy] = 0;
+        std::erase_if(batch.visible, [&](std::uint32_t proxy) {
+            if (!tree.IsProxy(proxy) || !inVisible[proxy]) return true;
+            if (!IsStale(registry, tree.UserData(proxy))) return false;
+            stale.push_back(proxy);
+            return true;
+        });
+        std::uint32_t retested = 0;
+        for (const std::uint32_t proxy : coherence.retest) {
+            if (!tree.IsProxy(proxy)) continue;
+            ++retested;
+            if (IsStale(registry, tree.UserData(proxy))) stale.push_back(proxy);
+            else if (tree.TestProxy(frustum, proxy, counts)) batch.visible.push_back(proxy);
+        }
+        stats.reused = stats.total - std::min(retested, stats.total);
+    } else {
+        for (const std::uint32_t proxy : batch.visible)
+            if (proxy < inVisible.size()) inVisible[proxy] = 0;
+        batch.visible.clear();
+        batch.pendingCount = 0;
+        const auto visit = [&](std::uint32_t proxy, bool contained) {
+            if (IsStale(registry, tree.UserData(proxy))) {
+                stale.push_back(proxy);
                 return;
             }
-
-            ++stats.visible;
-
-            RenderCommand cmd;
-            cmd.vaoID       = mesh.sharedVAOID;
-            cmd.indexCount  = mesh.indexCount;
-            cmd.baseVertex  = mesh.baseVertex;
-            cmd.baseIndex   = mesh.baseIndex;
-            cmd.modelMatrix = tc.worldMatrix;
-            cmd.normalMatrix= glm::transpose(glm::inverse(tc.worldMatrix));
-            cmd.castsShadow = mc.castsShadow;
-
-            // Resolve material textures.
-            const MaterialHandle matHandle{mc.materialHandle, 0u};
-            if (matHandle.IsValid()) {
-                const Material& mat = rm.GetMaterial(matHandle);
-                cmd.albedoFactor    = mat.albedoFactor;
-                cmd.metallicFactor  = mat.metallicFactor;
-                cmd.roughnessFactor = mat.roughnessFactor;
-
-                auto resolveTexID = [&](std::uint32_t idx,
-                                        const Texture& fallback) -> std::uint32_t {
-                    if (idx == kInvalidTexIndex) return fallback.GetID();
-                    return rm.GetTexture(TextureHandle{idx, 0u}).GetID();
-                };
-                cmd.albedoTexID        = resolveTexID(mat.albedoTexIndex,    rm.DefaultAlbedo());
-                cmd.normalTexID        = resolveTexID(mat.normalTexIndex,     rm.DefaultNormal());
-                cmd.metallicRoughTexID = resolveTexID(mat.metallicRoughIndex, rm.DefaultMetalRough());
-            } else {
-                cmd.albedoTexID        = rm.DefaultAlbedo().GetID();
-                cmd.normalTexID        = rm.DefaultNormal().GetID();
-                cmd.metallicRoughTexID = rm.DefaultMetalRough().GetID();
+            if (contained) {
+                batch.visible.push_back(proxy);
+                return;
             }
+            Enqueue(batch, proxy, tree.Bounds(proxy));
+            if (batch.pendingCount == kCullBatchSize) Flush(batch, frustum);
+        };
+        if (gpuCulling) {
+            for (std::uint32_t proxy = 0; proxy < tree.Capacity(); ++proxy)
+                if (tree.IsProxy(proxy)) visit(proxy, true);
+        } else {
+            counts = tree.CullFrustum(frustum, visit);
+            Flush(batch, frustum);   // partial batch
+        }
+    }
+    for (const std::uint32_t proxy : batch.visible) inVisible[proxy] = 1;
+
+    // With GPU culling the queue ends up holding every mesh, so its bounds
+    // say nothing about what the camera sees.  The shadow map and the caster
+    // gather need the receivers in view: the tree's frustum query gives them
+    // cheaply, rejecting whole subtrees.
+    if (gpuCulling) {
+        AABB receivers;
+        tree.QueryFrustum(frustum, [&](std::uint32_t proxy) {
+            if (!IsStale(registry, tree.UserData(proxy))) receivers.Expand(tree.Bounds(proxy));
+        });
+        queue.SetReceiverBounds(receivers);
+    }
+    for (const std::uint32_t proxy : stale) DestroyProxy(registry, tree, proxy);
 
-            const glm::vec3 origin = glm::vec3(tc.worldMatrix[3]);
-            cmd.distanceToCamera   = glm::length(origin - cameraPos);
+    coherence.frustum = frustum;
+    coherence.valid   = !gpuCulling;
+    coherence.retest.clear();
+    stats.planeTests  = counts.planeTests;
+    stats.planeHits   = counts.planeHits;
 
-            queue.Submit(cmd);
+    // ── Submit ────────────────────────────────────────────────────────────────
+    // Frustum survivors too small on screen or behind the occluders are
+    // dropped here, before their command is copied; the size test is the
+    // cheaper one, so it goes first.  Chunks run in parallel, each thread
+    // building commands into its own queue segment; the segments are then
+    // merged into the queue in one step.
+    stats.culled = stats.total - static_cast<std::uint32_t>(batch.visible.size());
+    segments.resize(jobs.ThreadCount());
+    submitCounts.resize(jobs.ThreadCount());
+    const Registry& records = registry;
+    jobs.ParallelFor(static_cast<std::uint32_t>(batch.visible.size()), kSubmitGrain,
+        [&](std::uint32_t begin, std::uint32_t end)
+        {
+            const std::uint32_t   thread  = JobSystem::ThreadIndex();
+            RenderQueue::Segment& segment = segments[thread];
+            SubmitCounts&         counts  = submitCounts[thread];
+            for (std::uint32_t i = begin; i < end; ++i) {
+                const std::uint32_t proxy = batch.visible[i];
+                const DrawRecordComponent& record =
+                    records.GetComponent<DrawRecordComponent>(tree.UserData(proxy));
+                const std::uint32_t lod = SelectLOD(record, screen, cameraPos);
+                if (lod == kTooSmall) {
+                    ++counts.tooSmall;
+                    continue;
+                }
+                if (occlusion && occlusion->IsOccluded(record.command.worldBounds)) {
+                    ++counts.occluded;
+                    continue;
+                }
+                if (lod > 0) ++counts.reducedLOD;
+
+                RenderCommand cmd = record.command;
+                cmd.baseIndex          = record.lods[lod].firstIndex;
+                cmd.indexCount         = record.lods[lod].indexCount;
+                counts.triangles      += cmd.indexCount / 3;
+                const glm::vec3 origin = glm::vec3(cmd.modelMatrix[3]);
+                cmd.distanceToCamera   = glm::length(origin - cameraPos);
+                segment.Submit(cmd);
+                counts.proxies.push_back(proxy);
+            }
         });
 
-    if (stats.culled > 0) {
-        LOG_TRACE("RenderSystem: {}/{} meshes culled ({:.0f}%)",
+    // Segment i's commands start first + the sizes of the segments before it.
+    SubmittedCommands& submitted = state_->submitted;
+    submitted.queue = &queue;
+    ++submitted.frame;
+    submitted.frameOf.resize(tree.Capacity(), 0);
+    submitted.command.resize(tree.Capacity(), 0);
+    std::uint32_t index = queue.Merge(segments, jobs);
+    for (std::size_t t = 0; t < segments.size(); ++t) {
+        SubmitCounts& counts = submitCounts[t];
+        for (const std::uint32_t proxy : counts.proxies) {
+            submitted.command[proxy] = index++;
+            submitted.frameOf[proxy] = submitted.frame;
+        }
+        stats.visible    += segments[t].Size();
+        stats.tooSmall   += counts.tooSmall;
+        stats.occluded   += counts.occluded;
+        stats.reducedLOD += counts.reducedLOD;
+        stats.triangles  += counts.triangles;
+        segments[t].Clear();
+        counts.proxies.clear();
+        counts.tooSmall = counts.occluded = counts.reducedLOD = counts.triangles = 0;
+    }
+
+    if (occlusion) stats.occluderTriangles = occlusion->TriangleCount();
+
+    if (stats.culled + stats.tooSmall + stats.occluded > 0) {
+        LOG_TRACE("RenderSystem: {}/{} meshes culled ({:.0f}%), {} too small, {} occluded",
                   stats.culled, stats.total,
                   100.f * static_cast<float>(stats.culled) /
-                          static_cast<float>(stats.total));
+                          static_cast<float>(stats.total),
+                  stats.tooSmall, stats.occluded);
     }
 
     return stats;
 }
 
+std::uint32_t RenderSystem::GatherShadowCasters(const Registry&          registry,
+                                                const BoundsTree&        tree,
+                                                RenderQueue&             queue,
+                                                const glm::vec3&         lightDir,
+                                                const glm::vec3&         cameraPos,
+                                                const ScreenSizeCulling& screen) const
+{
+    const AABB receivers = queue.ReceiverBounds();
+    if (!receivers.IsValid()) return 0;   // nothing in view to shadow
+
+    // The shadow map's volume over the receivers, open toward the light: a
+    // caster anywhere between the light and a receiver can shadow it.
+    constexpr std::size_t kNearPlane = 4;
+    Frustum volume = Frustum::FromViewProjection(
+        ShadowPass::FitLightSpace(receivers, AABB{}, lightDir));
+    volume.planes[kNearPlane] = glm::vec4(0.f, 0.f, 0.f, 1.f);   // everything inside
+
+    // Command indices are only shared with the GatherCommands of this frame,
+    // which filled the same queue from the same tree.
+    ENGINE_ASSERT(state_->tree == &tree,
+                  "RenderSystem: GatherShadowCasters needs the tree GatherCommands used");
+    const SubmittedCommands& submitted = state_->submitted;
+    const bool shareCommands = submitted.queue == &queue;
+    std::uint32_t count = 0;
+    tree.QueryFrustum(volume, [&](std::uint32_t proxy) {
+        // Stale proxies are left for GatherCommands to drop.
+        const EntityID id = tree.UserData(proxy);
+        if (IsStale(registry, id)) return;
+        const DrawRecordComponent& record = registry.GetComponent<DrawRecordComponent>(id);
+        if (!record.command.castsShadow || record.command.transparent) return;
+        ++count;
+
+        // In view too: the geometry pass's command has the same LOD.
+        if (shareCommands && proxy < submitted.frameOf.size() &&
+            submitted.frameOf[proxy] == submitted.frame) {
+            queue.AddShadowCaster(submitted.command[proxy]);
+            return;
+        }
+
+        std::uint32_t lod = SelectLOD(record, screen, cameraPos);
+        if (lod == kTooSmall) lod = record.lodCount - 1;
+
+        RenderCommand cmd = record.command;
+        cmd.baseIndex  = record.lods[lod].firstIndex;
+        cmd.indexCount = record.lods[lod].indexCount;
+        queue.SubmitShadowCaster(cmd);
+    });
+    return count;
+}
+
 } // namespace engine
@@ -1,36 +1,201 @@
 #pragma once
 
 #include <scene/ecs/Registry.hpp>
+#include <scene/ecs/Components.hpp>
 #include <renderer/frontend/UniformData.hpp>
+#include <renderer/frontend/RenderCommand.hpp>
+#include <resources/MeshLOD.hpp>
 #include <core/Frustum.hpp>
+#include <core/Geometry.hpp>
+#include <glm/geometric.hpp>
+#include <glm/mat4x4.hpp>
 #include <glm/vec3.hpp>
+#include <array>
 #include <cstdint>
+#include <memory>
 
 namespace engine {
 
 class RenderQueue;
 class ResourceManager;
+class JobSystem;
+class OcclusionBuffer;
+
+// ─── DrawRecordComponent ──────────────────────────────────────────────────────
+// RenderSystem-owned cache of an entity's resolved draw: mesh ranges, model
+// and normal matrices, world bounds, material textures and factors.  Attached automatically
+// to every entity with Transform + Mesh and rebuilt only when either of those
+// changes, so static entities cost a copy per frame instead of a material
+// lookup.  The normal matrix is taken from TransformComponent, where
+// TransformSystem derives it analytically.  Do not add or edit it by hand.
+struct DrawRecordComponent {
+    RenderCommand command;   // distanceToCamera and the LOD range are filled in at submit time
+
+    std::array<MeshLOD, kMaxMeshLODs> lods{};   // from the GPUMesh
+    std::uint32_t                     lodCount = 1;
+};
 
 // ─── RenderSystem ─────────────────────────────────────────────────────────────
-// Walks the ECS registry and builds RenderCommands for every visible
+// Walks the ECS registry and submits a RenderCommand for every visible
 // MeshComponent that passes frustum culling.  Material textures are resolved
-// to raw GL IDs at submission time so render passes have zero dependency on
-// ResourceManager.
+// to raw GL IDs when the entity's DrawRecordComponent is (re)built, so render
+// passes have zero dependency on ResourceManager.
+//
+// Record refresh runs in parallel on the job system.  Entities whose world
+// bounds changed then update their proxies in the scene's BoundsTree, and the
+// frustum test walks that tree: whole subtrees are rejected or accepted, and
+// only leaves under nodes straddling the frustum are tested, in batches of 64
+// through CullAABBs (core/Math/FrustumCull.hpp).  Cost follows what the camera
+// sees rather than the entity count.
+//
+// Frustum results are temporally coherent.  Each BVH node remembers the plane
+// that last rejected it and is tested against that one first.  While the
+// camera frustum is exactly last frame's, the tree is not walked at all: last
+// frame's visible set is kept, and only entities whose bounds changed or that
+// were added are tested again.  CullStats::reused and planeHits / planeTests
+// give the hit rates.
+//
+// Given an OcclusionBuffer, the occluders in view (OccluderComponent) are
+// rasterized into it first, and every frustum survivor is tested against its
+// depth pyramid before a RenderCommand is emitted.
+//
+// Survivors are then sized on screen by their world bounding sphere: those
+// whose projected diameter falls under ScreenSizeCulling::minPixels are
+// dropped, and the rest are drawn at the finest level of detail whose
+// MeshLOD::screenSize their coverage of the viewport height reaches.
+//
+// With gpuCulling set, the frustum test moves to GpuCulling on the GPU and
+// there is no occlusion test (no OcclusionBuffer may be passed): every mesh
+// with a live proxy reaches the submit step.  Screen-size culling and LOD
+// selection stay on the CPU and still count in CullStats::tooSmall and
+// reducedLOD.
+// The receivers in view still come from a CPU frustum query of the tree
+// (RenderQueue::SetReceiverBounds), so the shadow map stays fitted to them.
+//
+// Survivors become RenderCommands in parallel: chunks of them run on the job
+// system, each thread building into its own RenderQueue::Segment, and the
+// segments are merged into the queue before it is sorted.
+//
+// Shadow casters are gathered separately, once the camera's receivers are
+// known: GatherShadowCasters queries the same tree with the light's volume
+// over those receivers, open toward the light.
+//
+// What carries over between frames (the stale-proxy sweep position, last
+// frame's visible set) and the scratch that keeps steady-state culling from
+// allocating live in the RenderSystem, so one serves one BoundsTree and one
+// view of it.  Scene owns one next to its tree.
 class RenderSystem {
 public:
     struct CullStats {
-        std::uint32_t total   = 0;  // all mesh entities
-        std::uint32_t culled  = 0;  // rejected by frustum
-        std::uint32_t visible = 0;  // submitted to queue
+        std::uint32_t total             = 0;  // visible-flagged mesh entities (BVH proxies)
+        std::uint32_t culled            = 0;  // rejected by frustum
+        std::uint32_t tooSmall          = 0;  // in the frustum, under the pixel threshold
+        std::uint32_t occluded          = 0;  // in the frustum, hidden behind occluders
+        std::uint32_t visible           = 0;  // submitted to queue
+        std::uint32_t reducedLOD        = 0;  // of those, drawn below LOD 0
+        std::uint32_t triangles         = 0;  // submitted, at the selected LODs
+        std::uint32_t reused            = 0;  // frustum visibility kept from last frame untested
+        std::uint32_t planeTests        = 0;  // frustum tests begun with a cached rejecting plane
+        std::uint32_t planeHits         = 0;  // of those, rejected by that plane alone
+        std::uint32_t occluderTriangles = 0;  // rasterized into the occlusion buffer
+        std::uint32_t shadowCasters     = 0;  // from GatherShadowCasters
+    };
+
+    // Projection inputs for screen-size culling and LOD selection.  A default
+    // constructed one (viewportHeight 0) disables both: every mesh is drawn
+    // at LOD 0.
+    struct ScreenSizeCulling {
+        float projScaleY     = 0.f;    // projection[1][1]
+        float viewportHeight = 0.f;    // pixels
+        float minPixels      = 0.f;    // projected diameter below which a mesh is dropped
+        bool  orthographic   = false;  // size independent of distance
+
+        static ScreenSizeCulling FromProjection(const glm::mat4& projection,
+                                                float            viewportHeight,
+                                                float            minPixels);
     };
 
+    // SelectLOD result for a record under the pixel threshold.
+    static constexpr std::uint32_t kTooSmall = ~0u;
+
+    // LOD to draw record at from cameraPos, or kTooSmall.  The bounding
+    // sphere of the world bounds stands in for the mesh; a camera inside it
+    // always gets LOD 0.  Inline, with the rest of this header GL-free, so
+    // benchmarks measure the shipped selection.
+    static std::uint32_t SelectLOD(const DrawRecordComponent& record,
+                                   const ScreenSizeCulling&   screen,
+                                   const glm::vec3&           cameraPos);
+
+    RenderSystem();
+    ~RenderSystem();
+
+    RenderSystem(const RenderSystem&)            = delete;
+    RenderSystem& operator=(const RenderSystem&) = delete;
+
     // Populate queue with draw commands from all mesh entities that pass
-    // frustum culling.  cameraPos is used to compute distance sort keys.
-    static CullStats GatherCommands(Registry&              registry,
-                                    const ResourceManager& rm,
-                                    RenderQueue&           queue,
-                                    const glm::vec3&       cameraPos,
-                                    const Frustum&         frustum);
+    // frustum, screen-size and occlusion culling, each at the LOD screen
+    // selects.  cameraPos is used to compute distance sort keys and screen
+    // sizes.  occlusion may be null to skip occlusion culling; otherwise
+    // Begin must have been called on it with this frame's view-projection.
+    // Attaches DrawRecordComponent and WorldBoundsComponent to new mesh
+    // entities, so this is a structural change and must not run inside Each.
+    // tree must be used with this registry only, and with this RenderSystem
+    // on every call; its proxies for destroyed entities are dropped lazily
+    // over the following frames.  gpuCulling skips the frustum and occlusion
+    // tests; occlusion must then be null.
+    CullStats GatherCommands(Registry&                registry,
+                             BoundsTree&              tree,
+                             const ResourceManager&   rm,
+                             RenderQueue&             queue,
+                             const glm::vec3&         cameraPos,
+                             const Frustum&           frustum,
+                             const ScreenSizeCulling& screen,
+                             OcclusionBuffer*         occlusion,
+                             JobSystem&               jobs,
+                             bool                     gpuCulling = false);
+
+    // Submit the shadow casters (MeshComponent::castsShadow) that can throw a
+    // shadow onto queue.ReceiverBounds(): those inside the light's orthographic
+    // volume over the receivers (ShadowPass::FitLightSpace) with its near
+    // plane removed, so casters between the light and the receivers count
+    // whether or not the camera sees them.  Call after GatherCommands, with
+    // the same tree and screen; casters under the camera's pixel threshold
+    // are drawn at their coarsest LOD.  Casters GatherCommands submitted
+    // this frame into the same queue share its command
+    // (RenderQueue::AddShadowCaster).  Returns the number of casters.
+    std::uint32_t GatherShadowCasters(const Registry&          registry,
+                                      const BoundsTree&        tree,
+                                      RenderQueue&             queue,
+                                      const glm::vec3&         lightDir,
+                                      const glm::vec3&         cameraPos,
+                                      const ScreenSizeCulling& screen) const;
+
+private:
+    struct State;   // RenderSystem.cpp
+    std::unique_ptr<State> state_;
 };
 
+inline std::uint32_t RenderSystem::SelectLOD(const DrawRecordComponent& record,
+                                             const ScreenSizeCulling&   screen,
+                                             const glm::vec3&           cameraPos)
+{
+    if (screen.viewportHeight <= 0.f) return 0;
+
+    const AABB&  bounds = record.command.worldBounds;
+    const float  radius = glm::length(bounds.Extents());
+    const float  dist   = glm::length(bounds.Center() - cameraPos);
+    if (!screen.orthographic && dist <= radius) return 0;
+
+    // Sphere diameter in pixels: the projection maps a radius r at distance
+    // d to r * projScaleY / d in NDC, whose span of 2 covers the viewport.
+    const float ndcRadius = radius * screen.projScaleY / (screen.orthographic ? 1.f : dist);
+    const float pixels    = ndcRadius * screen.viewportHeight;
+    if (pixels < screen.minPixels) return kTooSmall;
+
+    const float coverage = pixels / screen.viewportHeight;
+    std::uint32_t lod = 0;
+    while (lod + 1 < record.lodCount && coverage < record.lods[lod].screenSize) ++lod;
+    return lod;
+}
+
 } // namespace engine
@@ -1,35 +1,244 @@
 #include <scene/systems/TransformSystem.hpp>
 #include <scene/ecs/Components.hpp>
+#include <core/Jobs/JobSystem.hpp>
+#include <core/Math/TRSBatch.hpp>
 
-#include <glm/gtc/matrix_transform.hpp>
+#include <array>
+#include <vector>
 
 namespace engine {
 
-void TransformSystem::Update(Registry& registry)
+namespace {
+
+glm::mat4 ComputeLocalMatrix(const TransformComponent& tc)
+{
+    return BuildTRSMatrix(tc.position, tc.rotation, tc.scale);
+}
+
+// Normal matrix of a TRS matrix m = T * R * S: transpose(inverse(R * S)) is
+// R * S^-1, and column i of R is column i of m divided by scale[i] — so each
+// column of m is divided by scale[i]^2.  No general inverse needed.
+glm::mat3 ComputeNormalMatrix(const glm::mat4& m, const glm::vec3& scale)
+{
+    return glm::mat3(glm::vec3(m[0]) / (scale.x * scale.x),
+                     glm::vec3(m[1]) / (scale.y * scale.y),
+                     glm::vec3(m[2]) / (scale.z * scale.z));
+}
+
+// Give id a HierarchyComponent (as a root) if it has none yet.
+void AssureNode(Registry& registry, EntityID id)
+{
+    if (registry.HasComponent<HierarchyComponent>(id)) return;
+    const TransformComponent& tc = registry.GetComponent<TransformComponent>(id);
+    HierarchyComponent hc;
+    hc.localMatrix = ComputeLocalMatrix(tc);
+    hc.localNormal = ComputeNormalMatrix(hc.localMatrix, tc.scale);
+    registry.AddComponent<HierarchyComponent>(id, hc);
+}
+
+// Remove hc from its parent's child list.
+void Unlink(Registry& registry, HierarchyComponent& hc)
+{
+    if (hc.prevSibling != INVALID_ENTITY)
+        registry.GetComponent<HierarchyComponent>(hc.prevSibling).nextSibling = hc.nextSibling;
+    else if (hc.parent != INVALID_ENTITY)
+        registry.GetComponent<HierarchyComponent>(hc.parent).firstChild = hc.nextSibling;
+
+    if (hc.nextSibling != INVALID_ENTITY)
+        registry.GetComponent<HierarchyComponent>(hc.nextSibling).prevSibling = hc.prevSibling;
+
+    hc.parent      = INVALID_ENTITY;
+    hc.prevSibling = INVALID_ENTITY;
+    hc.nextSibling = INVALID_ENTITY;
+}
+
+// Call fn(EntityID) for root and all of its descendants, parents first.
+template<typename Fn>
+void ForEachInSubtree(Registry& registry, EntityID root, Fn&& fn)
+{
+    std::vector<EntityID> stack{root};
+    while (!stack.empty()) {
+        const EntityID id = stack.back();
+        stack.pop_back();
+        fn(id);
+        for (EntityID c = registry.GetComponent<HierarchyComponent>(id).firstChild;
+             c != INVALID_ENTITY;
+             c = registry.GetComponent<HierarchyComponent>(c).nextSibling)
+            stack.push_back(c);
+    }
+}
+
+} // namespace
+
+// ── Batched local TRS ─────────────────────────────────────────────────────────
+// The SIMD TRS kernel wants SoA inputs; the gather into stack arrays is cheap
+// next to the quaternion-to-rotation and scale it amortises per transform.
+void TransformSystem::FlushBatch(PendingTransforms& pending)
+{
+    const std::size_t n = pending.count;
+    if (n == 0) return;
+
+    float px[kBatchSize], py[kBatchSize], pz[kBatchSize];
+    float qx[kBatchSize], qy[kBatchSize], qz[kBatchSize], qw[kBatchSize];
+    float sx[kBatchSize], sy[kBatchSize], sz[kBatchSize];
+    std::array<glm::mat4*, kBatchSize> out;
+
+    for (std::size_t i = 0; i < n; ++i) {
+        TransformComponent& tc = *pending.items[i];
+        px[i] = tc.position.x; py[i] = tc.position.y; pz[i] = tc.position.z;
+        qx[i] = tc.rotation.x; qy[i] = tc.rotation.y; qz[i] = tc.rotation.z; qw[i] = tc.rotation.w;
+        sx[i] = tc.scale.x;    sy[i] = tc.scale.y;    sz[i] = tc.scale.z;
+        out[i] = &tc.worldMatrix;
+    }
+
+    BuildTRSMatrices({px, py, pz, qx, qy, qz, qw, sx, sy, sz}, out.data(), n);
+
+    for (std::size_t i = 0; i < n; ++i) {
+        TransformComponent& tc = *pending.items[i];
+        tc.normalMatrix = ComputeNormalMatrix(tc.worldMatrix, tc.scale);
+    }
+    pending.count = 0;
+}
+
+void TransformSystem::Update(Registry& registry, JobSystem& jobs)
 {
-    registry.Each<TransformComponent>(
-        [](EntityID, TransformComponent& tc)
+    // ── Local TRS of every changed transform ──────────────────────────────────
+    // For roots this is already the world matrix; parented entities are fixed
+    // up by the propagation pass below.
+    const auto changed = registry.RegisterQuery<TransformComponent,
+                                                Changed<TransformComponent>>();
+    pending_.resize(jobs.ThreadCount());
+    changed.ParallelEach(jobs,
+        [this](EntityID, TransformComponent& tc)
         {
-            if (!tc.dirty) return;
+            PendingTransforms& batch = pending_[JobSystem::ThreadIndex()];
+            batch.items[batch.count++] = &tc;
+            if (batch.count == kBatchSize) FlushBatch(batch);
+        });
+    for (auto& batch : pending_) FlushBatch(batch);   // partial batches
+
+    // ── Seed the propagation with changed hierarchy nodes ─────────────────────
+    const auto changedNodes = registry.RegisterQuery<TransformComponent, HierarchyComponent,
+                                                     Changed<TransformComponent>>();
+    for (auto& level : levels_) level.clear();
+    changedNodes.Each(
+        [&](EntityID id, const TransformComponent& tc, HierarchyComponent& hc)
+        {
+            hc.localMatrix = tc.worldMatrix;   // local TRS, written just above
+            hc.localNormal = tc.normalMatrix;
+            if (hc.depth >= levels_.size()) levels_.resize(hc.depth + 1u);
+            levels_[hc.depth].push_back(id);
+        });
+
+    // ── Breadth-first propagation ─────────────────────────────────────────────
+    // Level d only reads world matrices of level d - 1, so each level runs in
+    // parallel.  A changed node below another changed node is reached through
+    // its ancestor first and skipped when its own seed comes up.
+    ++epoch_;
+    for (std::size_t d = 0; d < levels_.size(); ++d) {
+        frontier_.clear();
+        for (const EntityID id : levels_[d]) {
+            auto& hc = registry.GetComponent<HierarchyComponent>(id);
+            if (hc.epoch == epoch_) continue;
+            hc.epoch = epoch_;
+            frontier_.push_back(id);
+        }
+        if (frontier_.empty()) continue;   // deeper levels may still hold seeds
+
+        jobs.ParallelFor(static_cast<std::uint32_t>(frontier_.size()), kDefaultParallelGrain,
+            [&](std::uint32_t begin, std::uint32_t end)
+            {
+                for (std::uint32_t i = begin; i < end; ++i) {
+                    const EntityID            id = frontier_[i];
+                    const HierarchyComponent& hc = registry.GetComponent<HierarchyComponent>(id);
+                    TransformComponent&       tc = registry.GetComponent<TransformComponent>(id);
+
+                    // transpose(inverse(A * B)) = transpose(inverse(A)) *
+                    // transpose(inverse(B)), so normal matrices compose too.
+                    if (hc.parent != INVALID_ENTITY) {
+                        const TransformComponent& ptc = registry.GetComponent<TransformComponent>(hc.parent);
+                        tc.worldMatrix  = ptc.worldMatrix  * hc.localMatrix;
+                        tc.normalMatrix = ptc.normalMatrix * hc.localNormal;
+                    } else {
+                        tc.worldMatrix  = hc.localMatrix;
+                        tc.normalMatrix = hc.localNormal;
+                    }
+                    registry.MarkChanged<TransformComponent>(id);
+                }
+            });
 
-            const glm::mat4 T = glm::translate(glm::mat4(1.f), tc.position);
+        for (const EntityID id : frontier_) {
+            for (EntityID c = registry.GetComponent<HierarchyComponent>(id).firstChild;
+                 c != INVALID_ENTITY;
+                 c = registry.GetComponent<HierarchyComponent>(c).nextSibling)
+            {
+                if (d + 1u >= levels_.size()) levels_.resize(d + 2u);
+                levels_[d + 1u].push_back(c);
+            }
+        }
+    }
 
-            // Apply rotations in X → Y → Z order
-            glm::mat4 R = glm::rotate(glm::mat4(1.f),
-                                      glm::radians(tc.eulerAngles.x),
-                                      glm::vec3(1.f, 0.f, 0.f));
-            R = glm::rotate(R,
-                            glm::radians(tc.eulerAngles.y),
-                            glm::vec3(0.f, 1.f, 0.f));
-            R = glm::rotate(R,
-                            glm::radians(tc.eulerAngles.z),
-                            glm::vec3(0.f, 0.f, 1.f));
+    // The stamps above are for downstream systems; they must not re-trigger
+    // this system next frame.
+    changed.Consume();
+    changedNodes.Consume();
+}
+
+void TransformSystem::SetParent(Registry& registry, EntityID child, EntityID parent)
+{
+    ENGINE_ASSERT(registry.HasComponent<TransformComponent>(child),
+                  "SetParent: child has no TransformComponent");
+    ENGINE_ASSERT(child != parent, "SetParent: entity cannot parent itself");
 
-            const glm::mat4 S = glm::scale(glm::mat4(1.f), tc.scale);
+    // Structural changes first — they may move components.
+    AssureNode(registry, child);
+    if (parent != INVALID_ENTITY) {
+        ENGINE_ASSERT(registry.HasComponent<TransformComponent>(parent),
+                      "SetParent: parent has no TransformComponent");
+        AssureNode(registry, parent);
+        for (EntityID a = parent; a != INVALID_ENTITY;
+             a = registry.GetComponent<HierarchyComponent>(a).parent)
+            ENGINE_ASSERT(a != child, "SetParent: link would create a cycle");
+    }
 
-            tc.worldMatrix = T * R * S;
-            tc.dirty       = false;
+    auto& hc = registry.GetComponent<HierarchyComponent>(child);
+    Unlink(registry, hc);
+
+    std::uint32_t depth = 0;
+    if (parent != INVALID_ENTITY) {
+        auto& phc = registry.GetComponent<HierarchyComponent>(parent);
+        hc.parent      = parent;
+        hc.nextSibling = phc.firstChild;
+        if (phc.firstChild != INVALID_ENTITY)
+            registry.GetComponent<HierarchyComponent>(phc.firstChild).prevSibling = child;
+        phc.firstChild = child;
+        depth          = phc.depth + 1u;
+    }
+
+    const std::int64_t shift = static_cast<std::int64_t>(depth) - hc.depth;
+    if (shift != 0) {
+        ForEachInSubtree(registry, child, [&](EntityID id) {
+            auto& node = registry.GetComponent<HierarchyComponent>(id);
+            node.depth = static_cast<std::uint32_t>(node.depth + shift);
         });
+    }
+
+    // New parent, new world matrix: re-propagate from child next Update.
+    registry.MarkChanged<TransformComponent>(child);
+}
+
+void TransformSystem::DestroySubtree(Registry& registry, EntityID root)
+{
+    if (!registry.HasComponent<HierarchyComponent>(root)) {
+        registry.DestroyEntity(root);
+        return;
+    }
+
+    Unlink(registry, registry.GetComponent<HierarchyComponent>(root));
+
+    std::vector<EntityID> doomed;
+    ForEachInSubtree(registry, root, [&](EntityID id) { doomed.push_back(id); });
+    for (const EntityID id : doomed) registry.DestroyEntity(id);
 }
 
 } // namespace engine
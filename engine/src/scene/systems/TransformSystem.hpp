@@ -2,14 +2,65 @@
 
 #include <scene/ecs/System.hpp>
 #include <scene/ecs/Registry.hpp>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
 
 namespace engine {
 
+class JobSystem;
+struct TransformComponent;
+
+// Update keeps scratch space and a propagation counter between frames, and
+// the counter is stamped into HierarchyComponent::epoch, so each registry
+// needs its own TransformSystem (Scene owns one).
 class TransformSystem : public System {
 public:
-    // Recomputes worldMatrix for every TransformComponent with dirty == true,
-    // then clears the dirty flag.
-    static void Update(Registry& registry);
+    // Recomputes worldMatrix and normalMatrix for every TransformComponent
+    // changed since the previous Update (Changed<TransformComponent>);
+    // untouched entities are skipped without being read.  Entities are
+    // independent, so the work is spread across the job system's threads, and
+    // each thread batches its transforms through the SIMD TRS kernel
+    // (core/Math/TRSBatch.hpp).  The normal matrix is R * S^-1, read off the
+    // TRS columns — no matrix inverse.
+    //
+    // Parented entities (HierarchyComponent) are then resolved breadth-first,
+    // one depth level at a time, seeded only by changed nodes: every node
+    // reached is rebuilt from its parent's world / normal matrices and its
+    // cached local ones, its children join the next level, and it is stamped
+    // changed for downstream systems.  Subtrees with no change are never
+    // visited.
+    void Update(Registry& registry, JobSystem& jobs);
+
+    // Attach child under parent, or detach it when parent == INVALID_ENTITY.
+    // child's TransformComponent is kept as-is and becomes parent-relative.
+    // Adds HierarchyComponent to either entity as needed, so this is a
+    // structural change.  Asserts if the link would create a cycle.
+    static void SetParent(Registry& registry, EntityID child, EntityID parent);
+
+    // Destroy root and every descendant.  Plain DestroyEntity on a node that
+    // is linked into a hierarchy leaves dangling parent/sibling links.
+    static void DestroySubtree(Registry& registry, EntityID root);
+
+private:
+    // Changed transforms are queued per thread and converted kBatchSize at a
+    // time by the SIMD TRS kernel (see FlushBatch).
+    static constexpr std::size_t kBatchSize = 64;
+
+    struct alignas(64) PendingTransforms {
+        std::array<TransformComponent*, kBatchSize> items;
+        std::size_t                                 count = 0;
+    };
+
+    static void FlushBatch(PendingTransforms& pending);
+
+    // Scratch reused across frames: one frontier per depth level, and a pass
+    // counter that marks nodes already visited this Update.
+    std::vector<std::vector<EntityID>> levels_;
+    std::vector<EntityID>              frontier_;
+    std::uint32_t                      epoch_ = 0;
+    std::vector<PendingTransforms>     pending_;   // indexed by JobSystem::ThreadIndex()
 };
 
 } // namespace engine